@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../Other/TestPrefix.h"
+
+/**
+ The benchmarks are hidden Catch test cases with the tag [benchmark]. They don't run by default. Run them with:
+
+     ReaX-Tests "[benchmark]"
+
+ Each measurement is printed to stdout as one JSON object per line, prefixed with "ReaX-Benchmark: ", so the results can be collected with e.g. `grep` and compared between versions:
+
+     ReaX-Benchmark: {"name": "map chain/depth 4", "iterations": 100000, "nanosecondsPerIteration": 123.4}
+
+ Use a release build for meaningful numbers.
+ */
+namespace ReaX_Benchmark {
+/// Prints one result as a JSON line.
+inline void report(const String& name, int64 iterations, double nanosecondsPerIteration)
+{
+    DynamicObject::Ptr result(new DynamicObject());
+    result->setProperty("name", name);
+    result->setProperty("iterations", iterations);
+    result->setProperty("nanosecondsPerIteration", nanosecondsPerIteration);
+
+    std::cout << "ReaX-Benchmark: " << JSON::toString(var(result.get()), true) << std::endl;
+}
+
+/// Calls `function` `iterations` times (after a short warm-up), prints the time per call and returns it in nanoseconds.
+template<typename Function>
+double measure(const String& name, int iterations, Function&& function)
+{
+    for (int i = 0; i < jmax(1, iterations / 10); ++i)
+        function();
+
+    const int64 startTicks = Time::getHighResolutionTicks();
+    for (int i = 0; i < iterations; ++i)
+        function();
+
+    const double seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+    const double nanosecondsPerIteration = seconds * 1e9 / jmax(1, iterations);
+    report(name, iterations, nanosecondsPerIteration);
+
+    return nanosecondsPerIteration;
+}
+}
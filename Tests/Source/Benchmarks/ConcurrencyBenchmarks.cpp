@@ -0,0 +1,90 @@
+#include "BenchmarkPrefix.h"
+
+#include <thread>
+
+namespace {
+const int NumValues = 100000;
+
+void measureOnNext(const String& name, CongestionPolicy congestionPolicy, ProducerMode producerMode, size_t queueCapacity)
+{
+    LockFreeSource<float> source(queueCapacity, producerMode);
+    float value = 0;
+
+    ReaX_Benchmark::measure("LockFreeSource::onNext/" + name, NumValues, [&]() {
+        source.onNext(value++, congestionPolicy);
+    });
+
+    // Drain the queue
+    ReaX_RunDispatchLoop(10);
+}
+}
+
+TEST_CASE("Benchmark: LockFreeSource::onNext",
+          "[.][benchmark]")
+{
+    // Room for all values (including the warm-up), so the queue never runs full
+    const size_t largeCapacity = 2 * NumValues;
+
+    measureOnNext("Allocate", CongestionPolicy::Allocate, ProducerMode::MultiProducer, 1);
+    measureOnNext("DropNewest", CongestionPolicy::DropNewest, ProducerMode::MultiProducer, largeCapacity);
+    measureOnNext("DropNewest, full", CongestionPolicy::DropNewest, ProducerMode::MultiProducer, 64);
+    measureOnNext("DropOldest, full", CongestionPolicy::DropOldest, ProducerMode::MultiProducer, 64);
+    measureOnNext("SingleProducer, DropNewest", CongestionPolicy::DropNewest, ProducerMode::SingleProducer, largeCapacity);
+    measureOnNext("SingleProducer, DropNewest, full", CongestionPolicy::DropNewest, ProducerMode::SingleProducer, 64);
+    measureOnNext("SingleProducer, DropOldest, full", CongestionPolicy::DropOldest, ProducerMode::SingleProducer, 64);
+}
+
+TEST_CASE("Benchmark: Audio thread to message thread latency",
+          "[.][benchmark]")
+{
+    const int numSamples = 1000;
+
+    // The values are the times at which they have been added
+    LockFreeSource<int64> source(16, ProducerMode::SingleProducer);
+    Array<double> latencies;
+    DisposeBag disposeBag;
+    source.subscribe([&latencies](int64 addedTicks) {
+              latencies.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - addedTicks) * 1e9);
+          })
+        .disposedBy(disposeBag);
+
+    std::atomic<bool> shouldStop{ false };
+    std::thread producer([&]() {
+        // Roughly the rate of audio callbacks
+        while (!shouldStop.load()) {
+            source.onNext(Time::getHighResolutionTicks(), CongestionPolicy::DropOldest);
+            Thread::sleep(1);
+        }
+    });
+
+    ReaX_RunDispatchLoopUntil(latencies.size() >= numSamples);
+    shouldStop.store(true);
+    producer.join();
+
+    latencies.sort();
+    ReaX_Benchmark::report("LockFreeSource latency/median", latencies.size(), latencies[latencies.size() / 2]);
+    ReaX_Benchmark::report("LockFreeSource latency/99th percentile", latencies.size(), latencies[latencies.size() * 99 / 100]);
+}
+
+TEST_CASE("Benchmark: Observable::observeOn",
+          "[.][benchmark]")
+{
+    const std::vector<std::pair<String, Scheduler>> schedulers{
+        { "messageThread", Scheduler::messageThread() },
+        { "backgroundThread", Scheduler::backgroundThread() },
+        { "newThread", Scheduler::newThread() },
+        { "threadPool", Scheduler::threadPool() }
+    };
+
+    for (auto& scheduler : schedulers) {
+        std::atomic<int> numReceived{ 0 };
+        DisposeBag disposeBag;
+
+        const int64 startTicks = Time::getHighResolutionTicks();
+        Observable<int>::range(1, NumValues).observeOn(scheduler.second).subscribe([&numReceived](int) { ++numReceived; }).disposedBy(disposeBag);
+        ReaX_RunDispatchLoopUntil(numReceived.load() == NumValues);
+
+        const double seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+        ReaX_Benchmark::report("observeOn/" + scheduler.first, NumValues, seconds * 1e9 / NumValues);
+    }
+}
@@ -0,0 +1,157 @@
+#include "BenchmarkPrefix.h"
+
+using detail::any;
+
+namespace {
+const int NumEmissions = 100000;
+const int ChainDepths[] = { 1, 4, 16 };
+
+// Subscribes to `chain`, and measures how long it takes to push one value from `subject` through it
+template<typename T>
+void measureChain(const String& name, const PublishSubject<int>& subject, const Observable<T>& chain)
+{
+    T sink = T();
+    DisposeBag disposeBag;
+    chain.subscribe([&sink](const T& value) { sink = value; }).disposedBy(disposeBag);
+
+    int next = 0;
+    ReaX_Benchmark::measure(name, NumEmissions, [&]() {
+        subject.onNext(++next);
+    });
+
+    CHECK(sink != T());
+}
+}
+
+TEST_CASE("Benchmark: Operator chains",
+          "[.][benchmark]")
+{
+    for (auto depth : ChainDepths) {
+        const String suffix = "/depth " + String(depth);
+        PublishSubject<int> subject;
+
+        Observable<int> mapChain = subject;
+        for (int i = 0; i < depth; ++i)
+            mapChain = mapChain.map([](int value) { return value + 1; });
+
+        measureChain("map chain" + suffix, subject, mapChain);
+
+        Observable<int> filterChain = subject;
+        for (int i = 0; i < depth; ++i)
+            filterChain = filterChain.filter([](int value) { return value >= 0; });
+
+        measureChain("filter chain" + suffix, subject, filterChain);
+
+        Observable<int> distinctChain = subject;
+        for (int i = 0; i < depth; ++i)
+            distinctChain = distinctChain.distinctUntilChanged();
+
+        measureChain("distinctUntilChanged chain" + suffix, subject, distinctChain);
+
+        const BehaviorSubject<int> other(1);
+        const Observable<int> otherObservable = other;
+        Observable<int> combineLatestChain = subject;
+        for (int i = 0; i < depth; ++i)
+            combineLatestChain = combineLatestChain.combineLatest([](int lhs, int rhs) { return lhs + rhs; }, otherObservable);
+
+        measureChain("combineLatest chain" + suffix, subject, combineLatestChain);
+    }
+}
+
+TEST_CASE("Benchmark: any",
+          "[.][benchmark]")
+{
+    const int iterations = 1000000;
+
+    IT("constructs and reads scalars")
+    {
+        float sum = 0;
+        ReaX_Benchmark::measure("any/float", iterations, [&sum]() {
+            const any value(0.5f);
+            sum += value.get<float>();
+        });
+
+        CHECK(sum > 0);
+    }
+
+    IT("constructs and reads objects")
+    {
+        const String string("Some string that is not too short");
+        int length = 0;
+        ReaX_Benchmark::measure("any/String", iterations, [&]() {
+            const any value(string);
+            length += value.get<String>().length();
+        });
+
+        CHECK(length > 0);
+    }
+
+    IT("constructs and reads large objects")
+    {
+        const std::array<float, 512> spectrum{};
+        float sum = 0;
+        ReaX_Benchmark::measure("any/std::array<float, 512>", iterations / 10, [&]() {
+            const any value(spectrum);
+            sum += value.get<std::array<float, 512>>()[0];
+        });
+
+        CHECK(sum == 0);
+    }
+}
+
+TEST_CASE("Benchmark: DisposeBag",
+          "[.][benchmark]")
+{
+    const PublishSubject<int> subject;
+
+    IT("subscribes and unsubscribes")
+    {
+        ReaX_Benchmark::measure("DisposeBag/subscribe and dispose", NumEmissions, [&subject]() {
+            DisposeBag disposeBag;
+            subject.subscribe([](int) {}).disposedBy(disposeBag);
+        });
+    }
+
+    IT("inserts and disposes individual subscriptions")
+    {
+        DisposeBag disposeBag;
+        ReaX_Benchmark::measure("DisposeBag/insert and dispose individually", NumEmissions, [&]() {
+            disposeBag.dispose(disposeBag.insert(subject.subscribe([](int) {})));
+        });
+    }
+
+    IT("disposes many subscriptions at once")
+    {
+        const int numSubscriptions = 1000;
+        ReaX_Benchmark::measure("DisposeBag/dispose 1000 subscriptions", 100, [&]() {
+            DisposeBag disposeBag;
+            for (int i = 0; i < numSubscriptions; ++i)
+                subject.subscribe([](int) {}).disposedBy(disposeBag);
+        });
+    }
+}
+
+TEST_CASE("Benchmark: Subject fan-out",
+          "[.][benchmark]")
+{
+    const int numSubscribers = 100;
+
+    const PublishSubject<int> publishSubject;
+    const ConcurrentPublishSubject<int> concurrentSubject;
+    int sum = 0;
+    DisposeBag disposeBag;
+
+    for (int i = 0; i < numSubscribers; ++i) {
+        publishSubject.subscribe([&sum](int value) { sum += value; }).disposedBy(disposeBag);
+        concurrentSubject.subscribe([&sum](int value) { sum += value; }).disposedBy(disposeBag);
+    }
+
+    ReaX_Benchmark::measure("PublishSubject/onNext, 100 subscribers", NumEmissions / 10, [&publishSubject]() {
+        publishSubject.onNext(1);
+    });
+    ReaX_Benchmark::measure("ConcurrentPublishSubject/onNext, 100 subscribers", NumEmissions / 10, [&concurrentSubject]() {
+        concurrentSubject.onNext(1);
+    });
+
+    CHECK(sum > 0);
+}
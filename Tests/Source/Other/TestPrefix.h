@@ -29,6 +29,14 @@ using namespace reax;
 #define ReaX_CheckValues(__arrayName, ...) CHECK(__arrayName == decltype(__arrayName)({ __VA_ARGS__ }))
 
 
+#if REAX_ENABLE_REALTIME_CHECKS
+/// The RealtimeChecks violation handler of the test runner. Many tests use CongestionPolicy::Allocate on purpose, so violations are logged instead of triggering an assertion.
+inline void ReaX_LogRealtimeViolation(const juce::String& description)
+{
+    juce::Logger::writeToLog("ReaX realtime violation: " + description);
+}
+#endif
+
 /// Runs the JUCE dispatch loop for a given time, to process async callbacks.
 inline void ReaX_RunDispatchLoop(int millisecondsToRunFor = 0)
 {
@@ -1,12 +1,5 @@
 #define CATCH_CONFIG_RUNNER
-#include "catch.hpp"
-
-#define DONT_SET_USING_JUCE_NAMESPACE 1
-#include "JuceHeader.h"
-
-REAX_ENABLE_EXTRA_WARNINGS
-
-using namespace juce;
+#include "TestPrefix.h"
 
 class TestRunnerApplication : public JUCEApplication
 {
@@ -19,12 +12,28 @@ public:
         freopen("CONOUT$", "w", stdout);
         freopen("CONOUT$", "w", stderr);
 #endif
+#if REAX_ENABLE_REALTIME_CHECKS
+        RealtimeChecks::setViolationHandler(&ReaX_LogRealtimeViolation);
+#endif
+
         Catch::ConfigData config;
         //		config.shouldDebugBreak = true;
 
         Catch::Session session;
         session.useConfigData(config);
-        session.run();
+
+        // Pass the command line to Catch, e.g. to run the benchmarks with "[benchmark]"
+        const StringArray parameters(getCommandLineParameterArray());
+        std::vector<std::string> arguments{ getApplicationName().toStdString() };
+        for (auto& parameter : parameters)
+            arguments.push_back(parameter.toStdString());
+
+        std::vector<const char*> argv;
+        for (auto& argument : arguments)
+            argv.push_back(argument.c_str());
+
+        if (session.applyCommandLine(static_cast<int>(argv.size()), argv.data(), Catch::Session::OnUnusedOptions::Ignore) == 0)
+            session.run();
 
         // Keep debug output window open on exit (Visual Studio):
 #if JUCE_DEBUG && JUCE_WINDOWS
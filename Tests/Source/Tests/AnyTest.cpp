@@ -143,6 +143,72 @@ TEST_CASE("any",
         }
     }
 
+    CONTEXT("small non-scalar types")
+    {
+        any anyRectangle(Rectangle<int>(4, 15, 100, 20));
+
+        IT("stores an independent copy in each instance")
+        {
+            static_assert(sizeof(Rectangle<int>) <= any::InlineStorageSize, "Rectangle<int> should be stored inline.");
+
+            any copy(anyRectangle);
+
+            REQUIRE(copy.get<Rectangle<int>>() == Rectangle<int>(4, 15, 100, 20));
+            REQUIRE(&copy.get<Rectangle<int>>() != &anyRectangle.get<Rectangle<int>>());
+            REQUIRE(copy == anyRectangle);
+        }
+
+        IT("stores JUCE types that are cheap to copy inline")
+        {
+            const any string(String("Hello"));
+            const any copy(string);
+
+            REQUIRE(copy.get<String>() == "Hello");
+            REQUIRE(&copy.get<String>() != &string.get<String>());
+        }
+
+        IT("shares small containers between copies, instead of deep-copying them")
+        {
+            const any array(Array<int>({ 1, 2, 3 }));
+            const any copy(array);
+
+            REQUIRE(&copy.get<Array<int>>() == &array.get<Array<int>>());
+        }
+
+        IT("can hold a small container of move-only values")
+        {
+            std::vector<std::unique_ptr<int>> pointers;
+            pointers.emplace_back(new int(17));
+            const any anyPointers(std::move(pointers));
+            const any copy(anyPointers);
+
+            REQUIRE(*copy.get<std::vector<std::unique_ptr<int>>>().front() == 17);
+        }
+
+        IT("can be assigned values of other types")
+        {
+            any value(anyRectangle);
+            value = any(String("Hello"));
+            REQUIRE(value.get<String>() == "Hello");
+
+            value = any(var(3.5));
+            REQUIRE(value.get<var>() == var(3.5));
+
+            value = any(17);
+            REQUIRE(value.get<int>() == 17);
+
+            value = anyRectangle;
+            REQUIRE(value == anyRectangle);
+        }
+
+        IT("is non-equal to values of other kinds")
+        {
+            REQUIRE(anyRectangle != any(Rectangle<float>(4, 15, 100, 20)));
+            REQUIRE(anyRectangle != any(String("Hello")));
+            REQUIRE(anyRectangle != any(17));
+        }
+    }
+
     CONTEXT("pointers")
     {
         IT("can store a pointer to a struct")
@@ -275,6 +341,24 @@ TEST_CASE("any",
             REQUIRE(any(foo) != any(foo));
         }
 
+        IT("distinguishes types with the same layout")
+        {
+            struct Bar
+            {
+                Bar(int x)
+                : x(x) {}
+
+                int x;
+            };
+
+            any anyFoo(Foo(5));
+
+            REQUIRE(anyFoo.is<Foo>());
+            REQUIRE_FALSE(anyFoo.is<Bar>());
+            REQUIRE_THROWS_WITH(anyFoo.get<Bar>(), Contains("Error getting type from any."));
+            REQUIRE(anyFoo != any(Bar(5)));
+        }
+
         IT("is non-equal if two instances are constructed from two different values")
         {
             Foo foo1(16);
@@ -354,5 +438,25 @@ TEST_CASE("any",
             REQUIRE(ptrRef.get() == address);
             REQUIRE(*ptrRef == 17);
         }
+
+        IT("can move the value out once")
+        {
+            any anyPtr(std::unique_ptr<int>(new int(17)));
+            const any copy(anyPtr);
+
+            const std::unique_ptr<int> ptr = copy.take<std::unique_ptr<int>>();
+            REQUIRE(*ptr == 17);
+
+            // The value has been taken from all copies
+            REQUIRE_THROWS_WITH(anyPtr.get<std::unique_ptr<int>>(), Contains("moved out"));
+            REQUIRE_THROWS_WITH(anyPtr.take<std::unique_ptr<int>>(), Contains("moved out"));
+        }
+
+        IT("copies scalars and inline objects when taking them")
+        {
+            const any anyInt(17);
+            REQUIRE(anyInt.take<int>() == 17);
+            REQUIRE(anyInt.get<int>() == 17);
+        }
     }
 }
@@ -0,0 +1,125 @@
+#include "../Other/TestPrefix.h"
+
+#include <thread>
+
+TEST_CASE("AudioBlockSource",
+          "[AudioBlockSource]")
+{
+    AudioBlockSource source(2, 2, 512);
+    Array<AudioBlock> blocks;
+    ReaX_CollectValues(source, blocks);
+
+    AudioBuffer<float> buffer(2, 256);
+    buffer.clear();
+
+    IT("emits the written blocks asynchronously")
+    {
+        buffer.setSample(0, 0, 0.5f);
+        buffer.setSample(1, 255, -1.f);
+        CHECK(source.write(buffer));
+        CHECK(blocks.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(blocks.size() == 1);
+
+        const auto& emitted = blocks[0].getBuffer();
+        CHECK(emitted.getNumChannels() == 2);
+        CHECK(emitted.getNumSamples() == 256);
+        CHECK(emitted.getSample(0, 0) == 0.5f);
+        REQUIRE(emitted.getSample(1, 255) == -1.f);
+    }
+
+    IT("fills a slot in place")
+    {
+        source.write(1, 4, [](AudioBuffer<float>& slot) {
+            for (int i = 0; i < slot.getNumSamples(); ++i)
+                slot.setSample(0, i, static_cast<float>(i));
+        });
+
+        ReaX_RunDispatchLoopUntil(blocks.size() == 1);
+
+        const auto& emitted = blocks[0].getBuffer();
+        CHECK(emitted.getNumChannels() == 1);
+        CHECK(emitted.getNumSamples() == 4);
+        REQUIRE(emitted.getSample(0, 3) == 3.f);
+    }
+
+    IT("drops blocks while all slots are in use, and reuses released slots")
+    {
+        CHECK(source.write(buffer));
+        CHECK(source.write(buffer));
+        CHECK(source.getNumFreeSlots() == 0);
+        CHECK_FALSE(source.write(buffer));
+
+        ReaX_RunDispatchLoopUntil(blocks.size() == 2);
+        // The collected handles still use the slots
+        CHECK_FALSE(source.write(buffer));
+
+        blocks.clear();
+        CHECK(source.getNumFreeSlots() == 2);
+        REQUIRE(source.write(buffer));
+    }
+
+    IT("releases a slot when the last copy of a handle is released")
+    {
+        source.write(buffer);
+        ReaX_RunDispatchLoopUntil(blocks.size() == 1);
+
+        AudioBlock copy = blocks[0];
+        blocks.clear();
+        CHECK(source.getNumFreeSlots() == 1);
+
+        copy.release();
+        CHECK_FALSE(copy.isValid());
+        REQUIRE(source.getNumFreeSlots() == 2);
+    }
+
+    IT("keeps emitted blocks valid after the source is destroyed")
+    {
+        AudioBlock block;
+        {
+            AudioBlockSource temporarySource(1, 1, 16);
+            DisposeBag disposeBag;
+            temporarySource.subscribe([&block](const AudioBlock& emitted) { block = emitted; }).disposedBy(disposeBag);
+
+            temporarySource.write(1, 16, [](AudioBuffer<float>& slot) { slot.clear(); slot.setSample(0, 15, 2.f); });
+            ReaX_RunDispatchLoopUntil(block.isValid());
+        }
+
+        REQUIRE(block.getBuffer().getSample(0, 15) == 2.f);
+    }
+}
+
+
+TEST_CASE("AudioBlockSource from another thread",
+          "[AudioBlockSource]")
+{
+    AudioBlockSource source(2, 1, 512);
+
+    IT("passes complete blocks, and reuses the slots")
+    {
+        const int numBlocks = 100;
+        int numReceived = 0;
+        bool allConsistent = true;
+        DisposeBag disposeBag;
+        source.subscribe([&](const AudioBlock& block) {
+                  const auto& received = block.getBuffer();
+                  for (int i = 0; i < received.getNumSamples(); ++i)
+                      allConsistent = allConsistent && (received.getSample(0, i) == received.getSample(0, 0));
+
+                  numReceived++;
+              })
+            .disposedBy(disposeBag);
+
+        std::thread producer([&source]() {
+            for (int i = 1; i <= numBlocks; ++i) {
+                while (!source.write(1, 512, [i](AudioBuffer<float>& slot) { FloatVectorOperations::fill(slot.getWritePointer(0), static_cast<float>(i), slot.getNumSamples()); }))
+                    Thread::sleep(1);
+            }
+        });
+
+        ReaX_RunDispatchLoopUntil(numReceived == numBlocks);
+        producer.join();
+
+        REQUIRE(allConsistent);
+    }
+}
@@ -0,0 +1,105 @@
+#include "../Other/TestPrefix.h"
+
+
+TEST_CASE("Computed",
+          "[Computed]")
+{
+    BehaviorSubject<int> subject(2);
+    int numComputations = 0;
+    Computed<String> computed(subject, [&numComputations](int i) {
+        numComputations++;
+        return String(i * 10);
+    });
+    DisposeBag disposeBag;
+
+    IT("doesn't compute or observe upstream when it's created")
+    {
+        CHECK(numComputations == 0);
+        CHECK(!computed.isObservingUpstream());
+    }
+
+    IT("computes the value when it's read, and returns the cached value afterwards")
+    {
+        REQUIRE(computed.getValue() == "20");
+        REQUIRE(computed.getValue() == "20");
+        REQUIRE(numComputations == 1);
+    }
+
+    IT("recomputes on read only if upstream has changed")
+    {
+        computed.getValue();
+        subject.onNext(3);
+        subject.onNext(4);
+        REQUIRE(numComputations == 1);
+
+        REQUIRE(computed.getValue() == "40");
+        REQUIRE(numComputations == 2);
+
+        subject.onNext(4);
+        computed.getValue();
+        REQUIRE(numComputations == 2);
+    }
+
+    IT("throws if upstream hasn't emitted a value")
+    {
+        PublishSubject<int> publishSubject;
+        Computed<int> fromPublishSubject(publishSubject, [](int i) { return i * 2; });
+        REQUIRE_THROWS_AS(fromPublishSubject.getValue(), std::runtime_error);
+    }
+
+    IT("notifies onError if upstream hasn't emitted a value on subscribe, and stops observing upstream")
+    {
+        PublishSubject<int> publishSubject;
+        Computed<int> fromPublishSubject(publishSubject, [](int i) { return i * 2; });
+        bool failed = false;
+        fromPublishSubject.subscribe([](int) {}, [&failed](std::exception_ptr) { failed = true; }).disposedBy(disposeBag);
+
+        REQUIRE(failed);
+        REQUIRE(!fromPublishSubject.isObservingUpstream());
+        REQUIRE(!publishSubject.hasSubscribers());
+    }
+
+    IT("emits the current value on subscribe, and recomputes whenever upstream changes while subscribed")
+    {
+        Array<String> values;
+        ReaX_CollectValues(computed, values);
+        ReaX_CheckValues(values, "20");
+        CHECK(computed.isObservingUpstream());
+
+        subject.onNext(3);
+        subject.onNext(3);
+        subject.onNext(5);
+
+        ReaX_RequireValues(values, "20", "30", "50");
+        REQUIRE(numComputations == 3);
+        REQUIRE(computed.getValue() == "50");
+        REQUIRE(numComputations == 3);
+    }
+
+    IT("computes once for several subscribers")
+    {
+        Array<String> first, second;
+        ReaX_CollectValues(computed, first);
+        ReaX_CollectValues(computed, second);
+        subject.onNext(7);
+
+        ReaX_CheckValues(first, "20", "70");
+        ReaX_CheckValues(second, "20", "70");
+        REQUIRE(numComputations == 2);
+    }
+
+    IT("pauses the upstream subscription when the last subscriber unsubscribes")
+    {
+        auto subscription = computed.subscribe([](const String&) {});
+        REQUIRE(computed.isObservingUpstream());
+
+        subscription.unsubscribe();
+        REQUIRE(!computed.isObservingUpstream());
+
+        subject.onNext(8);
+        subject.onNext(9);
+        REQUIRE(numComputations == 1);
+        REQUIRE(computed.getValue() == "90");
+        REQUIRE(numComputations == 2);
+    }
+}
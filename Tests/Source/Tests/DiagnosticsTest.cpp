@@ -0,0 +1,62 @@
+#include "../Other/TestPrefix.h"
+
+// These tests only run if REAX_ENABLE_DIAGNOSTICS is enabled, i.e. in the "Debug Instrumentation" configuration of the test project.
+#if REAX_ENABLE_DIAGNOSTICS
+
+TEST_CASE("Diagnostics",
+          "[Diagnostics]")
+{
+    const auto before = Diagnostics::getSnapshot();
+
+    IT("counts live subjects once, including copies")
+    {
+        {
+            PublishSubject<int> subject;
+            const PublishSubject<int> copy(subject);
+            REQUIRE(Diagnostics::getSnapshot().numLiveSubjects == before.numLiveSubjects + 1);
+        }
+
+        REQUIRE(Diagnostics::getSnapshot().numLiveSubjects == before.numLiveSubjects);
+    }
+
+    IT("counts subscriptions until they are disposed")
+    {
+        PublishSubject<int> subject;
+
+        {
+            DisposeBag disposeBag;
+            for (int i = 0; i < 3; ++i)
+                subject.subscribe([](int) {}).disposedBy(disposeBag);
+
+            REQUIRE(Diagnostics::getSnapshot().numLiveSubscriptions == before.numLiveSubscriptions + 3);
+        }
+
+        REQUIRE(Diagnostics::getSnapshot().numLiveSubscriptions == before.numLiveSubscriptions);
+    }
+
+    IT("doesn't count subscriptions that have completed")
+    {
+        Observable<int>::just(1).subscribe([](int) {});
+
+        REQUIRE(Diagnostics::getSnapshot().numLiveSubscriptions == before.numLiveSubscriptions);
+    }
+
+    IT("reports the number of values in each queue")
+    {
+        LockFreeSource<int> source(8, ProducerMode::SingleProducer);
+        source.getQueueProbe().setName("Test Source");
+        source.onNext(1, CongestionPolicy::DropNewest);
+        source.onNext(2, CongestionPolicy::DropNewest);
+
+        size_t numValues = 0;
+        for (auto& queue : Diagnostics::getSnapshot().queues) {
+            if (queue.name == "Test Source")
+                numValues = queue.numValues;
+        }
+
+        REQUIRE(numValues == 2);
+        REQUIRE(Diagnostics::describe().contains("Test Source: 2 queued values"));
+    }
+}
+
+#endif
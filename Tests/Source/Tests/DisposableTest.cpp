@@ -112,3 +112,74 @@ TEST_CASE("DisposeBag",
         REQUIRE(values.isEmpty());
     }
 }
+
+
+TEST_CASE("DisposeBag individual disposal",
+          "[DisposeBag]")
+{
+    PublishSubject<int> subject;
+    DisposeBag disposeBag;
+    Array<int> first;
+    Array<int> second;
+
+    const auto firstHandle = disposeBag.insert(subject.subscribe([&first](int value) { first.add(value); }));
+    const auto secondHandle = disposeBag.insert(subject.subscribe([&second](int value) { second.add(value); }));
+    CHECK(disposeBag.size() == 2);
+
+    IT("disposes a single Subscription")
+    {
+        disposeBag.dispose(firstHandle);
+        subject.onNext(1);
+
+        CHECK(disposeBag.size() == 1);
+        CHECK(first.isEmpty());
+        ReaX_RequireValues(second, 1);
+    }
+
+    IT("ignores a Handle that has already been disposed, even if its slot has been reused")
+    {
+        disposeBag.dispose(firstHandle);
+
+        Array<int> third;
+        disposeBag.insert(subject.subscribe([&third](int value) { third.add(value); }));
+        disposeBag.dispose(firstHandle);
+        subject.onNext(1);
+
+        CHECK(disposeBag.size() == 2);
+        ReaX_RequireValues(third, 1);
+    }
+
+    IT("ignores a default-constructed Handle")
+    {
+        disposeBag.dispose(DisposeBag::Handle());
+
+        REQUIRE(disposeBag.size() == 2);
+    }
+
+    IT("disposes all Subscriptions when clearing, and can be used again")
+    {
+        disposeBag.clear();
+        subject.onNext(1);
+
+        CHECK(disposeBag.size() == 0);
+        CHECK(first.isEmpty());
+        CHECK(second.isEmpty());
+
+        disposeBag.dispose(secondHandle);
+        disposeBag.insert(subject.subscribe([&first](int value) { first.add(value); }));
+        subject.onNext(2);
+
+        CHECK(disposeBag.size() == 1);
+        ReaX_RequireValues(first, 2);
+    }
+
+    IT("can dispose many short-lived Subscriptions")
+    {
+        for (int i = 0; i < 1000; ++i) {
+            const auto handle = disposeBag.insert(subject.subscribe([](int) {}));
+            disposeBag.dispose(handle);
+        }
+
+        REQUIRE(disposeBag.size() == 2);
+    }
+}
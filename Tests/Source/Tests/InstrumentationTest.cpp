@@ -0,0 +1,97 @@
+#include "../Other/TestPrefix.h"
+
+// These tests only run if REAX_ENABLE_INSTRUMENTATION is enabled, i.e. in the "Debug Instrumentation" configuration of the test project.
+#if REAX_ENABLE_INSTRUMENTATION
+
+TEST_CASE("Instrumentation",
+          "[Instrumentation]")
+{
+    Instrumentation::reset();
+
+    LockFreeSource<int> source(2, ProducerMode::SingleProducer);
+    source.getProbe().setName("Test Source");
+    Array<int> values;
+    ReaX_CollectValues(source, values);
+
+    const auto findSnapshot = []() -> Instrumentation::Snapshot {
+        for (auto& snapshot : Instrumentation::getSnapshots()) {
+            if (snapshot.name == "Test Source")
+                return snapshot;
+        }
+
+        FAIL("No snapshot for the probe.");
+        return Instrumentation::Snapshot();
+    };
+
+    IT("counts emissions and drops")
+    {
+        for (int i = 0; i < 5; ++i)
+            source.onNext(i, CongestionPolicy::DropNewest);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+
+        const auto snapshot = findSnapshot();
+        REQUIRE(snapshot.numEmissions == 2);
+        REQUIRE(snapshot.numDrops == 3);
+        REQUIRE(snapshot.queueHighWaterMark == 2);
+        REQUIRE(snapshot.latency50thPercentile > 0.);
+        REQUIRE(snapshot.latency50thPercentile <= snapshot.latency99thPercentile);
+    }
+
+    IT("counts overwritten values as drops")
+    {
+        for (int i = 0; i < 5; ++i)
+            source.onNext(i, CongestionPolicy::DropOldest);
+
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+        ReaX_RequireValues(values, 3, 4);
+
+        const auto snapshot = findSnapshot();
+        REQUIRE(snapshot.numEmissions == 2);
+        REQUIRE(snapshot.numDrops == 3);
+    }
+
+    IT("gives each probe a distinct default name")
+    {
+        LockFreeSource<int> first(1);
+        LockFreeSource<int> second(1);
+
+        REQUIRE(first.getProbe().getName().startsWith("LockFreeSource"));
+        REQUIRE(first.getProbe().getName() != second.getProbe().getName());
+    }
+
+    IT("exports the trace events as JSON")
+    {
+        source.onNext(17, CongestionPolicy::DropNewest);
+        ReaX_RunDispatchLoopUntil(values.size() == 1);
+
+        const var trace = JSON::parse(Instrumentation::exportChromeTrace());
+        const auto events = trace["traceEvents"].getArray();
+        REQUIRE(events != nullptr);
+
+        StringArray names;
+        for (auto& event : *events) {
+            names.add(event["name"].toString());
+
+            if (event["name"].toString().startsWith("LockFreeSource"))
+                REQUIRE(event["args"]["pipeline"].toString() == "Test Source");
+        }
+
+        REQUIRE(names.contains("LockFreeSource::onNext"));
+        REQUIRE(names.contains("LockFreeSource::emit"));
+        REQUIRE(names.contains("Subscriber::onNext"));
+    }
+
+    IT("resets the counters")
+    {
+        source.onNext(3, CongestionPolicy::DropNewest);
+        ReaX_RunDispatchLoopUntil(values.size() == 1);
+
+        Instrumentation::reset();
+
+        REQUIRE(findSnapshot().numEmissions == 0);
+        REQUIRE(JSON::parse(Instrumentation::exportChromeTrace())["traceEvents"].getArray()->isEmpty());
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "../Other/TestPrefix.h"
+
+#include <thread>
+
+TEST_CASE("LatestValueSource",
+          "[LatestValueSource]")
+{
+    typedef std::array<float, 512> Spectrum;
+
+    LatestValueSource<Spectrum> source;
+    Array<float> firstBins;
+    DisposeBag disposeBag;
+    source.subscribe([&](const Spectrum& spectrum) {
+              firstBins.add(spectrum[0]);
+          })
+        .disposedBy(disposeBag);
+
+    IT("emits values asynchronously")
+    {
+        source.write([](Spectrum& spectrum) { spectrum.fill(0.5f); });
+        CHECK(firstBins.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(firstBins.size() == 1);
+        ReaX_RequireValues(firstBins, 0.5f);
+    }
+
+    IT("emits only the latest value")
+    {
+        for (int i = 0; i < 10; ++i) {
+            Spectrum spectrum;
+            spectrum.fill(static_cast<float>(i));
+            source.onNext(spectrum);
+        }
+
+        ReaX_RunDispatchLoopUntil(!firstBins.isEmpty());
+        ReaX_RunDispatchLoop(20);
+        ReaX_RequireValues(firstBins, 9.f);
+    }
+
+    IT("emits each snapshot only once")
+    {
+        source.write([](Spectrum& spectrum) { spectrum.fill(3.f); });
+        ReaX_RunDispatchLoopUntil(firstBins.size() == 1);
+        ReaX_RunDispatchLoop(20);
+
+        ReaX_RequireValues(firstBins, 3.f);
+    }
+
+    IT("never emits a partially written snapshot")
+    {
+        bool allConsistent = true;
+        source.subscribe([&](const Spectrum& spectrum) {
+                  for (auto bin : spectrum)
+                      allConsistent = allConsistent && (bin == spectrum[0]);
+              })
+            .disposedBy(disposeBag);
+
+        std::thread producer([&source]() {
+            for (int i = 1; i <= 2000; ++i)
+                source.write([i](Spectrum& spectrum) { spectrum.fill(static_cast<float>(i)); });
+        });
+
+        ReaX_RunDispatchLoopUntil(!firstBins.isEmpty() && firstBins.getLast() == 2000.f);
+        producer.join();
+
+        REQUIRE(allConsistent);
+    }
+}
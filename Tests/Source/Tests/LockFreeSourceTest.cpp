@@ -1,5 +1,7 @@
 #include "../Other/TestPrefix.h"
 
+#include <thread>
+
 TEST_CASE("LockFreeSource",
           "[LockFreeSource]")
 {
@@ -50,6 +52,248 @@ TEST_CASE("LockFreeSource",
         }
     }
     
+    CONTEXT("Single producer mode")
+    {
+        Array<int> values;
+        LockFreeSource<int> source(3, ProducerMode::SingleProducer);
+        ReaX_CollectValues(source, values);
+
+        IT("emits values asynchronously via the Observable")
+        {
+            for (auto i : {4, 58, 18})
+                source.onNext(i, CongestionPolicy::DropNewest);
+
+            CHECK(values.isEmpty());
+
+            ReaX_RunDispatchLoopUntil(values.size() == 3);
+            ReaX_RequireValues(values, 4, 58, 18);
+        }
+
+        IT("discards the oldest values, with the exact capacity")
+        {
+            for (int i = 0; i < 100; ++i)
+                source.onNext(i * 17, CongestionPolicy::DropOldest);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 3);
+            ReaX_RequireValues(values, 97 * 17, 98 * 17, 99 * 17);
+        }
+
+        IT("discards the newest values, with the exact capacity")
+        {
+            for (int i = 0; i < 100; ++i)
+                source.onNext(i, CongestionPolicy::DropNewest);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 3);
+            ReaX_RequireValues(values, 0, 1, 2);
+        }
+
+        IT("doesn't allocate for CongestionPolicy::Allocate")
+        {
+            for (int i = 0; i < 100; ++i)
+                source.onNext(i, CongestionPolicy::Allocate);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 3);
+            ReaX_RequireValues(values, 0, 1, 2);
+        }
+
+        IT("receives all values in order from another thread")
+        {
+            LockFreeSource<int> threadSource(16, ProducerMode::SingleProducer);
+            Array<int> threadValues;
+            ReaX_CollectValues(threadSource, threadValues);
+
+            std::thread producer([&threadSource]() {
+                for (int i = 0; i < 1000; ++i) {
+                    // Retry until there's space in the queue
+                    while (!threadSource.onNext(i, CongestionPolicy::DropNewest))
+                        std::this_thread::yield();
+                }
+            });
+
+            ReaX_RunDispatchLoopUntil(threadValues.size() == 1000);
+            producer.join();
+
+            for (int i = 0; i < 1000; ++i)
+                REQUIRE(threadValues[i] == i);
+        }
+
+        IT("keeps the oldest value if the consumer is reading the slot that would be overwritten")
+        {
+            detail::SingleProducerQueue<int> queue(3, 0);
+            for (auto i : {1, 2, 3})
+                queue.tryPush(i);
+
+            Array<int> popped;
+            queue.popBulk(1, [&](int&& value) {
+                popped.add(value);
+
+                // The queue is full, so this drops 1, which is being read
+                CHECK(queue.pushOverwritingOldest(4));
+                // This needs the slot that is being read, so it's discarded without dropping 2
+                CHECK_FALSE(queue.pushOverwritingOldest(5));
+            });
+
+            queue.popBulk(queue.getCapacity(), [&](int&& value) { popped.add(value); });
+            ReaX_RequireValues(popped, 1, 2, 3, 4);
+        }
+
+        IT("never lets the producer overwrite a value that is being read")
+        {
+            // Each value is written into all of its fields, so a torn read is detected
+            struct Value
+            {
+                int fields[16];
+            };
+
+            Value initial;
+            std::fill(std::begin(initial.fields), std::end(initial.fields), -1);
+            detail::SingleProducerQueue<Value> queue(3, initial);
+
+            const int numValues = 200000;
+            std::atomic<bool> producerFinished{ false };
+
+            std::thread producer([&]() {
+                for (int i = 0; i < numValues; ++i) {
+                    Value value;
+                    std::fill(std::begin(value.fields), std::end(value.fields), i);
+
+                    if (i % 3 == 0)
+                        queue.tryPush(value);
+                    else
+                        queue.pushOverwritingOldest(value);
+                }
+
+                producerFinished = true;
+            });
+
+            bool isConsistent = true;
+            int previous = -1;
+            const auto check = [&](Value&& value) {
+                for (auto field : value.fields)
+                    isConsistent &= (field == value.fields[0]);
+
+                isConsistent &= (value.fields[0] > previous);
+                previous = value.fields[0];
+            };
+
+            while (!producerFinished)
+                queue.popBulk(queue.getCapacity(), check);
+
+            producer.join();
+            queue.popBulk(queue.getCapacity(), check);
+
+            REQUIRE(isConsistent);
+        }
+    }
+
+    CONTEXT("Batches")
+    {
+        Array<Array<float>> batches;
+        Array<float> values;
+        DisposeBag disposeBag;
+
+        const auto collectBatches = [&](const LockFreeSource<float>& source) {
+            source.asBatchObservable().subscribe([&](const Span<float>& batch) {
+                                          batches.add(batch.toArray());
+                                      })
+                .disposedBy(disposeBag);
+        };
+
+        IT("emits all values since the last update as one batch")
+        {
+            LockFreeSource<float> source(4, ProducerMode::SingleProducer);
+            collectBatches(source);
+            ReaX_CollectValues(source, values);
+
+            for (auto f : {0.5f, 0.25f, -1.f})
+                source.onNext(f, CongestionPolicy::DropNewest);
+
+            ReaX_RunDispatchLoopUntil(batches.size() == 1);
+            REQUIRE(batches.getFirst() == Array<float>({ 0.5f, 0.25f, -1.f }));
+            ReaX_RequireValues(values, 0.5f, 0.25f, -1.f);
+        }
+
+        IT("only emits the values one by one while the LockFreeSource itself is observed")
+        {
+            LockFreeSource<float> source(4, ProducerMode::SingleProducer);
+            collectBatches(source);
+            source.onNext(0.5f, CongestionPolicy::DropNewest);
+            ReaX_RunDispatchLoopUntil(batches.size() == 1);
+
+            ReaX_CollectValues(source, values);
+            source.onNext(0.25f, CongestionPolicy::DropNewest);
+            ReaX_RunDispatchLoopUntil(batches.size() == 2);
+
+            REQUIRE(batches.getLast() == Array<float>({ 0.25f }));
+            ReaX_RequireValues(values, 0.25f);
+        }
+
+        IT("emits more values than the queue capacity, if the queue has allocated")
+        {
+            LockFreeSource<float> source(2);
+            collectBatches(source);
+
+            for (int i = 0; i < 100; ++i)
+                source.onNext(static_cast<float>(i), CongestionPolicy::Allocate);
+
+            ReaX_RunDispatchLoopUntil(!batches.isEmpty());
+            REQUIRE(batches.size() == 1);
+            REQUIRE(batches.getFirst().size() == 100);
+            REQUIRE(batches.getFirst().getLast() == 99.f);
+        }
+    }
+
+    CONTEXT("LockFreeSourceHub")
+    {
+        LockFreeSourceHub hub(2);
+
+        IT("drains all dirty sources in one pass")
+        {
+            LockFreeSource<int> first(hub, 4, ProducerMode::SingleProducer);
+            LockFreeSource<int> second(hub, 4, ProducerMode::SingleProducer);
+            LockFreeSource<int> unused(hub, 4, ProducerMode::SingleProducer);
+            Array<int> firstValues, secondValues;
+            ReaX_CollectValues(first, firstValues);
+            ReaX_CollectValues(second, secondValues);
+            CHECK(hub.getNumSources() == 2);
+
+            first.onNext(1, CongestionPolicy::DropNewest);
+            second.onNext(10, CongestionPolicy::DropNewest);
+            first.onNext(2, CongestionPolicy::DropNewest);
+            CHECK(firstValues.isEmpty());
+
+            ReaX_RunDispatchLoopUntil(firstValues.size() == 2 && secondValues.size() == 1);
+            ReaX_RequireValues(firstValues, 1, 2);
+            ReaX_RequireValues(secondValues, 10);
+        }
+
+        IT("falls back to the source's own messages if the hub is full")
+        {
+            LockFreeSource<int> first(hub, 4);
+            LockFreeSource<int> second(hub, 4);
+            LockFreeSource<int> third(hub, 4);
+            Array<int> values;
+            ReaX_CollectValues(third, values);
+
+            third.onNext(5, CongestionPolicy::DropNewest);
+
+            ReaX_RunDispatchLoopUntil(values.size() == 1);
+            ReaX_RequireValues(values, 5);
+        }
+
+        IT("unregisters sources when they are destroyed")
+        {
+            {
+                LockFreeSource<int> source(hub, 4);
+                source.onNext(1, CongestionPolicy::DropNewest);
+                CHECK(hub.getNumSources() == 1);
+            }
+
+            REQUIRE(hub.getNumSources() == 0);
+            ReaX_RunDispatchLoop(20);
+        }
+    }
+
     CONTEXT("move semantics")
     {
         // Create source
@@ -133,6 +133,135 @@ TEST_CASE("LockFreeTarget",
         }
     }
     
+    CONTEXT("bounded queue")
+    {
+        int value = 0;
+
+        IT("discards the newest values if the queue is full")
+        {
+            LockFreeTarget<int> target(3, CongestionPolicy::DropNewest);
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            Array<int> values;
+            while (target.tryDequeue(value))
+                values.add(value);
+
+            ReaX_RequireValues(values, 0, 1, 2);
+        }
+
+        IT("discards the oldest values if the queue is full")
+        {
+            LockFreeTarget<int> target(3, CongestionPolicy::DropOldest);
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            Array<int> values;
+            while (target.tryDequeue(value))
+                values.add(value);
+
+            ReaX_RequireValues(values, 7, 8, 9);
+        }
+
+        IT("reports the number of queued values")
+        {
+            LockFreeTarget<int> target(3, CongestionPolicy::DropOldest);
+            CHECK(target.getNumQueuedValues() == 0);
+
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            REQUIRE(target.getNumQueuedValues() == 3);
+            target.tryDequeue(value);
+            REQUIRE(target.getNumQueuedValues() == 2);
+        }
+
+        IT("returns the newest value from tryDequeueAll")
+        {
+            LockFreeTarget<int> target(3, CongestionPolicy::DropOldest);
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            CHECK(target.tryDequeueAll(value));
+            CHECK(value == 9);
+            REQUIRE_FALSE(target.tryDequeue(value));
+        }
+    }
+    
+    CONTEXT("bulk dequeueing")
+    {
+        IT("dequeues several values in one go")
+        {
+            LockFreeTarget<int> target;
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            int values[8];
+            CHECK(target.tryDequeueBulk(values, 8) == 8);
+            CHECK(values[0] == 0);
+            CHECK(values[7] == 7);
+            CHECK(target.tryDequeueBulk(values, 8) == 2);
+            CHECK(values[1] == 9);
+            REQUIRE(target.tryDequeueBulk(values, 8) == 0);
+        }
+
+        IT("dequeues several values in one go from a bounded queue")
+        {
+            LockFreeTarget<int> target(4, CongestionPolicy::DropNewest);
+            for (int i = 0; i < 10; ++i)
+                target.onNext(i);
+
+            int values[8];
+            CHECK(target.tryDequeueBulk(values, 8) == 4);
+            REQUIRE(values[3] == 3);
+        }
+
+        IT("dequeues only the newest value")
+        {
+            LockFreeTarget<String> unbounded;
+            LockFreeTarget<String> bounded(4, CongestionPolicy::DropOldest);
+            for (int i = 0; i < 100; ++i) {
+                unbounded.onNext(String(i));
+                bounded.onNext(String(i));
+            }
+
+            String value;
+            CHECK(unbounded.tryDequeueLatest(value));
+            CHECK(value == "99");
+            CHECK(bounded.tryDequeueLatest(value));
+            CHECK(value == "99");
+
+            CHECK_FALSE(unbounded.tryDequeueLatest(value));
+            REQUIRE_FALSE(bounded.tryDequeueLatest(value));
+        }
+
+        IT("doesn't assign the older values of an unbounded queue")
+        {
+            struct CountingValue
+            {
+                CountingValue& operator=(int newValue)
+                {
+                    value = newValue;
+                    ++numAssignments;
+                    return *this;
+                }
+
+                int value = 0;
+                int numAssignments = 0;
+            };
+
+            LockFreeTarget<int> target;
+            for (int i = 0; i < 100; ++i)
+                target.onNext(i);
+
+            CountingValue latest;
+            CHECK(target.tryDequeueLatest(latest));
+            CHECK(latest.value == 99);
+            CHECK(latest.numAssignments == 1);
+            REQUIRE(target.getNumQueuedValues() == 0);
+        }
+    }
+    
     CONTEXT("move semantics")
     {
         LockFreeTarget<CopyAndMoveConstructible> target;
@@ -0,0 +1,67 @@
+#include "../Other/TestPrefix.h"
+
+namespace {
+typedef std::array<float, 128> Chunk;
+
+MemoryPool::Usage getUsageForBlockSize(size_t minimumSize)
+{
+    for (auto& usage : MemoryPool::getUsage()) {
+        if (usage.blockSize >= minimumSize)
+            return usage;
+    }
+
+    return MemoryPool::Usage();
+}
+}
+
+TEST_CASE("MemoryPool",
+          "[MemoryPool]")
+{
+    const size_t allocationSize = detail::any::getAllocationSize(Chunk());
+    REQUIRE(allocationSize > sizeof(Chunk));
+
+    IT("doesn't pool values that are stored inline")
+    {
+        REQUIRE(detail::any::getAllocationSize(Rectangle<int>()) == 0);
+    }
+
+    IT("pre-warms the pool")
+    {
+        MemoryPool::reserve(Chunk(), 32);
+
+        REQUIRE(getUsageForBlockSize(allocationSize).numFreeBlocks >= 32);
+    }
+
+    IT("reuses memory when emitting values")
+    {
+        MemoryPool::reserve(Chunk(), 16);
+        const auto numHeapAllocations = getUsageForBlockSize(allocationSize).numHeapAllocations;
+
+        PublishSubject<Chunk> subject;
+        Array<float> values;
+        DisposeBag disposeBag;
+        subject.subscribe([&values](const Chunk& chunk) { values.add(chunk[0]); }).disposedBy(disposeBag);
+
+        Chunk chunk;
+        for (int i = 0; i < 100; ++i) {
+            chunk.fill(static_cast<float>(i));
+            subject.onNext(chunk);
+        }
+
+        REQUIRE(values.size() == 100);
+        REQUIRE(values.getLast() == 99.f);
+        REQUIRE(getUsageForBlockSize(allocationSize).numHeapAllocations == numHeapAllocations);
+    }
+
+    IT("reports the bytes held by values that aren't stored inline")
+    {
+        const size_t numBytesInUse = MemoryPool::getNumBytesInUse();
+
+        {
+            const detail::any value(Chunk{});
+            REQUIRE(MemoryPool::getNumBytesInUse() >= numBytesInUse + allocationSize);
+        }
+
+        REQUIRE(MemoryPool::getNumBytesInUse() == numBytesInUse);
+    }
+}
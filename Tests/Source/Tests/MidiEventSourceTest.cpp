@@ -0,0 +1,125 @@
+#include "../Other/TestPrefix.h"
+
+#include <thread>
+
+namespace {
+// Copies the events, so they can be checked after the Span is invalid
+struct ReceivedEvent
+{
+    MidiMessage message;
+    bool isTruncated;
+};
+}
+
+TEST_CASE("MidiEventSource",
+          "[MidiEventSource]")
+{
+    MidiEventSource source(1024, 16, OversizedEventPolicy::Drop);
+    Array<ReceivedEvent> events;
+    int numBatches = 0;
+    DisposeBag disposeBag;
+    source.subscribe([&](const Span<MidiEventView>& batch) {
+              numBatches++;
+              for (auto& event : batch)
+                  events.add({ event.toMidiMessage(), event.isTruncated });
+          })
+        .disposedBy(disposeBag);
+
+    const uint8 sysEx[] = { 0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7 };
+
+    IT("emits the events of a MidiBuffer as one batch, with sample times")
+    {
+        MidiBuffer buffer;
+        buffer.addEvent(MidiMessage::noteOn(1, 60, uint8(100)), 10);
+        buffer.addEvent(MidiMessage::noteOff(1, 60), 20);
+        buffer.addEvent(MidiMessage(sysEx, static_cast<int>(sizeof(sysEx))), 30);
+        CHECK(source.write(buffer, 1000));
+        CHECK(events.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(events.size() == 3);
+
+        CHECK(numBatches == 1);
+        CHECK(events[0].message.isNoteOn());
+        CHECK(events[0].message.getTimeStamp() == 1010);
+        CHECK(events[1].message.isNoteOff());
+        CHECK(events[1].message.getTimeStamp() == 1020);
+        CHECK(events[2].message.isSysEx());
+        CHECK(events[2].message.getRawDataSize() == static_cast<int>(sizeof(sysEx)));
+        REQUIRE(events[2].message.getTimeStamp() == 1030);
+    }
+
+    IT("drops oversized events with OversizedEventPolicy::Drop")
+    {
+        const std::vector<uint8> largeSysEx(64, 0x01);
+        CHECK_FALSE(source.write(largeSysEx.data(), static_cast<int>(largeSysEx.size()), 0));
+        CHECK(source.write(MidiMessage::noteOn(1, 64, uint8(1)).getRawData(), 3, 5));
+
+        ReaX_RunDispatchLoopUntil(!events.isEmpty());
+        ReaX_RunDispatchLoop(10);
+
+        CHECK(source.getNumDroppedEvents() == 1);
+        CHECK(events.size() == 1);
+        REQUIRE(events[0].message.getNoteNumber() == 64);
+    }
+
+    IT("drops new events if the ring is full")
+    {
+        const uint8 noteOn[] = { 0x90, 60, 100 };
+        int numWritten = 0;
+        while (source.write(noteOn, 3, numWritten))
+            numWritten++;
+
+        CHECK(source.getNumDroppedEvents() == 1);
+        ReaX_RunDispatchLoopUntil(events.size() == numWritten);
+
+        // There's space again after emitting
+        REQUIRE(source.write(noteOn, 3, 0));
+    }
+
+    IT("passes events from another thread in order, across the end of the ring")
+    {
+        const int numEvents = 2000;
+        std::thread producer([&source]() {
+            for (int i = 0; i < numEvents; ++i) {
+                const uint8 controller[] = { 0xB0, 1, static_cast<uint8>(i % 128) };
+                while (!source.write(controller, 3, i))
+                    Thread::sleep(1);
+            }
+        });
+
+        ReaX_RunDispatchLoopUntil(events.size() == numEvents);
+        producer.join();
+
+        bool allInOrder = true;
+        for (int i = 0; i < numEvents; ++i)
+            allInOrder = allInOrder && events[i].message.getTimeStamp() == i && events[i].message.getControllerValue() == i % 128;
+
+        REQUIRE(allInOrder);
+    }
+}
+
+TEST_CASE("MidiEventSource with OversizedEventPolicy::Truncate",
+          "[MidiEventSource]")
+{
+    MidiEventSource source(1024, 4, OversizedEventPolicy::Truncate);
+    Array<int> sizes;
+    Array<bool> truncated;
+    DisposeBag disposeBag;
+    source.subscribe([&](const Span<MidiEventView>& batch) {
+              for (auto& event : batch) {
+                  sizes.add(event.numBytes);
+                  truncated.add(event.isTruncated);
+              }
+          })
+        .disposedBy(disposeBag);
+
+    IT("truncates oversized events")
+    {
+        const uint8 sysEx[] = { 0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7 };
+        CHECK(source.write(sysEx, static_cast<int>(sizeof(sysEx)), 0));
+        ReaX_RunDispatchLoopUntil(!sizes.isEmpty());
+
+        ReaX_CheckValues(sizes, 4);
+        ReaX_RequireValues(truncated, true);
+    }
+}
@@ -222,6 +222,98 @@ TEST_CASE("Observable::from",
 
         ReaX_RequireValues(values, "Hello", "Test");
     }
+
+    IT("emits the values again for each subscription")
+    {
+        auto observable = Observable<int>::from({ 1, 2 });
+        Array<int> first;
+        Array<int> second;
+        ReaX_CollectValues(observable, first);
+        ReaX_CollectValues(observable, second);
+
+        ReaX_CheckValues(first, 1, 2);
+        ReaX_RequireValues(second, 1, 2);
+    }
+}
+
+
+TEST_CASE("Observable::fromGenerator",
+          "[Observable][Observable::fromGenerator]")
+{
+    int numCalls = 0;
+    const auto countTo3 = Observable<int>::fromGenerator([&numCalls](int& next) -> bool {
+        ++numCalls;
+        if (numCalls > 3)
+            return false;
+
+        next = numCalls;
+        return true;
+    });
+
+    IT("emits the generated values and completes")
+    {
+        Array<int> values;
+        bool completed = false;
+        countTo3.subscribe([&values](int value) { values.add(value); }, [](std::exception_ptr) {}, [&completed]() { completed = true; });
+
+        CHECK(completed);
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("produces the next value only after the previous one has been processed")
+    {
+        Array<int> callsWhenReceived;
+        ReaX_CollectValues(countTo3.map([&numCalls](int) { return numCalls; }), callsWhenReceived);
+
+        ReaX_RequireValues(callsWhenReceived, 1, 2, 3);
+    }
+
+    IT("stops calling the generator when the subscriber unsubscribes")
+    {
+        int counter = 0;
+        const auto endless = Observable<int>::fromGenerator([&counter](int& next) -> bool {
+            next = ++counter;
+            return true;
+        });
+
+        Array<int> values;
+        ReaX_CollectValues(endless.take(3), values);
+
+        CHECK(counter == 3);
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("starts from the beginning for each subscription, if the state is captured by value")
+    {
+        int current = 0;
+        const auto observable = Observable<int>::fromGenerator([current](int& next) mutable -> bool {
+            if (current == 2)
+                return false;
+
+            next = ++current;
+            return true;
+        });
+
+        Array<int> first;
+        Array<int> second;
+        ReaX_CollectValues(observable, first);
+        ReaX_CollectValues(observable, second);
+
+        ReaX_CheckValues(first, 1, 2);
+        ReaX_RequireValues(second, 1, 2);
+    }
+
+    IT("notifies onError if the generator throws")
+    {
+        const auto failing = Observable<int>::fromGenerator([](int&) -> bool {
+            throw std::runtime_error("Generator failed.");
+        });
+
+        bool onErrorCalled = false;
+        failing.subscribe([](int) {}, [&onErrorCalled](std::exception_ptr) { onErrorCalled = true; });
+
+        REQUIRE(onErrorCalled);
+    }
 }
 
 
@@ -1,5 +1,7 @@
 #include "../../Other/TestPrefix.h"
 
+#include <thread>
+
 
 template<typename T, typename... Ts>
 String concatStrings(T t, Ts... ts)
@@ -13,6 +15,90 @@ String concatStrings<String>(String s)
     return s;
 }
 
+TEST_CASE("Observable::buffer",
+          "[Observable][Observable::buffer]")
+{
+    Array<Array<int>> values;
+
+    IT("emits chunks of values, and the remaining values on completion")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 7).buffer(3), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2, 3 }), Array<int>({ 4, 5, 6 }), Array<int>({ 7 }));
+    }
+
+    IT("doesn't emit an empty chunk on completion")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 4).buffer(2), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3, 4 }));
+    }
+
+    IT("emits overlapping chunks")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 4).buffer(2, 1), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 2, 3 }), Array<int>({ 3, 4 }), Array<int>({ 4 }));
+    }
+
+    IT("emits chunks of a subject, for each subscription separately")
+    {
+        PublishSubject<int> subject;
+        Array<Array<int>> otherValues;
+        ReaX_CollectValues(subject.buffer(2), values);
+        subject.onNext(1);
+        ReaX_CollectValues(subject.buffer(2), otherValues);
+        subject.onNext(2);
+        subject.onNext(3);
+
+        ReaX_CheckValues(values, Array<int>({ 1, 2 }));
+        ReaX_RequireValues(otherValues, Array<int>({ 2, 3 }));
+    }
+}
+
+
+TEST_CASE("Observable::bufferWithTime",
+          "[Observable][Observable::bufferWithTime]")
+{
+    const auto scheduler = Scheduler::virtualTime();
+    PublishSubject<int> subject;
+    Array<Array<int>> values;
+
+    IT("emits the values of each span")
+    {
+        ReaX_CollectValues(subject.bufferWithTime(RelativeTime::seconds(1), scheduler), values);
+        scheduler.advanceBy(RelativeTime());
+
+        subject.onNext(1);
+        subject.onNext(2);
+        scheduler.advanceBy(RelativeTime::seconds(1));
+        ReaX_CheckValues(values, Array<int>({ 1, 2 }));
+
+        subject.onNext(3);
+        scheduler.advanceBy(RelativeTime::seconds(1));
+        scheduler.advanceBy(RelativeTime::seconds(1));
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3 }), Array<int>());
+    }
+
+    IT("emits early if a chunk is full")
+    {
+        ReaX_CollectValues(subject.bufferWithTimeOrCount(RelativeTime::seconds(1), 2, scheduler), values);
+        scheduler.advanceBy(RelativeTime());
+
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onNext(3);
+        scheduler.advanceBy(RelativeTime::milliseconds(1));
+        ReaX_CheckValues(values, Array<int>({ 1, 2 }));
+
+        scheduler.advanceBy(RelativeTime::seconds(1));
+
+        ReaX_RequireValues(values, Array<int>({ 1, 2 }), Array<int>({ 3 }));
+    }
+}
+
+
 TEST_CASE("Observable::combineLatest",
           "[Observable][Observable::combineLatest]")
 {
@@ -88,6 +174,170 @@ TEST_CASE("Observable::combineLatest",
                          std::make_tuple(true, "World", 5),
                          std::make_tuple(true, "World", 6));
     }
+
+    CONTEXT("glitch-free propagation")
+    {
+        BehaviorSubject<int> source(1);
+        const auto doubled = source.map([](int i) { return i * 2; });
+        const auto tripled = source.map([](int i) { return i * 3; });
+
+        IT("pairs a new value with a stale one with immediate propagation")
+        {
+            Array<std::tuple<int, int>> values;
+            ReaX_CollectValues(doubled.combineLatest(tripled), values);
+
+            source.onNext(2);
+
+            ReaX_RequireValues(values, std::make_tuple(2, 3), std::make_tuple(4, 3), std::make_tuple(4, 6));
+        }
+
+        IT("emits once per source value, after all dependencies have been updated")
+        {
+            Array<std::tuple<int, int>> values;
+            ReaX_CollectValues(doubled.combineLatest(Propagation::GlitchFree, tripled), values);
+
+            source.onNext(2);
+            source.onNext(3);
+
+            ReaX_RequireValues(values, std::make_tuple(2, 3), std::make_tuple(4, 6), std::make_tuple(6, 9));
+        }
+
+        IT("calls the function once per source value")
+        {
+            int numCalls = 0;
+            Array<int> values;
+            ReaX_CollectValues(doubled.combineLatest(Propagation::GlitchFree, [&numCalls](int a, int b) { ++numCalls; return a + b; }, tripled), values);
+
+            source.onNext(2);
+
+            CHECK(numCalls == 2);
+            ReaX_RequireValues(values, 5, 10);
+        }
+
+        IT("settles nested combinations in dependency order")
+        {
+            const auto inner = doubled.combineLatest(Propagation::GlitchFree, [](int a, int b) { return a + b; }, tripled);
+
+            Array<std::tuple<int, int>> values;
+            ReaX_CollectValues(source.combineLatest(Propagation::GlitchFree, inner), values);
+
+            source.onNext(2);
+
+            ReaX_RequireValues(values, std::make_tuple(1, 5), std::make_tuple(2, 10));
+        }
+
+        IT("emits once for all changes of a Transaction")
+        {
+            BehaviorSubject<int> other(10);
+            Array<int> values;
+            ReaX_CollectValues(source.combineLatest(Propagation::GlitchFree, [](int a, int b) { return a + b; }, other), values);
+
+            {
+                Transaction transaction;
+                source.onNext(2);
+                other.onNext(20);
+            }
+
+            ReaX_RequireValues(values, 11, 22);
+        }
+
+        IT("works with an Array of Observables")
+        {
+            Array<Array<int>> arrays;
+            ReaX_CollectValues(Observable<int>::combineLatest({ doubled, tripled }, Propagation::GlitchFree), arrays);
+
+            source.onNext(2);
+
+            ReaX_RequireValues(arrays, Array<int>({ 2, 3 }), Array<int>({ 4, 6 }));
+        }
+
+        IT("emits values that don't come from an Observer immediately")
+        {
+            const auto range = Observable<int>::range(1, 3);
+            Array<std::tuple<int, int>> values;
+            ReaX_CollectValues(range.combineLatest(Propagation::GlitchFree, Observable<int>::just(0)), values);
+
+            ReaX_RequireValues(values, std::make_tuple(3, 0));
+        }
+
+        IT("keeps settling after a settling subscriber throws")
+        {
+            const auto sum = doubled.combineLatest(Propagation::GlitchFree, [](int a, int b) { return a + b; }, tripled);
+            DisposeBag disposeBag;
+            sum.subscribe([](int value) {
+                   if (value == 10)
+                       throw std::runtime_error("Settling failed.");
+               },
+                          [](std::exception_ptr) {})
+                .disposedBy(disposeBag);
+
+            Array<int> values;
+            ReaX_CollectValues(sum, values);
+
+            source.onNext(2);
+            source.onNext(3);
+
+            ReaX_RequireValues(values, 5, 10, 15);
+        }
+
+        IT("runs the remaining settle callbacks if one throws, and rethrows the exception")
+        {
+            Array<int> settled;
+
+            {
+                detail::PropagationWave wave;
+                detail::PropagationWave::settleLater(1, [&settled]() {
+                    settled.add(1);
+                    throw std::runtime_error("Settling failed.");
+                });
+                detail::PropagationWave::settleLater(2, [&settled]() { settled.add(2); });
+
+                REQUIRE_THROWS_WITH(wave.settle(), "Settling failed.");
+            }
+
+            CHECK_FALSE(detail::PropagationWave::isActive());
+            ReaX_RequireValues(settled, 1, 2);
+        }
+    }
+
+    CONTEXT("Array of Observables")
+    {
+        IT("combines the latest values of many Observables into an Array")
+        {
+            Array<PublishSubject<int>> subjects;
+            Array<Observable<int>> observables;
+            for (int i = 0; i < 32; ++i) {
+                subjects.add(PublishSubject<int>());
+                observables.add(subjects.getLast());
+            }
+
+            Array<Array<int>> arrays;
+            ReaX_CollectValues(Observable<int>::combineLatest(observables), arrays);
+
+            for (int i = 0; i < 32; ++i) {
+                CHECK(arrays.isEmpty());
+                subjects[i].onNext(i);
+            }
+
+            REQUIRE(arrays.size() == 1);
+            REQUIRE(arrays[0].size() == 32);
+            REQUIRE(arrays[0][31] == 31);
+
+            subjects[3].onNext(100);
+            REQUIRE(arrays.size() == 2);
+            REQUIRE(arrays[1][3] == 100);
+            REQUIRE(arrays[1][2] == 2);
+        }
+
+        IT("completes immediately for an empty Array")
+        {
+            bool completed = false;
+            DisposeBag disposeBag;
+            Observable<int>::combineLatest(Array<Observable<int>>()).subscribe([](const Array<int>&) {}, [](std::exception_ptr) {}, [&completed]() { completed = true; }).disposedBy(disposeBag);
+
+            REQUIRE(completed);
+        }
+    }
 }
 
 
@@ -145,6 +395,85 @@ TEST_CASE("Observable::distinctUntilChanged",
 
         ReaX_RequireValues(values, Point<int>(27, 12), Point<int>(27, 14));
     }
+
+    IT("doesn't emit consecutive duplicate doubles")
+    {
+        Array<double> values;
+        PublishSubject<double> subject;
+        ReaX_CollectValues(subject.distinctUntilChanged(), values);
+
+        subject.onNext(0.5);
+        subject.onNext(0.5);
+        subject.onNext(0.75);
+        subject.onNext(0.5);
+
+        ReaX_RequireValues(values, 0.5, 0.75, 0.5);
+    }
+
+    IT("keeps separate state for each subscription")
+    {
+        auto observable = Observable<int>::from({ 1, 1, 2 }).distinctUntilChanged();
+        Array<int> first;
+        Array<int> second;
+        ReaX_CollectValues(observable, first);
+        ReaX_CollectValues(observable, second);
+
+        ReaX_RequireValues(first, 1, 2);
+        ReaX_RequireValues(second, 1, 2);
+    }
+
+    IT("suppresses values within a tolerance")
+    {
+        Array<double> values;
+        PublishSubject<double> subject;
+        ReaX_CollectValues(subject.distinctUntilChanged(0.05), values);
+
+        subject.onNext(1.0);
+        subject.onNext(1.001);
+        subject.onNext(1.04);
+        subject.onNext(1.2);
+        subject.onNext(1.1);
+        subject.onNext(1.1);
+
+        ReaX_RequireValues(values, 1.0, 1.2, 1.1);
+    }
+
+    IT("compares to the last emitted value when using a tolerance")
+    {
+        Array<int> values;
+        ReaX_CollectValues(Observable<int>::from({ 0, 1, 2, 3, 4, 5 }).distinctUntilChanged(2), values);
+
+        ReaX_RequireValues(values, 0, 3);
+    }
+
+    IT("doesn't wrap around for unsigned values when using a tolerance")
+    {
+        Array<unsigned int> values;
+        ReaX_CollectValues(Observable<unsigned int>::from({ 10u, 9u, 5u, 6u }).distinctUntilChanged(2u), values);
+
+        ReaX_RequireValues(values, 10u, 5u);
+    }
+
+    IT("treats comparisons with NaN as different when using a tolerance")
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        Array<double> values;
+        ReaX_CollectValues(Observable<double>::from({ nan, 1.0, 1.01, nan, 2.0 }).distinctUntilChanged(0.05), values);
+
+        REQUIRE(values.size() == 4);
+        REQUIRE(std::isnan(values[0]));
+        REQUIRE(values[1] == 1.0);
+        REQUIRE(std::isnan(values[2]));
+        REQUIRE(values[3] == 2.0);
+    }
+
+    IT("emits quantized values")
+    {
+        Array<float> values;
+        ReaX_CollectValues(Observable<float>::from({ 0.12f, 0.14f, 0.26f, 0.24f, 0.31f, 0.9f }).distinctUntilChangedQuantized(0.25f), values);
+
+        ReaX_RequireValues(values, 0.f, 0.25f, 1.f);
+    }
 }
 
 
@@ -301,6 +630,56 @@ TEST_CASE("Interaction between Observable::map and Observable::switchOnNext",
 }
 
 
+TEST_CASE("Interaction between Observable::map and Observable::filter",
+          "[Observable][Observable::map][Observable::filter]")
+{
+    auto source = Observable<int>::range(1, 10);
+
+    IT("applies consecutive operators in order")
+    {
+        Array<String> values;
+        auto o = source.map([](int i) { return i * 2; }).filter([](int i) { return i % 3 == 0; }).map([](int i) { return String(i) + "!"; });
+        ReaX_CollectValues(o, values);
+
+        ReaX_RequireValues(values, "6!", "12!", "18!");
+    }
+
+    IT("doesn't change an Observable when applying operators to it")
+    {
+        auto mapped = source.map([](int i) { return i * 10; });
+        auto filtered = mapped.filter([](int i) { return i > 80; });
+        auto mappedTwice = mapped.map([](int i) { return i + 1; });
+
+        Array<int> mappedValues, filteredValues, mappedTwiceValues;
+        ReaX_CollectValues(mapped, mappedValues);
+        ReaX_CollectValues(filtered, filteredValues);
+        ReaX_CollectValues(mappedTwice.take(2), mappedTwiceValues);
+
+        ReaX_CheckValues(mappedValues, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100);
+        ReaX_CheckValues(filteredValues, 90, 100);
+        ReaX_RequireValues(mappedTwiceValues, 11, 21);
+    }
+
+    IT("notifies onError if a function throws")
+    {
+        Array<int> values;
+        bool failed = false;
+        DisposeBag disposeBag;
+        source.map([](int i) { return i * 2; }).map([](int i) {
+                  if (i > 4)
+                      throw std::runtime_error("Too large");
+
+                  return i;
+              })
+            .subscribe([&](int i) { values.add(i); }, [&](std::exception_ptr) { failed = true; })
+            .disposedBy(disposeBag);
+
+        CHECK(failed);
+        ReaX_RequireValues(values, 2, 4);
+    }
+}
+
+
 TEST_CASE("Observable::merge",
           "[Observable][Observable::merge]")
 {
@@ -319,6 +698,18 @@ TEST_CASE("Observable::merge",
         CHECK(values.size() == 44);
         ReaX_RequireValues(values, 0, 1, -1, 0, 1, -2, -1, 0, 1, -3, -2, -1, 0, 1, -4, -3, -2, -1, 0, 1, -5, -4, -3, -2, -1, 0, 1, -6, -5, -4, -3, -2, -1, 0, 1, -7, -6, -5, -4, -3, -2, -1, 0, 1);
     }
+
+    IT("merges an Array of Observables")
+    {
+        Array<Observable<int>> os;
+        for (int i = 0; i < 16; ++i)
+            os.add(Observable<int>::just(i));
+
+        ReaX_CollectValues(Observable<int>::merge(os), values);
+
+        REQUIRE(values.size() == 16);
+        REQUIRE(values.getLast() == 15);
+    }
 }
 
 
@@ -340,6 +731,56 @@ TEST_CASE("Observable::reduce",
 }
 
 
+TEST_CASE("Observable::sampleOnFrame",
+          "[Observable][Observable::sampleOnFrame]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+    ReaX_CollectValues(subject.sampleOnFrame(), values);
+
+    IT("emits only the latest value per frame")
+    {
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onNext(3);
+        CHECK(values.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        ReaX_RunDispatchLoop(50);
+        ReaX_RequireValues(values, 3);
+    }
+
+    IT("doesn't emit anything if there's no new value")
+    {
+        subject.onNext(17);
+        ReaX_RunDispatchLoopUntil(values.size() == 1);
+
+        ReaX_RunDispatchLoop(50);
+        ReaX_RequireValues(values, 17);
+    }
+
+    IT("emits the latest value from another thread on the message thread")
+    {
+        bool calledOnMessageThread = false;
+        DisposeBag disposeBag;
+        subject.sampleOnFrame().subscribe([&](int) {
+                                   calledOnMessageThread = MessageManager::getInstance()->isThisTheMessageThread();
+                               })
+            .disposedBy(disposeBag);
+
+        std::thread producer([&subject]() {
+            for (int i = 0; i < 100; ++i)
+                subject.onNext(i);
+        });
+        producer.join();
+
+        ReaX_RunDispatchLoopUntil(values.contains(99));
+        REQUIRE(values.size() < 100);
+        REQUIRE(calledOnMessageThread);
+    }
+}
+
+
 TEST_CASE("Observable::scan",
           "[Observable][Observable::scan]")
 {
@@ -491,6 +932,81 @@ TEST_CASE("Observable::takeWhile",
 }
 
 
+TEST_CASE("Observable::typed",
+          "[Observable][Observable::typed]")
+{
+    Array<String> values;
+
+    IT("applies map, filter and scan")
+    {
+        auto o = Observable<int>::range(1, 6)
+                     .typed()
+                     .filter([](int i) { return i % 2 == 0; })
+                     .map([](int i) { return i * 1.5; })
+                     .scan(0.0, [](double accum, double d) { return accum + d; })
+                     .map([](double d) { return String(d); });
+        ReaX_CollectValues(o.asObservable(), values);
+
+        ReaX_RequireValues(values, "3", "9", "18");
+    }
+
+    IT("converts to an Observable implicitly")
+    {
+        PublishSubject<int> subject;
+        Observable<String> o = subject.typed().map([](int i) { return String(i) + "!"; });
+        ReaX_CollectValues(o, values);
+
+        subject.onNext(3);
+        subject.onNext(17);
+
+        ReaX_RequireValues(values, "3!", "17!");
+    }
+
+    IT("doesn't share the scan state between subscriptions")
+    {
+        auto pipeline = Observable<int>::from({ 1, 2, 3 }).typed().scan(10, [](int accum, int i) { return accum + i; });
+        Array<int> first, second;
+        ReaX_CollectValues(pipeline.asObservable(), first);
+        ReaX_CollectValues(pipeline.asObservable(), second);
+
+        ReaX_CheckValues(first, 11, 13, 16);
+        ReaX_RequireValues(second, 11, 13, 16);
+    }
+
+    IT("subscribes without boxing the values")
+    {
+        Array<double> doubles;
+        ReaX_CollectValues(Observable<int>::from({ 4, 5 }).typed().map([](int i) { return i / 2.0; }), doubles);
+
+        ReaX_RequireValues(doubles, 2.0, 2.5);
+    }
+}
+
+
+TEST_CASE("Observable::window",
+          "[Observable][Observable::window]")
+{
+    Array<Array<int>> values;
+
+    IT("emits the latest values for each value")
+    {
+        ReaX_CollectValues(Observable<int>::range(1, 4).window(3), values);
+
+        ReaX_RequireValues(values, Array<int>({ 1 }), Array<int>({ 1, 2 }), Array<int>({ 1, 2, 3 }), Array<int>({ 2, 3, 4 }));
+    }
+
+    IT("starts with an empty window for each subscription")
+    {
+        const auto observable = Observable<int>::range(1, 2).window(2);
+        Array<Array<int>> otherValues;
+        ReaX_CollectValues(observable, values);
+        ReaX_CollectValues(observable, otherValues);
+
+        ReaX_RequireValues(otherValues, Array<int>({ 1 }), Array<int>({ 1, 2 }));
+    }
+}
+
+
 TEST_CASE("Observable::withLatestFrom",
           "[Observable][Observable::withLatestFrom]")
 {
@@ -509,6 +1025,30 @@ TEST_CASE("Observable::withLatestFrom",
 
         ReaX_RequireValues(values, "Hello World!");
     }
+
+    IT("combines with the updated values of dependent Observables, with glitch-free propagation")
+    {
+        BehaviorSubject<int> source(1);
+        const auto tripled = source.map([](int i) { return i * 3; });
+        Array<std::tuple<int, int>> values;
+        ReaX_CollectValues(source.withLatestFrom(Propagation::GlitchFree, tripled), values);
+
+        source.onNext(2);
+
+        ReaX_RequireValues(values, std::make_tuple(2, 6));
+    }
+
+    IT("doesn't emit with glitch-free propagation before the others have a value")
+    {
+        const auto f = concatStrings<String, String>;
+        ReaX_CollectValues(s1.withLatestFrom(Propagation::GlitchFree, f, s2), values);
+        s1.onNext("Dropped ");
+        s2.onNext("World!");
+        CHECK(values.isEmpty());
+        s1.onNext("Hello ");
+
+        ReaX_RequireValues(values, "Hello World!");
+    }
 }
 
 
@@ -544,4 +1084,18 @@ TEST_CASE("Observable::zip",
         strings.onNext("x");
         ReaX_RequireValues(values, "s=a; i=1; d=0.1", "s=x; i=57; d=0.25");
     }
+
+    IT("zips an Array of Observables")
+    {
+        Array<Observable<int>> os;
+        for (int i = 0; i < 10; ++i)
+            os.add(Observable<int>::range(i * 10, i * 10 + 2));
+
+        Array<Array<int>> arrays;
+        ReaX_CollectValues(Observable<int>::zip(os), arrays);
+
+        REQUIRE(arrays.size() == 3);
+        REQUIRE(arrays[0] == Array<int>({ 0, 10, 20, 30, 40, 50, 60, 70, 80, 90 }));
+        REQUIRE(arrays[2][9] == 92);
+    }
 }
@@ -1,5 +1,7 @@
 #include "../../Other/TestPrefix.h"
 
+#include <thread>
+
 
 TEST_CASE("Observable::observeOn",
           "[Observable][Observable::observeOn]")
@@ -64,4 +66,514 @@ TEST_CASE("Observable::observeOn",
 
         ReaX_RequireValues(values, 2, 4, 6);
     }
+
+    IT("delivers values to the message thread without waiting for a polling interval")
+    {
+        auto onMessageThread = observable.observeOn(Scheduler::messageThread());
+        ReaX_CollectValues(onMessageThread, values);
+
+        // A single pass of the dispatch loop should be enough to deliver the values
+        ReaX_RunDispatchLoop(1);
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("doesn't wait for the message thread when scheduling from another thread")
+    {
+        DisposeBag disposeBag;
+
+        // The message thread is blocked in join(), so this would deadlock if observeOn waited for it
+        std::thread thread([&]() {
+            observable.observeOn(Scheduler::messageThread()).subscribe([&](int i) {
+                CHECK(MessageManager::getInstance()->isThisTheMessageThread());
+                values.add(i);
+            }).disposedBy(disposeBag);
+        });
+        thread.join();
+
+        CHECK(values.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("can schedule to the message thread, aligned to display frames")
+    {
+        auto onMessageThread = observable.observeOn(Scheduler::messageThreadFrameAligned()).map([](int i) {
+            CHECK(MessageManager::getInstance()->isThisTheMessageThread());
+            return i * 2;
+        });
+        ReaX_CollectValues(onMessageThread, values);
+
+        CHECK(values.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RequireValues(values, 2, 4, 6);
+    }
+
+    IT("can schedule to a thread pool, keeping the order of values")
+    {
+        const auto pool = Scheduler::threadPool(2);
+        const auto range = Observable<int>::range(1, 100);
+        Array<Thread::ThreadID> threadIDs;
+        CriticalSection lock;
+
+        const auto onPool = [&](const Observable<int>& source) {
+            return source.observeOn(pool).map([&](int i) {
+                const ScopedLock sl(lock);
+                threadIDs.addIfNotAlreadyThere(Thread::getCurrentThreadId());
+                return i;
+            });
+        };
+
+        const auto first = onPool(range).toArray();
+        const auto second = onPool(range).toArray();
+
+        Array<int> expected;
+        for (int i = 1; i <= 100; ++i)
+            expected.add(i);
+
+        REQUIRE(first == expected);
+        REQUIRE(second == expected);
+
+        // Subsequent subscriptions are assigned to different threads
+        REQUIRE(threadIDs.size() == 2);
+        REQUIRE(!threadIDs.contains(Thread::getCurrentThreadId()));
+    }
+
+    IT("can schedule to a thread pool with ThreadOptions")
+    {
+        const auto options = Scheduler::ThreadOptions().withName("Test Pool").withNumThreads(2).withPriority(2);
+        CHECK(options.name == "Test Pool");
+        CHECK(options.numThreads == 2);
+        CHECK(options.priority == 2);
+        CHECK(options.affinityMask == 0);
+
+        const auto pool = Scheduler::threadPool(options);
+        SortedSet<Thread::ThreadID> threadIDs;
+        CriticalSection lock;
+        const auto onPool = Observable<int>::range(1, 10).observeOn(pool).map([&](int i) {
+            const ScopedLock scopedLock(lock);
+            threadIDs.add(Thread::getCurrentThreadId());
+            return i;
+        });
+
+        CHECK(onPool.toArray() == Array<int>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }));
+        CHECK(onPool.toArray().size() == 10);
+
+        REQUIRE(threadIDs.size() == 2);
+        REQUIRE(!threadIDs.contains(Thread::getCurrentThreadId()));
+    }
+
+    IT("can schedule to the audio thread, which drains the scheduled work")
+    {
+        const AudioThreadScheduler scheduler;
+        auto onAudioThread = observable.observeOn(scheduler);
+        ReaX_CollectValues(onAudioThread, values);
+
+        // Nothing happens until the audio thread drains
+        ReaX_RunDispatchLoop(5);
+        CHECK(values.isEmpty());
+
+        Thread::ThreadID audioThreadID = nullptr;
+        std::thread audioThread([&]() {
+            audioThreadID = Thread::getCurrentThreadId();
+            scheduler.drain();
+        });
+        audioThread.join();
+
+        ReaX_RequireValues(values, 1, 2, 3);
+        REQUIRE(audioThreadID != Thread::getCurrentThreadId());
+    }
+
+    IT("only drains the work of the audio thread scheduler that it's called on")
+    {
+        const AudioThreadScheduler first;
+        const AudioThreadScheduler second;
+        auto onFirst = observable.observeOn(first);
+        auto onSecond = observable.map([](int i) { return i * 10; }).observeOn(second);
+        Array<int> secondValues;
+        ReaX_CollectValues(onFirst, values);
+        ReaX_CollectValues(onSecond, secondValues);
+
+        second.drain();
+        CHECK(values.isEmpty());
+        ReaX_CheckValues(secondValues, 10, 20, 30);
+
+        first.drain();
+        ReaX_RequireValues(values, 1, 2, 3);
+        ReaX_RequireValues(secondValues, 10, 20, 30);
+    }
+}
+
+TEST_CASE("Observable::observeOn with a bounded buffer",
+          "[Observable][Observable::observeOn]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    // The values are pushed on the message thread, so they are all buffered before the first drain
+    const auto pushValues = [&subject]() {
+        for (int i = 1; i <= 10; ++i)
+            subject.onNext(i);
+    };
+
+    IT("drops the oldest values")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, CongestionPolicy::DropOldest), values);
+        pushValues();
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RunDispatchLoop(5);
+
+        ReaX_RequireValues(values, 8, 9, 10);
+    }
+
+    IT("drops the newest values")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, CongestionPolicy::DropNewest), values);
+        pushValues();
+        ReaX_RunDispatchLoopUntil(values.size() == 3);
+        ReaX_RunDispatchLoop(5);
+
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("delivers only the latest value with a capacity of 1")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 1, CongestionPolicy::DropOldest), values);
+        pushValues();
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        ReaX_RunDispatchLoop(5);
+
+        ReaX_RequireValues(values, 10);
+    }
+
+    IT("doesn't drop anything with CongestionPolicy::Allocate")
+    {
+        ReaX_CollectValues(subject.observeOn(Scheduler::messageThread(), 3, CongestionPolicy::Allocate), values);
+        pushValues();
+        ReaX_RunDispatchLoopUntil(values.size() == 10);
+
+        ReaX_RequireValues(values, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+    }
+
+    IT("delivers the completion after the buffered values, on the scheduler")
+    {
+        bool completed = false;
+        bool completedOnMessageThread = false;
+        subject.observeOn(Scheduler::messageThread(), 3, CongestionPolicy::DropOldest)
+            .subscribe([&](int value) { values.add(value); CHECK(!completed); },
+                       [](std::exception_ptr) {},
+                       [&]() {
+                           completed = true;
+                           completedOnMessageThread = MessageManager::getInstance()->isThisTheMessageThread();
+                       });
+
+        std::thread producer([&]() {
+            pushValues();
+            subject.onCompleted();
+        });
+        producer.join();
+
+        CHECK(!completed);
+        ReaX_RunDispatchLoopUntil(completed);
+
+        CHECK(completedOnMessageThread);
+        ReaX_RequireValues(values, 8, 9, 10);
+    }
+}
+
+
+TEST_CASE("Observable::observeOnLatest",
+          "[Observable][Observable::observeOnLatest]")
+{
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    IT("overwrites values that haven't been delivered yet")
+    {
+        ReaX_CollectValues(subject.observeOnLatest(Scheduler::messageThread()), values);
+
+        for (int i = 1; i <= 10; ++i)
+            subject.onNext(i);
+
+        ReaX_RunDispatchLoopUntil(!values.isEmpty());
+        ReaX_RunDispatchLoop(5);
+        ReaX_CheckValues(values, 10);
+
+        subject.onNext(11);
+        subject.onNext(12);
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+
+        ReaX_RequireValues(values, 10, 12);
+    }
+
+    IT("delivers a value that arrives while delivering")
+    {
+        auto observable = subject.observeOnLatest(Scheduler::messageThread());
+        observable.subscribe([&](int value) {
+                      values.add(value);
+                      if (value == 1)
+                          subject.onNext(2);
+                  });
+
+        subject.onNext(1);
+        ReaX_RunDispatchLoopUntil(values.size() == 2);
+
+        ReaX_RequireValues(values, 1, 2);
+    }
+
+    IT("delivers the completion after the pending value, on the scheduler")
+    {
+        bool completed = false;
+        bool completedOnMessageThread = false;
+        subject.observeOnLatest(Scheduler::messageThread())
+            .subscribe([&](int value) { values.add(value); },
+                       [](std::exception_ptr) {},
+                       [&]() {
+                           completed = true;
+                           completedOnMessageThread = MessageManager::getInstance()->isThisTheMessageThread();
+                       });
+
+        std::thread producer([&]() {
+            subject.onNext(1);
+            subject.onNext(2);
+            subject.onCompleted();
+        });
+        producer.join();
+
+        CHECK(!completed);
+        ReaX_RunDispatchLoopUntil(completed);
+
+        CHECK(completedOnMessageThread);
+        ReaX_RequireValues(values, 2);
+    }
+}
+
+
+TEST_CASE("Observable::parallelMap",
+          "[Observable][Observable::parallelMap]")
+{
+    const auto pool = Scheduler::threadPool(4);
+    const auto source = Observable<int>::range(1, 40);
+
+    IT("emits the results in source order, even if they finish out of order")
+    {
+        const auto results = source.parallelMap(pool, [](int i) {
+                                       // Later values finish earlier
+                                       Thread::sleep((40 - i) % 4);
+                                       return i * 2;
+                                   },
+                                               4)
+                                 .toArray();
+
+        REQUIRE(results.size() == 40);
+        for (int i = 0; i < 40; ++i)
+            REQUIRE(results[i] == (i + 1) * 2);
+    }
+
+    IT("doesn't evaluate more than maxConcurrency values at a time")
+    {
+        std::atomic<int> numRunning(0);
+        std::atomic<int> maxRunning(0);
+
+        const auto results = source.parallelMap(pool, [&](int i) {
+                                       const int running = ++numRunning;
+                                       if (running > maxRunning)
+                                           maxRunning = running;
+
+                                       Thread::sleep(1);
+                                       --numRunning;
+                                       return i;
+                                   },
+                                               2)
+                                 .toArray();
+
+        REQUIRE(results.size() == 40);
+        REQUIRE(maxRunning <= 2);
+    }
+
+    IT("notifies onError if the function throws")
+    {
+        std::exception_ptr error;
+        source.parallelMap(pool, [](int i) {
+                  if (i == 7)
+                      throw std::runtime_error("Error");
+
+                  return i;
+              })
+            .toArray([&](std::exception_ptr e) { error = e; });
+
+        REQUIRE(error != nullptr);
+    }
+
+    IT("allows subscribers to push values back into the source synchronously")
+    {
+        PublishSubject<int> subject;
+        std::atomic<int> lastValue(0);
+        const auto subscription = subject.parallelMap(pool, [](int i) { return i; }, 2).subscribe([&](int i) {
+            lastValue = i;
+
+            // Would deadlock if the result was emitted while holding the lock
+            if (i < 10)
+                subject.onNext(i + 1);
+        });
+
+        subject.onNext(1);
+        ReaX_RunDispatchLoopUntil(lastValue == 10);
+        subscription.unsubscribe();
+    }
+}
+
+
+TEST_CASE("Observable::toArrayAsync",
+          "[Observable][Observable::toArrayAsync]")
+{
+    IT("collects all values without blocking")
+    {
+        std::vector<int> values;
+        bool completed = false;
+        Observable<int>::range(1, 4).observeOn(Scheduler::newThread()).observeOn(Scheduler::messageThread()).toArrayAsync([&](std::vector<int>&& result) {
+            values = std::move(result);
+            completed = true;
+        });
+
+        CHECK(!completed);
+        ReaX_RunDispatchLoopUntil(completed);
+
+        REQUIRE(values == std::vector<int>({ 1, 2, 3, 4 }));
+    }
+
+    IT("notifies onError instead of onCompleted")
+    {
+        bool errorCalled = false;
+        bool completed = false;
+        Observable<int>::error(std::runtime_error("Error.")).toArrayAsync([&](std::vector<int>&&) { completed = true; }, [&](std::exception_ptr) { errorCalled = true; });
+
+        CHECK(!completed);
+        REQUIRE(errorCalled);
+    }
+
+    IT("stops collecting after unsubscribing")
+    {
+        PublishSubject<int> subject;
+        bool completed = false;
+        auto subscription = subject.toArrayAsync([&](std::vector<int>&&) { completed = true; });
+
+        subject.onNext(1);
+        subscription.unsubscribe();
+        subject.onCompleted();
+
+        REQUIRE(!completed);
+    }
+}
+
+
+TEST_CASE("Observable::toFuture",
+          "[Observable][Observable::toFuture]")
+{
+    IT("returns a future for all values")
+    {
+        auto future = Observable<String>::from({ "a", "b" }).observeOn(Scheduler::newThread()).toFuture();
+
+        REQUIRE(future.get() == std::vector<String>({ "a", "b" }));
+    }
+
+    IT("rethrows an error")
+    {
+        auto future = Observable<int>::error(std::runtime_error("Error.")).toFuture();
+
+        REQUIRE_THROWS(future.get());
+    }
+
+    IT("unsubscribes if the future is destroyed before it's ready")
+    {
+        PublishSubject<int> subject;
+        {
+            const auto future = subject.toFuture();
+            CHECK(subject.hasSubscribers());
+        }
+
+        REQUIRE(!subject.hasSubscribers());
+    }
+
+    IT("stays subscribed if the future is moved into a std::future")
+    {
+        PublishSubject<int> subject;
+        std::future<std::vector<int>> future = subject.toFuture();
+        subject.onNext(17);
+        subject.onCompleted();
+
+        REQUIRE(future.get() == std::vector<int>({ 17 }));
+    }
+}
+
+
+TEST_CASE("VirtualTimeScheduler",
+          "[Scheduler][VirtualTimeScheduler]")
+{
+    const auto scheduler = Scheduler::virtualTime();
+    PublishSubject<int> subject;
+    Array<int> values;
+
+    IT("only runs work when the clock is advanced")
+    {
+        ReaX_CollectValues(Observable<int>::just(17).observeOn(scheduler), values);
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime());
+
+        ReaX_RequireValues(values, 17);
+    }
+
+    IT("advances the clock")
+    {
+        CHECK(scheduler.getElapsedTime() == RelativeTime());
+
+        scheduler.advanceBy(RelativeTime::seconds(1.5));
+        CHECK(scheduler.getElapsedTime() == RelativeTime::seconds(1.5));
+
+        scheduler.advanceTo(RelativeTime::seconds(4));
+        REQUIRE(scheduler.getElapsedTime() == RelativeTime::seconds(4));
+    }
+
+    IT("drives Observable::interval")
+    {
+        ReaX_CollectValues(Observable<int>::interval(RelativeTime::seconds(1), scheduler), values);
+
+        scheduler.advanceBy(RelativeTime::seconds(2.5));
+        ReaX_CheckValues(values, 1, 2, 3);
+
+        scheduler.advanceBy(RelativeTime::seconds(1));
+        ReaX_RequireValues(values, 1, 2, 3, 4);
+    }
+
+    IT("drives Observable::debounce")
+    {
+        ReaX_CollectValues(subject.debounce(RelativeTime::seconds(1), scheduler), values);
+
+        subject.onNext(1);
+        scheduler.advanceBy(RelativeTime::seconds(0.5));
+        subject.onNext(2);
+        scheduler.advanceBy(RelativeTime::seconds(0.9));
+        CHECK(values.isEmpty());
+
+        scheduler.advanceBy(RelativeTime::seconds(0.2));
+        ReaX_RequireValues(values, 2);
+    }
+
+    IT("drives Observable::sample")
+    {
+        ReaX_CollectValues(subject.sample(RelativeTime::seconds(1), scheduler), values);
+
+        subject.onNext(1);
+        scheduler.advanceBy(RelativeTime::seconds(1));
+        ReaX_CheckValues(values, 1);
+
+        subject.onNext(2);
+        subject.onNext(3);
+        scheduler.advanceBy(RelativeTime::seconds(1));
+        scheduler.advanceBy(RelativeTime::seconds(1));
+
+        ReaX_RequireValues(values, 1, 3);
+    }
 }
@@ -74,6 +74,46 @@ TEST_CASE("Reactive<Component>",
             }
         }
     }
+
+    CONTEXT("frame coalescing")
+    {
+        component.rx.setFrameCoalescingEnabled(true);
+
+        IT("applies only the latest bounds on the next frame")
+        {
+            int numResizes = 0;
+            struct ResizeCounter : public ComponentListener
+            {
+                int& numResizes;
+                explicit ResizeCounter(int& numResizes) : numResizes(numResizes) {}
+                void componentMovedOrResized(Component&, bool, bool) override { numResizes++; }
+            } counter(numResizes);
+            component.addComponentListener(&counter);
+
+            component.rx.bounds.onNext(Rectangle<int>(1, 2, 3, 4));
+            component.rx.bounds.onNext(Rectangle<int>(5, 6, 7, 8));
+            component.rx.visible.onNext(true);
+
+            // Nothing is applied until the next frame
+            CHECK(component.getBounds() == Rectangle<int>());
+            CHECK(!component.isVisible());
+
+            ReaX_RunDispatchLoopUntil(component.getBounds() == Rectangle<int>(5, 6, 7, 8));
+            CHECK(component.isVisible());
+            CHECK(numResizes == 1);
+
+            component.removeComponentListener(&counter);
+        }
+
+        IT("applies pending values immediately when disabled")
+        {
+            component.rx.colour(Label::textColourId).onNext(Colours::red);
+            CHECK(component.findColour(Label::textColourId) != Colours::red);
+
+            component.rx.setFrameCoalescingEnabled(false);
+            REQUIRE(component.findColour(Label::textColourId) == Colours::red);
+        }
+    }
 }
 
 
@@ -248,6 +288,18 @@ TEST_CASE("Reactive<Button>",
                 }
             }
         }
+
+        IT("doesn't add a subscription when called again for the same colour id")
+        {
+            button.rx.colour(TextButton::buttonColourId);
+            const size_t numSubscriptions = button.rx.getNumSubscriptions();
+
+            for (int i = 0; i < 10; ++i)
+                button.rx.colour(TextButton::buttonColourId).onNext(Colours::red);
+
+            REQUIRE(button.rx.getNumSubscriptions() == numSubscriptions);
+            REQUIRE(button.findColour(TextButton::buttonColourId) == Colours::red);
+        }
     }
 }
 
@@ -427,6 +479,35 @@ TEST_CASE("Reactive<Label>",
 
             REQUIRE(label.getFont() == font2);
         }
+
+        IT("changes the Label font when subscribing to an Observable")
+        {
+            PublishSubject<Font> subject;
+            subject.subscribe(label.rx.font);
+
+            subject.onNext(font1);
+            CHECK(label.getFont() == font1);
+            subject.onNext(font2);
+
+            REQUIRE(label.getFont() == font2);
+        }
+
+        IT("can be passed as an Observer explicitly")
+        {
+            const Observer<Font> observer = label.rx.font.asObserver();
+            observer.onNext(font1);
+
+            REQUIRE(label.getFont() == font1);
+        }
+
+        IT("ignores values after onCompleted")
+        {
+            label.rx.font.onNext(font1);
+            label.rx.font.onCompleted();
+            label.rx.font.onNext(font2);
+
+            REQUIRE(label.getFont() == font1);
+        }
     }
 
     CONTEXT("justificationType")
@@ -670,6 +751,23 @@ TEST_CASE("Reactive<Slider>",
         REQUIRE(slider.getSkewFactor() == Approx(2.4094208397));
     }
 
+    IT("sets the skew factor directly")
+    {
+        CHECK(slider.getSkewFactor() == 1);
+        slider.rx.skewFactor.onNext(0.3);
+        REQUIRE(slider.getSkewFactor() == 0.3);
+    }
+
+    IT("sets a symmetric skew")
+    {
+        CHECK_FALSE(slider.isSymmetricSkew());
+        slider.rx.skewFactor.onNext(0.3);
+        slider.rx.symmetricSkew.onNext(true);
+
+        CHECK(slider.getSkewFactor() == 0.3);
+        REQUIRE(slider.isSymmetricSkew());
+    }
+
     IT("sets the interval")
     {
         CHECK(slider.getInterval() == 0.0);
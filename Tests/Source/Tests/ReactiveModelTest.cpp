@@ -1,5 +1,7 @@
 #include "../Other/TestPrefix.h"
 
+#include <thread>
+
 
 TEST_CASE("Reactive<Value> conversion",
           "[Reactive<Value>][ValueExtension]")
@@ -62,6 +64,60 @@ TEST_CASE("Reactive<Value> Observable",
 }
 
 
+TEST_CASE("Reactive<ValueTree>",
+          "[Reactive<ValueTree>][ValueTreeExtension]")
+{
+    Reactive<ValueTree> tree("Root");
+    ValueTree child("Child");
+    ValueTree grandchild("Grandchild");
+    tree.addChild(child, -1, nullptr);
+
+    IT("emits the tree whose observed property has changed, including descendants")
+    {
+        Array<ValueTree> values;
+        ReaX_CollectValues(tree.rx.propertyChanged("name"), values);
+
+        tree.setProperty("name", "Root Name", nullptr);
+        child.setProperty("name", "Child Name", nullptr);
+        child.setProperty("other", 42, nullptr);
+        child.removeProperty("name", nullptr);
+
+        ReaX_RequireValues(values, tree, child, child);
+    }
+
+    IT("emits added, removed and reordered children")
+    {
+        Array<ValueTreeExtension::ChildChange> added;
+        Array<ValueTreeExtension::ChildChange> removed;
+        Array<ValueTreeExtension::ChildOrderChange> reordered;
+        ReaX_CollectValues(tree.rx.childAdded, added);
+        ReaX_CollectValues(tree.rx.childRemoved, removed);
+        ReaX_CollectValues(tree.rx.childOrderChanged, reordered);
+
+        ValueTree second("Second");
+        tree.addChild(second, -1, nullptr);
+        child.addChild(grandchild, 0, nullptr);
+        tree.moveChild(1, 0, nullptr);
+        tree.removeChild(child, nullptr);
+
+        ReaX_CheckValues(added, ValueTreeExtension::ChildChange{ tree, second, 1 }, ValueTreeExtension::ChildChange{ child, grandchild, 0 });
+        ReaX_CheckValues(reordered, ValueTreeExtension::ChildOrderChange{ tree, 1, 0 });
+        ReaX_RequireValues(removed, ValueTreeExtension::ChildChange{ tree, child, 1 });
+    }
+
+    IT("notices changes made through another ValueTree that refers to the same data")
+    {
+        Array<ValueTree> values;
+        ReaX_CollectValues(tree.rx.propertyChanged("name"), values);
+
+        ValueTree other(tree);
+        other.setProperty("name", "Changed", nullptr);
+
+        ReaX_RequireValues(values, tree);
+    }
+}
+
+
 class DummyAudioProcessor : public Reactive<AudioProcessor>
 {
 public:
@@ -115,6 +171,77 @@ TEST_CASE("Reactive<AudioProcessor>",
         ReaX_RunDispatchLoopUntil(values.size() == 2);
         ReaX_RequireValues(values, Empty(), Empty());
     }
+    
+    IT("creates AudioBlockSources that live as long as the processor")
+    {
+        AudioBlockSource& blocks = processor.rx.audioBlocks(2, 1, 64);
+        Array<int> numSamples;
+        ReaX_CollectValues(blocks.map([](const AudioBlock& block) { return block.getBuffer().getNumSamples(); }), numSamples);
+
+        AudioBuffer<float> buffer(1, 32);
+        buffer.clear();
+        blocks.write(buffer);
+        ReaX_RunDispatchLoopUntil(!numSamples.isEmpty());
+
+        ReaX_RequireValues(numSamples, 32);
+    }
+}
+
+
+TEST_CASE("AudioThreadScheduler in an AudioProcessor",
+          "[Scheduler][AudioThreadScheduler]")
+{
+    // Owns its AudioThreadScheduler, and drains it at the top of processBlock, as documented
+    class GainProcessor : public DummyAudioProcessor
+    {
+    public:
+        explicit GainProcessor(const Observable<float>& gainValues)
+        {
+            gainValues.observeOn(audioThread).subscribe([this](float newGain) {
+                gain = newGain; // Called on the audio thread
+            }).disposedBy(disposeBag);
+        }
+
+        void processBlock(AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            audioThread.drain();
+            buffer.applyGain(gain);
+        }
+
+        float gain = 1.f;
+
+    private:
+        const AudioThreadScheduler audioThread;
+        DisposeBag disposeBag;
+    };
+
+    BehaviorSubject<float> gainValues(0.5f);
+    GainProcessor processor(gainValues);
+    AudioBuffer<float> buffer(1, 4);
+    MidiBuffer midi;
+
+    const auto processOnAudioThread = [&]() {
+        buffer.clear();
+        buffer.setSample(0, 0, 1.f);
+        std::thread audioThread([&]() { processor.processBlock(buffer, midi); });
+        audioThread.join();
+    };
+
+    IT("delivers the values on the audio thread when processBlock drains")
+    {
+        CHECK(processor.gain == 1.f);
+
+        processOnAudioThread();
+        REQUIRE(processor.gain == 0.5f);
+        REQUIRE(buffer.getSample(0, 0) == 0.5f);
+
+        gainValues.onNext(0.25f);
+        processOnAudioThread();
+        REQUIRE(buffer.getSample(0, 0) == 0.25f);
+
+        // Let the message thread release the delivered values
+        ReaX_RunDispatchLoop(20);
+    }
 }
 
 
@@ -190,3 +317,265 @@ TEST_CASE("Reactive<AudioProcessorValueTreeState>",
         }
     }
 }
+
+
+TEST_CASE("AudioProcessorValueTreeStateExtension::parameterObservable",
+          "[Reactive<AudioProcessorValueTreeState>][AudioProcessorValueTreeStateExtension]")
+{
+    DummyAudioProcessor processor;
+    Reactive<AudioProcessorValueTreeState> valueTreeState(processor, nullptr);
+    NormalisableRange<float> range(0, 10);
+    valueTreeState.createAndAddParameter("foo", "foo", "", range, 2.74f, nullptr, nullptr);
+    valueTreeState.createAndAddParameter("bar", "bar", "", range, 8.448f, nullptr, nullptr);
+    valueTreeState.state = ValueTree("Test");
+
+    Array<float> fooValues;
+    ReaX_CollectValues(valueTreeState.rx.parameterObservable("foo"), fooValues);
+
+    IT("emits the default value immediately")
+    {
+        ReaX_RequireValues(fooValues, 2.74f);
+    }
+
+    IT("emits asynchronously when setting a new value on the AudioProcessorParameter")
+    {
+        valueTreeState.getParameter("foo")->setValue(0.98f);
+        CHECK(fooValues.size() == 1);
+
+        ReaX_RunDispatchLoopUntil(fooValues.size() == 2);
+        REQUIRE(fooValues.getLast() == Approx(9.8f));
+    }
+
+    IT("only emits the latest value if the parameter changes several times in a row")
+    {
+        for (int i = 1; i <= 10; ++i)
+            valueTreeState.getParameter("foo")->setValue(i / 10.f);
+
+        ReaX_RunDispatchLoopUntil(fooValues.size() == 2);
+        ReaX_RunDispatchLoop(20);
+        REQUIRE(fooValues.size() == 2);
+        REQUIRE(fooValues.getLast() == Approx(10.f));
+    }
+
+    IT("does not emit when setting the value of a different parameter")
+    {
+        valueTreeState.getParameter("bar")->setValue(0.5f);
+        ReaX_RunDispatchLoop(20);
+
+        ReaX_RequireValues(fooValues, 2.74f);
+    }
+}
+
+
+TEST_CASE("AudioProcessorValueTreeStateExtension::prebindAll",
+          "[Reactive<AudioProcessorValueTreeState>][AudioProcessorValueTreeStateExtension]")
+{
+    DummyAudioProcessor processor;
+    Reactive<AudioProcessorValueTreeState> valueTreeState(processor, nullptr);
+    NormalisableRange<float> range(0, 10);
+    valueTreeState.createAndAddParameter("foo", "foo", "", range, 2.74f, nullptr, nullptr);
+    valueTreeState.state = ValueTree("Test");
+
+    valueTreeState.rx.prebindAll();
+
+    IT("returns the same subject for an Identifier and a string")
+    {
+        const Identifier foo("foo");
+        valueTreeState.rx.parameterValue(foo).onNext(5.f);
+
+        REQUIRE(valueTreeState.rx.parameterValue("foo").getValue() == var(5.f));
+    }
+
+    IT("emits the current value from a prebound parameterObservable")
+    {
+        Array<float> values;
+        ReaX_CollectValues(valueTreeState.rx.parameterObservable(Identifier("foo")), values);
+
+        ReaX_RequireValues(values, 2.74f);
+    }
+}
+
+
+TEST_CASE("AudioProcessorValueTreeStateExtension::changedParameters",
+          "[Reactive<AudioProcessorValueTreeState>][AudioProcessorValueTreeStateExtension]")
+{
+    DummyAudioProcessor processor;
+    Reactive<AudioProcessorValueTreeState> valueTreeState(processor, nullptr);
+    NormalisableRange<float> range(0, 10);
+    for (int i = 0; i < 40; ++i)
+        valueTreeState.createAndAddParameter("p" + String(i), "p" + String(i), "", range, 1.f, nullptr, nullptr);
+    valueTreeState.state = ValueTree("Test");
+
+    typedef AudioProcessorValueTreeStateExtension::ParameterChange ParameterChange;
+    Array<Array<ParameterChange>> batches;
+    DisposeBag disposeBag;
+    valueTreeState.rx.changedParameters().subscribe([&](const Span<ParameterChange>& changes) {
+                                             batches.add(changes.toArray());
+                                         })
+        .disposedBy(disposeBag);
+
+    // Let JUCE's asynchronous ValueTree initialization finish
+    ReaX_RunDispatchLoop(20);
+    batches.clear();
+
+    IT("emits all changed parameters as a single batch, with their latest values")
+    {
+        valueTreeState.getParameter("p3")->setValue(0.2f);
+        valueTreeState.getParameter("p35")->setValue(0.5f);
+        valueTreeState.getParameter("p3")->setValue(0.4f);
+        CHECK(batches.isEmpty());
+
+        ReaX_RunDispatchLoopUntil(!batches.isEmpty());
+        REQUIRE(batches.size() == 1);
+
+        const auto& batch = batches.getFirst();
+        REQUIRE(batch.size() == 2);
+        CHECK(batch[0].parameterIndex == 3);
+        CHECK(batch[0].parameterID == "p3");
+        CHECK(batch[0].value == Approx(4.f));
+        CHECK(batch[1].parameterIndex == 35);
+        CHECK(batch[1].parameterID == "p35");
+        REQUIRE(batch[1].value == Approx(5.f));
+    }
+
+    IT("doesn't emit if nothing has changed")
+    {
+        ReaX_RunDispatchLoop(20);
+        REQUIRE(batches.isEmpty());
+    }
+}
+
+
+TEST_CASE("ParameterAttachment",
+          "[ParameterAttachment]")
+{
+    // Counts the change gestures that are sent to the host
+    struct GestureCounter : public AudioProcessorListener
+    {
+        void audioProcessorParameterChanged(AudioProcessor*, int, float) override {}
+        void audioProcessorChanged(AudioProcessor*) override {}
+        void audioProcessorParameterChangeGestureBegin(AudioProcessor*, int) override { numBegins++; }
+        void audioProcessorParameterChangeGestureEnd(AudioProcessor*, int) override { numEnds++; }
+
+        int numBegins = 0;
+        int numEnds = 0;
+    };
+
+    DummyAudioProcessor processor;
+    Reactive<AudioProcessorValueTreeState> valueTreeState(processor, nullptr);
+    NormalisableRange<float> range(0, 10);
+    valueTreeState.createAndAddParameter("foo", "foo", "", range, 2.5f, nullptr, nullptr);
+    valueTreeState.createAndAddParameter("frequency", "frequency", "", NormalisableRange<float>(20, 20000, 0, 0.25f), 1000, nullptr, nullptr);
+    valueTreeState.state = ValueTree("Test");
+
+    GestureCounter gestures;
+    processor.addListener(&gestures);
+
+    Reactive<Slider> slider;
+    auto parameter = valueTreeState.getParameter("foo");
+    std::unique_ptr<ParameterAttachment> attachment(new ParameterAttachment(valueTreeState, "foo", slider.rx));
+
+    IT("sets the Slider range and value from the parameter")
+    {
+        REQUIRE(slider.getMinimum() == 0);
+        REQUIRE(slider.getMaximum() == 10);
+        REQUIRE(slider.getValue() == Approx(2.5));
+    }
+
+    IT("sets the skew factor of the Slider from the parameter's range")
+    {
+        CHECK(slider.getSkewFactor() == 1);
+
+        Reactive<Slider> frequencySlider;
+        const ParameterAttachment frequencyAttachment(valueTreeState, "frequency", frequencySlider.rx);
+
+        REQUIRE(frequencySlider.getSkewFactor() == Approx(0.25));
+        REQUIRE(frequencySlider.getValue() == Approx(1000));
+    }
+
+    IT("sets a symmetric skew of the Slider from the range")
+    {
+        Reactive<Slider> panSlider;
+        const ParameterAttachment panAttachment(*parameter, NormalisableRange<float>(-1.f, 1.f, 0.f, 0.5f, true), panSlider.rx);
+
+        REQUIRE(panSlider.getSkewFactor() == Approx(0.5));
+        REQUIRE(panSlider.isSymmetricSkew());
+    }
+
+    IT("writes Slider values to the parameter, with a gesture for each change that isn't part of a drag")
+    {
+        slider.setValue(7.5, sendNotificationSync);
+
+        REQUIRE(parameter->getValue() == Approx(0.75f));
+        REQUIRE(gestures.numBegins == 1);
+        REQUIRE(gestures.numEnds == 1);
+    }
+
+    IT("applies parameter changes to the Slider asynchronously")
+    {
+        parameter->setValueNotifyingHost(0.2f);
+        CHECK(slider.getValue() == Approx(2.5));
+
+        ReaX_RunDispatchLoopUntil(slider.getValue() != 2.5);
+        REQUIRE(slider.getValue() == Approx(2.0));
+        REQUIRE(gestures.numBegins == 0);
+    }
+
+    CONTEXT("dragging")
+    {
+        // Simulates the mouse at a horizontal position within the Slider
+        const auto mouseAt = [&slider](float x) {
+            const Point<float> position(x, 10.f);
+            const auto now = Time::getCurrentTime();
+            return MouseEvent(Desktop::getInstance().getMainMouseSource(), position, ModifierKeys(ModifierKeys::leftButtonModifier), MouseInputSource::invalidPressure, MouseInputSource::invalidOrientation, MouseInputSource::invalidRotation, MouseInputSource::invalidTiltX, MouseInputSource::invalidTiltY, &slider, &slider, now, position, now, 1, false);
+        };
+
+        slider.setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+        slider.setBounds(0, 0, 200, 20);
+        Component& component = slider;
+
+        IT("sends one gesture per drag, with many value changes in between")
+        {
+            component.mouseDown(mouseAt(20));
+            for (float x = 30; x <= 180; x += 10)
+                component.mouseDrag(mouseAt(x));
+
+            CHECK(parameter->getValue() > 0.5f);
+            CHECK(gestures.numEnds == 0);
+
+            component.mouseUp(mouseAt(180));
+
+            REQUIRE(gestures.numBegins == 1);
+            REQUIRE(gestures.numEnds == 1);
+        }
+
+        IT("ends the gesture if it's destroyed during a drag")
+        {
+            component.mouseDown(mouseAt(20));
+            component.mouseDrag(mouseAt(100));
+            CHECK(gestures.numBegins == 1);
+
+            attachment.reset();
+            REQUIRE(gestures.numEnds == 1);
+
+            const float value = parameter->getValue();
+            component.mouseDrag(mouseAt(180));
+            component.mouseUp(mouseAt(180));
+
+            REQUIRE(parameter->getValue() == value);
+            REQUIRE(gestures.numBegins == 1);
+            REQUIRE(gestures.numEnds == 1);
+        }
+    }
+
+    IT("stops updating the parameter when it's destroyed")
+    {
+        attachment.reset();
+        slider.setValue(9, sendNotificationSync);
+
+        REQUIRE(parameter->getValue() == Approx(0.25f));
+        REQUIRE(gestures.numBegins == 0);
+    }
+
+    processor.removeListener(&gestures);
+}
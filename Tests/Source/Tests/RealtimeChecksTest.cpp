@@ -0,0 +1,180 @@
+#include "../Other/TestPrefix.h"
+
+// These tests only run if REAX_ENABLE_REALTIME_CHECKS is enabled, i.e. in the "Debug RealtimeChecks" configuration of the test project.
+#if REAX_ENABLE_REALTIME_CHECKS
+
+TEST_CASE("RealtimeChecks",
+          "[RealtimeChecks]")
+{
+    StringArray violations;
+    RealtimeChecks::setViolationHandler([&violations](const String& description) {
+        violations.add(description);
+    });
+
+    // Restores the handler of the test runner, even if a REQUIRE fails
+    struct HandlerRestorer
+    {
+        ~HandlerRestorer()
+        {
+            RealtimeChecks::setViolationHandler(&ReaX_LogRealtimeViolation);
+        }
+    } handlerRestorer;
+
+    IT("doesn't report anything outside of a realtime entry point")
+    {
+        std::unique_ptr<int> value(new int(17));
+        REQUIRE(violations.isEmpty());
+        REQUIRE_FALSE(RealtimeChecks::isInScope());
+    }
+
+    IT("reports allocations inside a scope")
+    {
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            REQUIRE(RealtimeChecks::isInScope());
+            std::unique_ptr<int> value(new int(17));
+        }
+
+        // One for new and one for delete
+        REQUIRE(violations.size() == 2);
+        REQUIRE(violations[0].contains("Test Scope"));
+        REQUIRE_FALSE(RealtimeChecks::isInScope());
+    }
+
+    IT("reports allocations of over-aligned types")
+    {
+        struct alignas(64) CacheLine
+        {
+            float values[16];
+        };
+
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            std::unique_ptr<CacheLine> value(new CacheLine());
+        }
+
+        // Goes through the aligned (and sized) overloads, if the compiler supports them
+        REQUIRE(violations.size() == 2);
+    }
+
+    IT("reports CongestionPolicy::Allocate when the queue has to grow")
+    {
+        LockFreeSource<int> source(1);
+        for (int i = 0; i < 100; ++i)
+            source.onNext(i, CongestionPolicy::Allocate);
+
+        REQUIRE(violations.size() > 0);
+        REQUIRE(violations[0].contains("LockFreeSource::onNext"));
+    }
+
+    IT("doesn't report anything for a preallocated queue")
+    {
+        LockFreeSource<float> source(16, ProducerMode::SingleProducer);
+        LockFreeTarget<float> target(16, CongestionPolicy::DropOldest);
+        Observable<float>::just(0.5f).subscribe(target);
+
+        // Trigger the AsyncUpdater once, outside of the test
+        source.onNext(1.f, CongestionPolicy::DropOldest);
+        violations.clear();
+
+        float value = 0;
+        for (int i = 0; i < 100; ++i)
+            source.onNext(static_cast<float>(i), CongestionPolicy::DropOldest);
+
+        REQUIRE(target.tryDequeueLatest(value));
+        REQUIRE(violations.isEmpty());
+    }
+
+    IT("doesn't report anything when draining the audio thread")
+    {
+        PublishSubject<int> subject;
+        int sum = 0;
+        DisposeBag disposeBag;
+        const AudioThreadScheduler scheduler;
+        subject.observeOn(scheduler).subscribe([&sum](int value) {
+            sum += value;
+        }).disposedBy(disposeBag);
+
+        for (int i = 1; i <= 10; ++i)
+            subject.onNext(i);
+
+        violations.clear();
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            scheduler.drain();
+        }
+
+        REQUIRE(sum == 55);
+        REQUIRE(violations.isEmpty());
+
+        // Let the message thread release the delivered values
+        ReaX_RunDispatchLoop(20);
+    }
+
+    IT("reports locks")
+    {
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            RealtimeChecks::lockWillBeAcquired();
+        }
+
+        REQUIRE(violations.size() == 1);
+        REQUIRE(violations[0].startsWith("A lock"));
+    }
+
+    IT("reports the locks of ReaX itself")
+    {
+        LockFreeTarget<float> target(16, CongestionPolicy::DropNewest);
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            target.onNext(0.5f);
+        }
+
+        REQUIRE(violations.joinIntoString("\n").contains("A lock has been acquired in Test Scope."));
+    }
+
+    IT("doesn't report anything when taking a value's memory from the MemoryPool and returning it")
+    {
+        typedef std::array<float, 128> Chunk;
+        MemoryPool::reserve(Chunk(), 4);
+        const Chunk chunk{};
+
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            const detail::any value(chunk);
+        }
+
+        REQUIRE(violations.isEmpty());
+    }
+
+    IT("doesn't report anything when writing into a LatestValueSource")
+    {
+        LatestValueSource<std::array<float, 64>> source;
+
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            for (int i = 0; i < 10; ++i)
+                source.write([i](std::array<float, 64>& values) { values.fill(static_cast<float>(i)); });
+        }
+
+        REQUIRE(violations.isEmpty());
+    }
+
+    IT("doesn't report anything when copying a Subscription into a DisposeBag with enough capacity")
+    {
+        PublishSubject<int> subject;
+        const auto subscription = subject.subscribe([](int) {});
+        DisposeBag disposeBag;
+        disposeBag.reserve(1);
+
+        {
+            REAX_REALTIME_SCOPE("Test Scope");
+            const Subscription copy = subscription;
+            disposeBag.insert(copy);
+        }
+
+        REQUIRE(violations.isEmpty());
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "../Other/TestPrefix.h"
+
+using detail::any;
+
+TEST_CASE("Shared",
+          "[Shared]")
+{
+    CONTEXT("value semantics")
+    {
+        const Shared<std::vector<float>> shared(std::vector<float>(512, 0.5f));
+
+        IT("gives read-only access to the value")
+        {
+            REQUIRE(shared->size() == 512);
+            REQUIRE((*shared)[0] == 0.5f);
+            REQUIRE(shared.get().back() == 0.5f);
+        }
+
+        IT("shares the value between copies")
+        {
+            const auto copy = shared;
+            REQUIRE(&copy.get() == &shared.get());
+            REQUIRE(shared.getReferenceCount() == 2);
+        }
+
+        IT("compares by identity")
+        {
+            REQUIRE(shared == shared);
+            REQUIRE(Shared<std::vector<float>>(std::vector<float>(512, 0.5f)) != shared);
+        }
+
+        IT("is stored inline by an any, so wrapping it doesn't allocate")
+        {
+            static_assert(sizeof(Shared<std::vector<float>>) <= any::InlineStorageSize, "Shared<T> should be stored inline.");
+
+            const any wrapped(shared);
+            const any copy(wrapped);
+
+            // Inline values are copied together with the any, allocated values are shared between copies
+            REQUIRE(&copy.get<Shared<std::vector<float>>>() != &wrapped.get<Shared<std::vector<float>>>());
+            REQUIRE(copy.get<Shared<std::vector<float>>>() == shared);
+            REQUIRE(&copy.get<Shared<std::vector<float>>>().get() == &shared.get());
+        }
+
+        IT("can create the value in place")
+        {
+            const auto made = Shared<std::vector<float>>::make(3, 1.f);
+            REQUIRE(made->size() == 3);
+        }
+    }
+
+    CONTEXT("Observables")
+    {
+        PublishSubject<Shared<CopyAndMoveConstructible>> subject;
+        Array<const CopyAndMoveConstructible*> addresses;
+        DisposeBag disposeBag;
+
+        for (int i = 0; i < 2; ++i) {
+            subject.observeOn(Scheduler::backgroundThread())
+                .map([](const Shared<CopyAndMoveConstructible>& shared) { return shared; })
+                .observeOn(Scheduler::messageThread())
+                .subscribe([&addresses](const Shared<CopyAndMoveConstructible>& shared) {
+                    addresses.add(&shared.get());
+                })
+                .disposedBy(disposeBag);
+        }
+
+        IT("doesn't copy the value through operators and observeOn")
+        {
+            CopyAndMoveConstructible::Counters counters;
+            const Shared<CopyAndMoveConstructible> shared(CopyAndMoveConstructible(&counters));
+            subject.onNext(shared);
+
+            ReaX_RunDispatchLoopUntil(addresses.size() == 2);
+            REQUIRE(addresses[0] == &shared.get());
+            REQUIRE(addresses[1] == &shared.get());
+            REQUIRE(counters.numCopyConstructions == 0);
+            REQUIRE(counters.numCopyAssignments == 0);
+        }
+    }
+}
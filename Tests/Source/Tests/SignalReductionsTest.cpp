@@ -0,0 +1,126 @@
+#include "../Other/TestPrefix.h"
+
+TEST_CASE("SignalReductions",
+          "[SignalReductions]")
+{
+    const Array<float> samples({ 0.25f, -0.5f, 0.125f, 0.f, 1.f, -0.75f, 0.5f, 0.f, -0.25f });
+
+    IT("computes the peak")
+    {
+        CHECK(SignalReductions::peak(samples) == 1.f);
+        CHECK(SignalReductions::peak(Array<float>({ -0.5f, 0.25f })) == 0.5f);
+        REQUIRE(SignalReductions::peak(Array<float>()) == 0.f);
+    }
+
+    IT("computes the RMS, including the samples that don't fill a vector")
+    {
+        float sumOfSquares = 0.f;
+        for (auto sample : samples)
+            sumOfSquares += sample * sample;
+
+        CHECK(SignalReductions::rms(samples) == Approx(std::sqrt(sumOfSquares / samples.size())));
+        REQUIRE(SignalReductions::rms(std::vector<float>()) == 0.f);
+    }
+
+    IT("combines all channels of an AudioBuffer")
+    {
+        AudioBuffer<float> buffer(2, 4);
+        buffer.clear();
+        buffer.setSample(0, 1, 0.5f);
+        buffer.setSample(1, 2, -0.75f);
+
+        CHECK(SignalReductions::peak(buffer) == 0.75f);
+        CHECK(SignalReductions::rms(buffer) == Approx(std::sqrt((0.25f + 0.5625f) / 8)));
+
+        const auto envelope = SignalReductions::minMaxEnvelope(buffer, 2);
+        REQUIRE(envelope == Array<Range<float>>({ Range<float>(0.f, 0.5f), Range<float>(-0.75f, 0.f) }));
+    }
+
+    IT("computes a min/max envelope")
+    {
+        const auto envelope = SignalReductions::minMaxEnvelope(samples, 3);
+
+        REQUIRE(envelope == Array<Range<float>>({ Range<float>(-0.5f, 0.25f), Range<float>(-0.75f, 1.f), Range<float>(-0.25f, 0.5f) }));
+    }
+
+    IT("shares samples between bins if there are more bins than samples")
+    {
+        const auto envelope = SignalReductions::minMaxEnvelope(Array<float>({ 1.f, -1.f }), 4);
+
+        REQUIRE(envelope == Array<Range<float>>({ Range<float>(1.f, 1.f), Range<float>(1.f, 1.f), Range<float>(-1.f, -1.f), Range<float>(-1.f, -1.f) }));
+    }
+}
+
+TEST_CASE("DecayingPeakHold",
+          "[SignalReductions][DecayingPeakHold]")
+{
+    DecayingPeakHold peakHold(2, 0.5f);
+
+    IT("holds the highest peak, and decays afterwards")
+    {
+        CHECK(peakHold.process(0.8f) == 0.8f);
+        CHECK(peakHold.process(0.1f) == 0.8f);
+        CHECK(peakHold.process(0.1f) == 0.8f);
+        CHECK(peakHold.process(0.1f) == 0.4f);
+        CHECK(peakHold.process(0.1f) == 0.2f);
+        CHECK(peakHold.process(0.1f) == 0.1f);
+        REQUIRE(peakHold.process(0.3f) == 0.3f);
+    }
+
+    IT("restarts holding when a higher peak arrives")
+    {
+        peakHold.process(0.5f);
+        peakHold.process(0.f);
+        peakHold.process(0.f);
+        CHECK(peakHold.process(0.f) == 0.25f);
+
+        CHECK(peakHold.process(0.6f) == 0.6f);
+        REQUIRE(peakHold.process(0.f) == 0.6f);
+    }
+}
+
+TEST_CASE("Observable signal reductions",
+          "[Observable][Observable::peak][Observable::rms][Observable::minMaxEnvelope][Observable::decayingPeakHold]")
+{
+    const auto blocks = Observable<Array<float>>::from({ Array<float>({ 0.5f, -0.5f }), Array<float>({ 0.f, -1.f, 0.25f, 0.f }) });
+    Array<float> values;
+
+    IT("emits the peak of each block")
+    {
+        ReaX_CollectValues(blocks.peak(), values);
+
+        ReaX_RequireValues(values, 0.5f, 1.f);
+    }
+
+    IT("emits the RMS of each block")
+    {
+        ReaX_CollectValues(blocks.rms(), values);
+
+        CHECK(values.size() == 2);
+        CHECK(values[0] == Approx(0.5f));
+        REQUIRE(values[1] == Approx(std::sqrt(1.0625f / 4)));
+    }
+
+    IT("emits the min/max envelope of each block")
+    {
+        Array<Array<Range<float>>> envelopes;
+        ReaX_CollectValues(blocks.minMaxEnvelope(2), envelopes);
+
+        ReaX_RequireValues(envelopes,
+                           Array<Range<float>>({ Range<float>(0.5f, 0.5f), Range<float>(-0.5f, -0.5f) }),
+                           Array<Range<float>>({ Range<float>(-1.f, 0.f), Range<float>(0.f, 0.25f) }));
+    }
+
+    IT("applies the peak hold to peak values")
+    {
+        PublishSubject<float> peaks;
+        ReaX_CollectValues(peaks.decayingPeakHold(1, 0.5f), values);
+
+        peaks.onNext(1.f);
+        peaks.onNext(0.f);
+        peaks.onNext(0.f);
+        peaks.onNext(0.f);
+
+        ReaX_RequireValues(values, 1.f, 1.f, 0.5f, 0.25f);
+    }
+}
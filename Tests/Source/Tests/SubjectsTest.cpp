@@ -1,10 +1,13 @@
 #include "../Other/TestPrefix.h"
 
+#include <thread>
+
 
 TEST_CASE("BehaviorSubject",
           "[Subject][BehaviorSubject]")
 {
     BehaviorSubject<var> subject("Initial Value");
+    DisposeBag disposeBag;
 
     // Subscribe to the subject's Observable
     Array<var> values;
@@ -74,6 +77,52 @@ TEST_CASE("BehaviorSubject",
         BehaviorSubject<Point<int>> subject(Point<int>(13, 556));
         REQUIRE(subject.getValue() == Point<int>(13, 556));
     }
+
+    CONTEXT("trivially copyable values")
+    {
+        BehaviorSubject<double> subject(0.5);
+
+        IT("returns the new value when pushed through a copy of the Observer")
+        {
+            const Observer<double> observer = subject;
+            observer.onNext(0.75);
+
+            REQUIRE(subject.getValue() == 0.75);
+        }
+
+        IT("returns the new value from within a subscriber")
+        {
+            Array<double> valuesInSubscriber;
+            subject.subscribe([&](double) { valuesInSubscriber.add(subject.getValue()); }).disposedBy(disposeBag);
+            subject.onNext(2.5);
+
+            ReaX_RequireValues(valuesInSubscriber, 0.5, 2.5);
+        }
+
+        IT("returns consistent values of a struct while another thread pushes values")
+        {
+            BehaviorSubject<Point<float>> subject(Point<float>(0, 0));
+            std::atomic<bool> shouldStop{ false };
+            std::atomic<int> numInconsistentValues{ 0 };
+
+            std::thread reader([&]() {
+                while (!shouldStop.load()) {
+                    const auto point = subject.getValue();
+                    if (point.x != point.y)
+                        ++numInconsistentValues;
+                }
+            });
+
+            for (int i = 1; i <= 10000; ++i)
+                subject.onNext(Point<float>(float(i), float(i)));
+
+            shouldStop.store(true);
+            reader.join();
+
+            CHECK(numInconsistentValues.load() == 0);
+            REQUIRE(subject.getValue() == Point<float>(10000, 10000));
+        }
+    }
 }
 
 
@@ -101,6 +150,18 @@ TEST_CASE("PublishSubject",
         ReaX_RequireValues(values, "First Value");
     }
 
+    IT("knows whether it has subscribers")
+    {
+        PublishSubject<int> other;
+        CHECK(!other.hasSubscribers());
+
+        auto subscription = other.subscribe([](int) {});
+        CHECK(other.hasSubscribers());
+
+        subscription.unsubscribe();
+        REQUIRE(!other.hasSubscribers());
+    }
+
     IT("does not emit previous value(s) when subscribing")
     {
         subject.onNext(1);
@@ -174,6 +235,120 @@ TEST_CASE("PublishSubject",
 }
 
 
+TEST_CASE("ConcurrentPublishSubject",
+          "[Subject][ConcurrentPublishSubject]")
+{
+    ConcurrentPublishSubject<int> subject;
+    DisposeBag disposeBag;
+
+    IT("emits to all subscribers")
+    {
+        Array<int> first;
+        Array<int> second;
+        ReaX_CollectValues(subject, first);
+        ReaX_CollectValues(subject, second);
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CheckValues(first, 1, 2);
+        ReaX_RequireValues(second, 1, 2);
+    }
+
+    IT("does not emit previous value(s) when subscribing")
+    {
+        subject.onNext(1);
+
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 2);
+    }
+
+    IT("stops emitting to a subscriber after it has been unsubscribed")
+    {
+        Array<int> values;
+        auto subscription = subject.subscribe([&values](int value) { values.add(value); });
+
+        subject.onNext(1);
+        subscription.unsubscribe();
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 1);
+    }
+
+    IT("can subscribe and unsubscribe while emitting")
+    {
+        Array<int> values;
+        std::shared_ptr<Subscription> inner;
+        subject.subscribe([&](int value) {
+                   if (value == 1)
+                       inner = std::make_shared<Subscription>(subject.subscribe([&values](int value) { values.add(value); }));
+                   else if (value == 3)
+                       inner->unsubscribe();
+               })
+            .disposedBy(disposeBag);
+
+        subject.onNext(1);
+        subject.onNext(2);
+        subject.onNext(3);
+
+        // The inner subscriber is added while emitting 1, and removed while emitting 3 (before it's reached)
+        ReaX_RequireValues(values, 2);
+    }
+
+    IT("emits an error to late subscribers")
+    {
+        bool onErrorCalled = false;
+        subject.onError(std::exception_ptr());
+        subject.subscribe([](int) {}, [&](std::exception_ptr) { onErrorCalled = true; }).disposedBy(disposeBag);
+
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("notifies onCompleted, also to late subscribers")
+    {
+        bool completed = false;
+        bool lateCompleted = false;
+        subject.subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+
+        subject.onCompleted();
+        subject.onCompleted();
+        subject.subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { lateCompleted = true; }).disposedBy(disposeBag);
+
+        CHECK(completed);
+        REQUIRE(lateCompleted);
+    }
+
+    IT("emits from a background thread while subscriptions change")
+    {
+        const Observer<int> observer = subject;
+        std::atomic<bool> shouldStop{ false };
+        std::atomic<int> numReceived{ 0 };
+
+        std::thread producer([&]() {
+            while (!shouldStop.load())
+                observer.onNext(1);
+        });
+
+        for (int i = 0; i < 1000; ++i) {
+            DisposeBag localBag;
+            subject.subscribe([&numReceived](int) { ++numReceived; }).disposedBy(localBag);
+        }
+
+        shouldStop.store(true);
+        producer.join();
+
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+        subject.onNext(5);
+
+        REQUIRE(values.size() == 1);
+    }
+}
+
+
 TEST_CASE("ReplaySubject",
           "[Subject][ReplaySubject]")
 {
@@ -291,6 +466,152 @@ TEST_CASE("ReplaySubject",
 }
 
 
+TEST_CASE("ReplaySubject with a preallocated buffer",
+          "[Subject][ReplaySubject]")
+{
+    ReplaySubject<int> subject(3, ReplayBufferMode::Preallocated);
+    DisposeBag disposeBag;
+
+    IT("does not emit a value if nothing has been pushed")
+    {
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+
+        REQUIRE(values.isEmpty());
+    }
+
+    IT("emits previous values when subscribing, and continues with new values")
+    {
+        subject.onNext(1);
+        subject.onNext(2);
+
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+        subject.onNext(3);
+
+        ReaX_RequireValues(values, 1, 2, 3);
+    }
+
+    IT("emits previous values limited by the buffer size, after the ring has wrapped around")
+    {
+        for (int i = 1; i <= 8; ++i)
+            subject.onNext(i);
+
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+
+        ReaX_RequireValues(values, 6, 7, 8);
+    }
+
+    IT("replays the values and the completion to late subscribers")
+    {
+        subject.onNext(1);
+        subject.onCompleted();
+
+        Array<int> values;
+        bool completed = false;
+        subject.subscribe([&values](int value) { values.add(value); }, [](std::exception_ptr) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+
+        CHECK(completed);
+        ReaX_RequireValues(values, 1);
+    }
+
+    IT("emits an error when calling onError")
+    {
+        bool onErrorCalled = false;
+        subject.onError(std::exception_ptr());
+        subject.subscribe([](int) {}, [&](std::exception_ptr) { onErrorCalled = true; }).disposedBy(disposeBag);
+
+        REQUIRE(onErrorCalled);
+    }
+
+    IT("allows pushing values while replaying")
+    {
+        subject.onNext(1);
+
+        Array<int> values;
+        subject.subscribe([&](int value) {
+                   values.add(value);
+                   if (value == 1)
+                       subject.onNext(2);
+               })
+            .disposedBy(disposeBag);
+
+        Array<int> laterValues;
+        ReaX_CollectValues(subject, laterValues);
+
+        ReaX_RequireValues(laterValues, 1, 2);
+    }
+
+    IT("delivers values that a subscriber pushes while replaying after the replayed values")
+    {
+        subject.onNext(1);
+        subject.onNext(2);
+
+        Array<int> values;
+        subject.subscribe([&](int value) {
+                   values.add(value);
+                   if (value == 1)
+                       subject.onNext(10);
+               })
+            .disposedBy(disposeBag);
+
+        ReaX_CheckValues(values, 1, 2, 10);
+
+        subject.onNext(11);
+        ReaX_RequireValues(values, 1, 2, 10, 11);
+    }
+
+    IT("doesn't deadlock if a subscriber waits for another thread that pushes a value")
+    {
+        Array<int> values;
+        subject.subscribe([&](int value) {
+                   values.add(value);
+                   if (value == 1)
+                       std::thread([&]() { subject.onNext(2); }).join();
+               })
+            .disposedBy(disposeBag);
+
+        subject.onNext(1);
+
+        ReaX_RequireValues(values, 1, 2);
+    }
+
+    IT("doesn't deadlock if a replayed subscriber waits for another thread that pushes a value")
+    {
+        subject.onNext(1);
+
+        Array<int> values;
+        subject.subscribe([&](int value) {
+                   values.add(value);
+                   if (value == 1)
+                       std::thread([&]() { subject.onNext(2); }).join();
+               })
+            .disposedBy(disposeBag);
+
+        ReaX_RequireValues(values, 1, 2);
+    }
+
+    IT("doesn't deadlock if a subscriber waits for another thread that subscribes")
+    {
+        Array<int> values;
+        Array<int> otherValues;
+        subject.subscribe([&](int value) {
+                   values.add(value);
+                   if (value == 1)
+                       std::thread([&]() { subject.subscribe([&](int otherValue) { otherValues.add(otherValue); }).disposedBy(disposeBag); }).join();
+               })
+            .disposedBy(disposeBag);
+
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_CheckValues(values, 1, 2);
+        ReaX_RequireValues(otherValues, 1, 2);
+    }
+}
+
+
 TEST_CASE("onNext move overload",
           "[Subject][Observer]")
 {
@@ -318,3 +639,45 @@ TEST_CASE("onNext move overload",
         REQUIRE(counters.numMoveAssignments == 0);
     }
 }
+
+
+TEST_CASE("Observable::subscribeByMoving",
+          "[Subject][Observable]")
+{
+    PublishSubject<std::unique_ptr<int>> subject;
+    std::vector<std::unique_ptr<int>> values;
+    DisposeBag disposeBag;
+
+    subject.subscribeByMoving([&values](std::unique_ptr<int>&& value) {
+               values.push_back(std::move(value));
+           })
+        .disposedBy(disposeBag);
+
+    IT("moves move-only values to the subscriber")
+    {
+        auto value = std::unique_ptr<int>(new int(17));
+        int* const address = value.get();
+        subject.onNext(std::move(value));
+
+        REQUIRE(values.size() == 1);
+        REQUIRE(values.front().get() == address);
+    }
+
+    IT("moves values through operators")
+    {
+        DisposeBag mappedDisposeBag;
+        std::vector<std::unique_ptr<int>> mappedValues;
+        subject.map([](const std::unique_ptr<int>& value) {
+                   return std::unique_ptr<int>(new int(*value + 1));
+               })
+            .subscribeByMoving([&mappedValues](std::unique_ptr<int>&& value) {
+                mappedValues.push_back(std::move(value));
+            })
+            .disposedBy(mappedDisposeBag);
+
+        subject.onNext(std::unique_ptr<int>(new int(3)));
+
+        REQUIRE(mappedValues.size() == 1);
+        REQUIRE(*mappedValues.front() == 4);
+    }
+}
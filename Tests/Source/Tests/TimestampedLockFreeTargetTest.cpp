@@ -0,0 +1,84 @@
+#include "../Other/TestPrefix.h"
+
+
+TEST_CASE("TimestampedLockFreeTarget",
+          "[TimestampedLockFreeTarget]")
+{
+    TimestampedLockFreeTarget<int> target;
+    Array<int> values;
+    Array<int> offsets;
+    const auto collect = [&values, &offsets](int value, int sampleOffset) {
+        values.add(value);
+        offsets.add(sampleOffset);
+    };
+
+    IT("returns 0 if no values have been retrieved")
+    {
+        REQUIRE(target.dequeueBlock(512, 48000, collect) == 0);
+        REQUIRE(values.isEmpty());
+    }
+
+    IT("returns the values in order, with sample offsets within the block")
+    {
+        for (int i = 1; i <= 3; ++i)
+            target.onNext(i);
+
+        REQUIRE(target.dequeueBlock(512, 48000, collect) == 3);
+        ReaX_RequireValues(values, 1, 2, 3);
+
+        for (int i = 0; i < offsets.size(); ++i) {
+            REQUIRE(offsets[i] >= (i > 0 ? offsets[i - 1] : 0));
+            REQUIRE(offsets[i] < 512);
+        }
+    }
+
+    IT("keeps the distances in time between values")
+    {
+        // Starts the first block, so the next one covers the time in between
+        target.dequeueBlock(48000, 48000, collect);
+
+        target.onNext(1);
+        Thread::sleep(20);
+        target.onNext(2);
+        Thread::sleep(20);
+
+        REQUIRE(target.dequeueBlock(48000, 48000, collect) == 2);
+        ReaX_RequireValues(values, 1, 2);
+
+        // At least 20 ms at 48 kHz
+        REQUIRE(offsets[1] - offsets[0] >= 960);
+        REQUIRE(offsets[1] < 48000);
+    }
+
+    IT("maps values that are older than the previous block to the offset 0")
+    {
+        target.onNext(1);
+        Thread::sleep(20);
+
+        // 64 samples at 48 kHz are much shorter than 20 ms
+        target.reset();
+        REQUIRE(target.dequeueBlock(64, 48000, collect) == 1);
+        ReaX_RequireValues(offsets, 0);
+    }
+
+    IT("keeps the values for the next block if a block has no samples")
+    {
+        target.onNext(1);
+
+        REQUIRE(target.dequeueBlock(0, 48000, collect) == 0);
+        REQUIRE(values.isEmpty());
+
+        REQUIRE(target.dequeueBlock(512, 48000, collect) == 1);
+        ReaX_RequireValues(values, 1);
+    }
+
+    IT("supports a bounded queue")
+    {
+        TimestampedLockFreeTarget<int> bounded(2, CongestionPolicy::DropOldest);
+        for (int i = 0; i < 5; ++i)
+            bounded.onNext(i);
+
+        REQUIRE(bounded.dequeueBlock(512, 48000, collect) == 2);
+        ReaX_RequireValues(values, 3, 4);
+    }
+}
@@ -0,0 +1,130 @@
+#include "../Other/TestPrefix.h"
+
+#include <thread>
+
+
+TEST_CASE("Transaction",
+          "[Transaction]")
+{
+    BehaviorSubject<int> first(1);
+    BehaviorSubject<int> second(10);
+    DisposeBag disposeBag;
+    Array<int> firstValues;
+    ReaX_CollectValues(first, firstValues);
+
+    IT("emits only the final value of each subject when it ends")
+    {
+        {
+            Transaction transaction;
+            first.onNext(2);
+            first.onNext(3);
+
+            ReaX_CheckValues(firstValues, 1);
+            CHECK(first.getValue() == 1);
+        }
+
+        CHECK(first.getValue() == 3);
+        ReaX_RequireValues(firstValues, 1, 3);
+    }
+
+    IT("recomputes a combined Observable once per changed subject")
+    {
+        Array<int> sums;
+        ReaX_CollectValues(first.combineLatest([](int a, int b) { return a + b; }, second), sums);
+
+        {
+            Transaction transaction;
+            for (int i = 0; i < 100; ++i) {
+                first.onNext(i);
+                second.onNext(i * 10);
+            }
+        }
+
+        ReaX_RequireValues(sums, 11, 99 + 10, 99 + 990);
+    }
+
+    IT("recomputes a glitch-free combined Observable once per transaction")
+    {
+        Array<int> sums;
+        ReaX_CollectValues(first.combineLatest(Propagation::GlitchFree, [](int a, int b) { return a + b; }, second), sums);
+
+        {
+            Transaction transaction;
+            for (int i = 0; i < 100; ++i) {
+                first.onNext(i);
+                second.onNext(i * 10);
+            }
+        }
+
+        ReaX_RequireValues(sums, 11, 99 + 990);
+    }
+
+    IT("flushes only when the outermost transaction ends")
+    {
+        {
+            Transaction outer;
+            {
+                Transaction inner;
+                first.onNext(2);
+            }
+
+            CHECK(Transaction::isActive());
+            ReaX_CheckValues(firstValues, 1);
+        }
+
+        CHECK(!Transaction::isActive());
+        ReaX_RequireValues(firstValues, 1, 2);
+    }
+
+    IT("emits changes that subscribers make while flushing right away")
+    {
+        Array<int> secondValues;
+        ReaX_CollectValues(second, secondValues);
+        first.subscribe([&](int i) { second.onNext(i * 10); }).disposedBy(disposeBag);
+
+        {
+            Transaction transaction;
+            first.onNext(5);
+        }
+
+        ReaX_RequireValues(secondValues, 10, 10, 50);
+    }
+
+    IT("emits the latest value before a subject completes")
+    {
+        bool completed = false;
+        first.subscribe([](int) {}, [](std::exception_ptr) {}, [&]() { completed = true; }).disposedBy(disposeBag);
+
+        {
+            Transaction transaction;
+            first.onNext(4);
+            first.onCompleted();
+
+            CHECK(completed);
+            ReaX_CheckValues(firstValues, 1, 4);
+        }
+
+        ReaX_RequireValues(firstValues, 1, 4);
+    }
+
+    IT("doesn't defer values that are pushed on other threads")
+    {
+        Transaction transaction;
+        std::thread([&]() { first.onNext(7); }).join();
+
+        ReaX_RequireValues(firstValues, 1, 7);
+    }
+
+    IT("doesn't affect PublishSubjects")
+    {
+        PublishSubject<int> subject;
+        Array<int> values;
+        ReaX_CollectValues(subject, values);
+
+        Transaction transaction;
+        subject.onNext(1);
+        subject.onNext(2);
+
+        ReaX_RequireValues(values, 1, 2);
+    }
+}
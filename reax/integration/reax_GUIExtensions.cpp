@@ -1,20 +1,93 @@
 using std::placeholders::_1;
 
+namespace detail {
+// Collects the latest update for each property of a Component, and applies them on the next frame
+class ComponentUpdateBatcher : private FrameTicker::Client
+{
+public:
+    ~ComponentUpdateBatcher()
+    {
+        if (frameRequested)
+            FrameTicker::getInstance().cancelFrame(*this);
+    }
+
+    void setEnabled(bool shouldBeEnabled)
+    {
+        enabled = shouldBeEnabled;
+
+        if (!enabled)
+            applyPendingUpdates();
+    }
+
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    // Applies the update on the next frame, replacing a pending update with the same key
+    void defer(int key, std::function<void()>&& update)
+    {
+        auto pendingUpdate = std::find_if(pendingUpdates.begin(), pendingUpdates.end(), [key](const PendingUpdate& p) {
+            return p.first == key;
+        });
+
+        if (pendingUpdate != pendingUpdates.end())
+            pendingUpdate->second = std::move(update);
+        else
+            pendingUpdates.emplace_back(key, std::move(update));
+
+        if (!frameRequested) {
+            FrameTicker::getInstance().requestFrame(*this);
+            frameRequested = true;
+        }
+    }
+
+private:
+    typedef std::pair<int, std::function<void()>> PendingUpdate;
+
+    bool enabled = false;
+    bool frameRequested = false;
+    std::vector<PendingUpdate> pendingUpdates;
+
+    void frameDidTick() override
+    {
+        frameRequested = false;
+        applyPendingUpdates();
+    }
+
+    void applyPendingUpdates()
+    {
+        // An update may push new values, so take the pending ones first
+        std::vector<PendingUpdate> updates;
+        updates.swap(pendingUpdates);
+
+        for (auto& update : updates)
+            update.second();
+    }
+};
+}
+
 ComponentExtension::ComponentExtension(Component& parent)
 : colourSubjects(new std::map<int, PublishSubject<juce::Colour>>()),
   parent(parent),
   bounds(parent.getBounds()),
   visible(parent.isVisible()),
-  disposeBag(new DisposeBag())
+  disposeBag(new DisposeBag()),
+  updateBatcher(new detail::ComponentUpdateBatcher())
 {
     parent.addComponentListener(this);
 
-    bounds.skip(1).subscribe([&parent](const Rectangle<int>& bounds) {
-                      parent.setBounds(bounds);
+    bounds.skip(1).subscribe([this](const Rectangle<int>& bounds) {
+                      auto& parent = this->parent;
+                      applyUpdate(BoundsUpdate, [&parent, bounds]() { parent.setBounds(bounds); });
                   })
         .disposedBy(*disposeBag);
 
-    visible.skip(1).subscribe(std::bind(&Component::setVisible, &parent, _1)).disposedBy(*disposeBag);
+    visible.skip(1).subscribe([this](bool visible) {
+                       auto& parent = this->parent;
+                       applyUpdate(VisibleUpdate, [&parent, visible]() { parent.setVisible(visible); });
+                   })
+        .disposedBy(*disposeBag);
 }
 
 ComponentExtension::~ComponentExtension()
@@ -22,17 +95,46 @@ ComponentExtension::~ComponentExtension()
     parent.removeComponentListener(this);
 }
 
+void ComponentExtension::setFrameCoalescingEnabled(bool shouldBeEnabled) const
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    updateBatcher->setEnabled(shouldBeEnabled);
+}
+
+bool ComponentExtension::isFrameCoalescingEnabled() const
+{
+    return updateBatcher->isEnabled();
+}
+
+void ComponentExtension::deferUpdate(int key, std::function<void()>&& update) const
+{
+    updateBatcher->defer(key, std::move(update));
+}
+
 Observer<Colour> ComponentExtension::colour(int colourId) const
 {
-    // Create subject, if not already done
-    if (colourSubjects->find(colourId) == colourSubjects->end())
-        colourSubjects->insert(std::make_pair(colourId, PublishSubject<Colour>()));
+    auto it = colourSubjects->find(colourId);
+
+    // Create and subscribe the subject only once per colourId, so calling this repeatedly doesn't add subscriptions
+    if (it == colourSubjects->end()) {
+        it = colourSubjects->insert(std::make_pair(colourId, PublishSubject<Colour>())).first;
 
-    // Subscribe
-    colourSubjects->at(colourId).subscribe(std::bind(&Component::setColour, &parent, colourId, _1)).disposedBy(*disposeBag);
+        it->second.subscribe([this, colourId](const Colour& colour) {
+                      auto& parent = this->parent;
+                      applyUpdate(colourId, [&parent, colourId, colour]() { parent.setColour(colourId, colour); });
+                  })
+            .disposedBy(*disposeBag);
+    }
 
     // Return as Observer
-    return colourSubjects->at(colourId);
+    return it->second;
+}
+
+size_t ComponentExtension::getNumSubscriptions() const
+{
+    return disposeBag->size();
 }
 
 void ComponentExtension::componentMovedOrResized(Component&, bool, bool)
@@ -53,13 +155,11 @@ ButtonExtension::ButtonExtension(Button& parent)
   clicked(_clicked),
   buttonState(parent.getState()),
   toggleState(parent.getToggleState()),
-  text(_text),
-  tooltip(_tooltip)
+  text(parent, [](Component& button, const String& text) { static_cast<Button&>(button).setButtonText(text); }),
+  tooltip(parent, [](Component& button, const String& tooltip) { static_cast<Button&>(button).setTooltip(tooltip); })
 {
     parent.addListener(this);
 
-    _text.subscribe(std::bind(&Button::setButtonText, &parent, _1)).disposedBy(disposeBag);
-    _tooltip.subscribe(std::bind(&Button::setTooltip, &parent, _1)).disposedBy(disposeBag);
     buttonState.skip(1).subscribe(std::bind(&Button::setState, &parent, _1)).disposedBy(disposeBag);
     toggleState.skip(1).subscribe([&parent](bool toggled) {
                            parent.setToggleState(toggled, sendNotificationSync);
@@ -73,6 +173,11 @@ ButtonExtension::~ButtonExtension()
     static_cast<Button&>(parent).removeListener(this);
 }
 
+size_t ButtonExtension::getNumSubscriptions() const
+{
+    return ComponentExtension::getNumSubscriptions() + disposeBag.size();
+}
+
 void ButtonExtension::buttonClicked(Button*)
 {
     _clicked.onNext(Empty());
@@ -89,16 +194,9 @@ void ButtonExtension::buttonStateChanged(Button* button)
 
 ImageComponentExtension::ImageComponentExtension(ImageComponent& parent)
 : ComponentExtension(parent),
-  image(_image),
-  imagePlacement(_imagePlacement)
-{
-    _image.subscribe([&parent](const Image& image) {
-              parent.setImage(image);
-          })
-        .disposedBy(disposeBag);
-
-    _imagePlacement.subscribe(std::bind(&ImageComponent::setImagePlacement, &parent, _1)).disposedBy(disposeBag);
-}
+  image(parent, [](Component& imageComponent, const Image& image) { static_cast<ImageComponent&>(imageComponent).setImage(image); }),
+  imagePlacement(parent, [](Component& imageComponent, const RectanglePlacement& placement) { static_cast<ImageComponent&>(imageComponent).setImagePlacement(placement); })
+{}
 
 LabelExtension::LabelExtension(Label& parent)
 : ComponentExtension(parent),
@@ -107,21 +205,46 @@ LabelExtension::LabelExtension(Label& parent)
   text(parent.getText()),
   showEditor(parent.getCurrentTextEditor() != nullptr),
   discardChangesWhenHidingEditor(_discardChangesWhenHidingEditor),
-  font(_font),
-  justificationType(_justificationType),
-  borderSize(_borderSize),
-  attachedComponent(_attachedComponent),
-  attachedOnLeft(_attachedOnLeft),
-  minimumHorizontalScale(_minimumHorizontalScale),
-  keyboardType(_keyboardType),
-  editableOnSingleClick(_editableOnSingleClick),
-  editableOnDoubleClick(_editableOnDoubleClick),
-  lossOfFocusDiscardsChanges(_lossOfFocusDiscardsChanges),
+  font(parent, [](Component& label, const Font& font) { static_cast<Label&>(label).setFont(font); }),
+  justificationType(parent, [](Component& label, const Justification& justification) { static_cast<Label&>(label).setJustificationType(justification); }),
+  borderSize(parent, [](Component& label, const BorderSize<int>& borderSize) { static_cast<Label&>(label).setBorderSize(borderSize); }),
+  attachedComponent(parent, [](Component& component, const WeakReference<Component>& attachedComponent) {
+      auto& label = static_cast<Label&>(component);
+      label.attachToComponent(attachedComponent, label.isAttachedOnLeft());
+  }),
+  attachedOnLeft(parent, [](Component& component, const bool& attachedOnLeft) {
+      auto& label = static_cast<Label&>(component);
+      label.attachToComponent(label.getAttachedComponent(), attachedOnLeft);
+  }),
+  minimumHorizontalScale(parent, [](Component& label, const float& scale) { static_cast<Label&>(label).setMinimumHorizontalScale(scale); }),
+  keyboardType(parent, [](Component& component, const TextInputTarget::VirtualKeyboardType& keyboardType) {
+      auto& label = static_cast<Label&>(component);
+      label.setKeyboardType(keyboardType);
+
+      if (auto editor = label.getCurrentTextEditor())
+          editor->setKeyboardType(keyboardType);
+  }),
+  // These read the other properties from the Label, because they may have been changed on the Label directly
+  editableOnSingleClick(parent, [](Component& component, const bool& editableOnSingleClick) {
+      auto& label = static_cast<Label&>(component);
+      label.setEditable(editableOnSingleClick, label.isEditableOnDoubleClick(), label.doesLossOfFocusDiscardChanges());
+  }),
+  editableOnDoubleClick(parent, [](Component& component, const bool& editableOnDoubleClick) {
+      auto& label = static_cast<Label&>(component);
+      label.setEditable(label.isEditableOnSingleClick(), editableOnDoubleClick, label.doesLossOfFocusDiscardChanges());
+  }),
+  lossOfFocusDiscardsChanges(parent, [](Component& component, const bool& lossOfFocusDiscardsChanges) {
+      auto& label = static_cast<Label&>(component);
+      label.setEditable(label.isEditableOnSingleClick(), label.isEditableOnDoubleClick(), lossOfFocusDiscardsChanges);
+  }),
   textEditor(_textEditor.distinctUntilChanged())
 {
     parent.addListener(this);
 
-    text.skip(1).subscribe(std::bind(&Label::setText, &parent, _1, sendNotificationSync)).disposedBy(disposeBag);
+    text.skip(1).subscribe([this, &parent](const String& text) {
+                    applyUpdate(TextUpdate, [&parent, text]() { parent.setText(text, sendNotificationSync); });
+                })
+        .disposedBy(disposeBag);
 
     showEditor.skip(1).withLatestFrom(_discardChangesWhenHidingEditor).subscribe([&parent](const std::tuple<bool, bool>& tuple) {
                                                                           if (std::get<0>(tuple))
@@ -130,44 +253,6 @@ LabelExtension::LabelExtension(Label& parent)
                                                                               parent.hideEditor(std::get<1>(tuple));
                                                                       })
         .disposedBy(disposeBag);
-
-    _font.subscribe(std::bind(&Label::setFont, &parent, _1)).disposedBy(disposeBag);
-    _justificationType.subscribe(std::bind(&Label::setJustificationType, &parent, _1)).disposedBy(disposeBag);
-    _borderSize.subscribe(std::bind(&Label::setBorderSize, &parent, _1)).disposedBy(disposeBag);
-
-    _attachedComponent.subscribe([&parent](const WeakReference<Component>& component) {
-                          parent.attachToComponent(component, parent.isAttachedOnLeft());
-                      })
-        .disposedBy(disposeBag);
-
-    _attachedOnLeft.subscribe([&parent](bool attachedOnLeft) {
-                       parent.attachToComponent(parent.getAttachedComponent(), attachedOnLeft);
-                   })
-        .disposedBy(disposeBag);
-
-    _minimumHorizontalScale.subscribe(std::bind(&Label::setMinimumHorizontalScale, &parent, _1)).disposedBy(disposeBag);
-
-    _keyboardType.subscribe([&parent](TextInputTarget::VirtualKeyboardType keyboardType) {
-                     parent.setKeyboardType(keyboardType);
-
-                     if (auto editor = parent.getCurrentTextEditor())
-                         editor->setKeyboardType(keyboardType);
-                 })
-        .disposedBy(disposeBag);
-
-    // Cannot use combineLatest for these, because changing something on the Slider directly doesn't update the subject
-    _editableOnSingleClick.subscribe([&parent](bool editableOnSingleClick) {
-                              parent.setEditable(editableOnSingleClick, parent.isEditableOnDoubleClick(), parent.doesLossOfFocusDiscardChanges());
-                          })
-        .disposedBy(disposeBag);
-    _editableOnDoubleClick.subscribe([&parent](bool editableOnDoubleClick) {
-                              parent.setEditable(parent.isEditableOnSingleClick(), editableOnDoubleClick, parent.doesLossOfFocusDiscardChanges());
-                          })
-        .disposedBy(disposeBag);
-    _lossOfFocusDiscardsChanges.subscribe([&parent](bool lossOfFocusDiscardsChanges) {
-                                   parent.setEditable(parent.isEditableOnSingleClick(), parent.isEditableOnDoubleClick(), lossOfFocusDiscardsChanges);
-                               })
-        .disposedBy(disposeBag);
 }
 
 LabelExtension::~LabelExtension()
@@ -176,6 +261,11 @@ LabelExtension::~LabelExtension()
     static_cast<Label&>(parent).removeListener(this);
 }
 
+size_t LabelExtension::getNumSubscriptions() const
+{
+    return ComponentExtension::getNumSubscriptions() + disposeBag.size();
+}
+
 void LabelExtension::labelTextChanged(Label* parent)
 {
     if (parent->getText() != text.getValue())
@@ -206,17 +296,35 @@ SliderExtension::SliderExtension(juce::Slider& parent,
   _dragging(false),
   _discardChangesWhenHidingTextBox(false),
   value(parent.getValue()),
-  minimum(_minimum),
-  maximum(_maximum),
+  // These read the other properties from the Slider, because they may have been changed on the Slider directly
+  minimum(parent, [](Component& component, const double& minimum) {
+      auto& slider = static_cast<Slider&>(component);
+      slider.setRange(minimum, slider.getMaximum(), slider.getInterval());
+  }),
+  maximum(parent, [](Component& component, const double& maximum) {
+      auto& slider = static_cast<Slider&>(component);
+      slider.setRange(slider.getMinimum(), maximum, slider.getInterval());
+  }),
   minValue(hasMultipleThumbs(parent) ? parent.getMinValue() : parent.getValue()),
   maxValue(hasMultipleThumbs(parent) ? parent.getMaxValue() : parent.getValue()),
-  doubleClickReturnValue(_doubleClickReturnValue),
-  interval(_interval),
-  skewFactorMidPoint(_skewFactorMidPoint),
+  doubleClickReturnValue(parent, [](Component& slider, const double& value) { static_cast<Slider&>(slider).setDoubleClickReturnValue(value != DBL_MAX, value); }),
+  interval(parent, [](Component& component, const double& interval) {
+      auto& slider = static_cast<Slider&>(component);
+      slider.setRange(slider.getMinimum(), slider.getMaximum(), interval);
+  }),
+  skewFactor(parent, [](Component& component, const double& factor) {
+      auto& slider = static_cast<Slider&>(component);
+      slider.setSkewFactor(factor, slider.isSymmetricSkew());
+  }),
+  symmetricSkew(parent, [](Component& component, const bool& symmetric) {
+      auto& slider = static_cast<Slider&>(component);
+      slider.setSkewFactor(slider.getSkewFactor(), symmetric);
+  }),
+  skewFactorMidPoint(parent, [](Component& slider, const double& midPoint) { static_cast<Slider&>(slider).setSkewFactorFromMidPoint(midPoint); }),
   dragging(_dragging.distinctUntilChanged()),
   thumbBeingDragged(dragging.map([&parent](bool) { return parent.getThumbBeingDragged(); })),
   showTextBox(_showTextBox),
-  textBoxIsEditable(_textBoxIsEditable),
+  textBoxIsEditable(parent, [](Component& slider, const bool& editable) { static_cast<Slider&>(slider).setTextBoxIsEditable(editable); }),
   discardChangesWhenHidingTextBox(_discardChangesWhenHidingTextBox),
   getValueFromText(getValueFromText),
   getTextFromValue(getTextFromValue)
@@ -228,20 +336,6 @@ SliderExtension::SliderExtension(juce::Slider& parent,
                  })
         .disposedBy(disposeBag);
 
-    // Cannot use combineLatest for these, because changing something on the Slider directly doesn't update the subject
-    _minimum.subscribe([&parent](double minimum) {
-                parent.setRange(minimum, parent.getMaximum(), parent.getInterval());
-            })
-        .disposedBy(disposeBag);
-    _maximum.subscribe([&parent](double maximum) {
-                parent.setRange(parent.getMinimum(), maximum, parent.getInterval());
-            })
-        .disposedBy(disposeBag);
-    _interval.subscribe([&parent](double interval) {
-                 parent.setRange(parent.getMinimum(), parent.getMaximum(), interval);
-             })
-        .disposedBy(disposeBag);
-
     minValue.skip(1).subscribe([&parent](double minValue) {
                         parent.setMinValue(minValue, sendNotificationSync, true);
                     })
@@ -252,13 +346,6 @@ SliderExtension::SliderExtension(juce::Slider& parent,
                     })
         .disposedBy(disposeBag);
 
-    _doubleClickReturnValue.subscribe([&parent](double value) {
-                               parent.setDoubleClickReturnValue(value != DBL_MAX, value);
-                           })
-        .disposedBy(disposeBag);
-
-    _skewFactorMidPoint.subscribe(std::bind(&Slider::setSkewFactorFromMidPoint, &parent, _1)).disposedBy(disposeBag);
-
     _showTextBox.withLatestFrom(_discardChangesWhenHidingTextBox).subscribe([&parent](const std::tuple<bool, bool>& tuple) {
                                                                      if (std::get<0>(tuple))
                                                                          parent.showTextBox();
@@ -266,8 +353,6 @@ SliderExtension::SliderExtension(juce::Slider& parent,
                                                                          parent.hideTextBox(std::get<1>(tuple));
                                                                  })
         .disposedBy(disposeBag);
-
-    _textBoxIsEditable.subscribe(std::bind(&Slider::setTextBoxIsEditable, &parent, _1)).disposedBy(disposeBag);
 }
 
 SliderExtension::~SliderExtension()
@@ -276,6 +361,11 @@ SliderExtension::~SliderExtension()
     static_cast<Slider&>(parent).removeListener(this);
 }
 
+size_t SliderExtension::getNumSubscriptions() const
+{
+    return ComponentExtension::getNumSubscriptions() + disposeBag.size();
+}
+
 void SliderExtension::sliderValueChanged(Slider* slider)
 {
     if (slider->getValue() != value.getValue())
@@ -1,5 +1,9 @@
 #pragma once
 
+namespace detail {
+class ComponentUpdateBatcher;
+}
+
 /**
  Adds reactive extensions to a `juce::Component`.
  
@@ -29,8 +33,44 @@ public:
     /// Returns an Observer that controls the colour for the given colourId.
     Observer<juce::Colour> colour(int colourId) const;
 
+    /**
+     If enabled, values pushed to `bounds`, `visible`, `colour` (and `text` of a `LabelExtension`) aren't applied to the `Component` immediately. Instead, the latest value of each property is applied once per display frame (@see Scheduler::messageThreadFrameAligned).
+     
+     Use this if the properties change several times per frame (e.g. during animations, or if they're combined from several Observables), to avoid redundant layout and repaint passes. The subjects are still updated immediately. Disabling it applies the pending values right away.
+     
+     It's disabled by default. Must be called on the message thread.
+     */
+    void setFrameCoalescingEnabled(bool shouldBeEnabled) const;
+
+    /// Returns the number of subscriptions that this extension holds to apply values to the `Component`. It should stay constant after setting up the `Component`. If it grows over time, something subscribes repeatedly.
+    virtual size_t getNumSubscriptions() const;
+
+protected:
+    /// \cond internal
+    // Keys for applyUpdate. Colour IDs are used as keys for colours.
+    enum UpdateKey : int {
+        BoundsUpdate = -1,
+        VisibleUpdate = -2,
+        TextUpdate = -3
+    };
+
+    // Applies an update to the Component, either immediately or on the next frame (replacing a pending update with the same key). Only deferred updates are stored in a std::function.
+    template<typename Update>
+    void applyUpdate(int key, Update&& update) const
+    {
+        if (isFrameCoalescingEnabled())
+            deferUpdate(key, std::function<void()>(std::forward<Update>(update)));
+        else
+            update();
+    }
+    /// \endcond
+
 private:
     const std::unique_ptr<DisposeBag> disposeBag;
+    const std::unique_ptr<detail::ComponentUpdateBatcher> updateBatcher;
+
+    bool isFrameCoalescingEnabled() const;
+    void deferUpdate(int key, std::function<void()>&& update) const;
 
     // Overrides
     void componentMovedOrResized(juce::Component&, bool, bool) override;
@@ -47,8 +87,6 @@ private:
 class ButtonExtension : public ComponentExtension, private juce::Button::Listener
 {
     const PublishSubject<Empty> _clicked;
-    const PublishSubject<juce::String> _text;
-    const PublishSubject<juce::String> _tooltip;
 
 public:
     /// Creates a new instance for a given `Button`.
@@ -66,10 +104,12 @@ public:
     const BehaviorSubject<bool> toggleState;
 
     /// Controls the button text.
-    const Observer<juce::String> text;
+    const LazyObserver<juce::String> text;
 
     /// Controls the tooltip.
-    const Observer<juce::String> tooltip;
+    const LazyObserver<juce::String> tooltip;
+
+    size_t getNumSubscriptions() const override;
 
 private:
     DisposeBag disposeBag;
@@ -87,22 +127,17 @@ private:
  */
 class ImageComponentExtension : public ComponentExtension
 {
-    const PublishSubject<juce::Image> _image;
-    const PublishSubject<juce::RectanglePlacement> _imagePlacement;
-
 public:
     /// Creates a new instance for a given `ImageComponent`.
     ImageComponentExtension(juce::ImageComponent& parent);
 
     /// Controls the displayed image.
-    const Observer<juce::Image> image;
+    const LazyObserver<juce::Image> image;
 
     /// Controls the placement of the image.
-    const Observer<juce::RectanglePlacement> imagePlacement;
+    const LazyObserver<juce::RectanglePlacement> imagePlacement;
 
 private:
-    DisposeBag disposeBag;
-    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageComponentExtension)
 };
 
@@ -114,16 +149,6 @@ private:
 class LabelExtension : public ComponentExtension, private juce::Label::Listener
 {
     const BehaviorSubject<bool> _discardChangesWhenHidingEditor;
-    const PublishSubject<juce::Font> _font;
-    const PublishSubject<juce::Justification> _justificationType;
-    const PublishSubject<juce::BorderSize<int>> _borderSize;
-    const PublishSubject<juce::WeakReference<juce::Component>> _attachedComponent;
-    const PublishSubject<bool> _attachedOnLeft;
-    const PublishSubject<float> _minimumHorizontalScale;
-    const PublishSubject<juce::TextInputTarget::VirtualKeyboardType> _keyboardType;
-    const PublishSubject<bool> _editableOnSingleClick;
-    const PublishSubject<bool> _editableOnDoubleClick;
-    const PublishSubject<bool> _lossOfFocusDiscardsChanges;
     const BehaviorSubject<juce::WeakReference<juce::Component>> _textEditor;
 
 public:
@@ -142,38 +167,40 @@ public:
     const Observer<bool> discardChangesWhenHidingEditor;
 
     /// Controls the `Label` font.
-    const Observer<juce::Font> font;
+    const LazyObserver<juce::Font> font;
 
     /// Controls the `Label` justification.
-    const Observer<juce::Justification> justificationType;
+    const LazyObserver<juce::Justification> justificationType;
 
     /// Controls the `Label` border size.
-    const Observer<juce::BorderSize<int>> borderSize;
+    const LazyObserver<juce::BorderSize<int>> borderSize;
 
     /// Attaches the `Label` to another Component. Pass `nullptr` to detach it.
-    const Observer<juce::WeakReference<juce::Component>> attachedComponent;
+    const LazyObserver<juce::WeakReference<juce::Component>> attachedComponent;
 
     /// Controls whether the `attachedComponent` should be attached on the left.
-    const Observer<bool> attachedOnLeft;
+    const LazyObserver<bool> attachedOnLeft;
 
     /// Controls the minimum amount that the `Label` font can be squashed horizontally before it starts using ellipsis.
-    const Observer<float> minimumHorizontalScale;
+    const LazyObserver<float> minimumHorizontalScale;
 
     /// Controls the keyboard type to use in the `TextEditor`. If the editor is currently open, the type is changed for the open editor.
-    const Observer<juce::TextInputTarget::VirtualKeyboardType> keyboardType;
+    const LazyObserver<juce::TextInputTarget::VirtualKeyboardType> keyboardType;
 
     /// Controls whether clicking the `Label` opens a `TextEditor`.
-    const Observer<bool> editableOnSingleClick;
+    const LazyObserver<bool> editableOnSingleClick;
 
     /// Controls whether double-clicking the `Label` opens a `TextEditor`.
-    const Observer<bool> editableOnDoubleClick;
+    const LazyObserver<bool> editableOnDoubleClick;
 
     /// Controls whether unfocussing the `TextEditor` discards changes.
-    const Observer<bool> lossOfFocusDiscardsChanges;
+    const LazyObserver<bool> lossOfFocusDiscardsChanges;
 
     /// The currently visible `TextEditor`, or `nullptr` if no editor is showing.
     const Observable<juce::WeakReference<juce::Component>> textEditor;
 
+    size_t getNumSubscriptions() const override;
+
 private:
     DisposeBag disposeBag;
 
@@ -192,15 +219,9 @@ private:
  */
 class SliderExtension : public ComponentExtension, private juce::Slider::Listener
 {
-    PublishSubject<double> _minimum;
-    PublishSubject<double> _maximum;
-    PublishSubject<double> _doubleClickReturnValue;
-    PublishSubject<double> _interval;
-    PublishSubject<double> _skewFactorMidPoint;
     BehaviorSubject<bool> _dragging;
     BehaviorSubject<bool> _discardChangesWhenHidingTextBox;
     PublishSubject<bool> _showTextBox;
-    PublishSubject<bool> _textBoxIsEditable;
 
 public:
     /// Creates a new instance for a given `Slider`.
@@ -214,10 +235,10 @@ public:
     const BehaviorSubject<double> value;
 
     /// Controls the minimum `Slider` value.
-    const Observer<double> minimum;
+    const LazyObserver<double> minimum;
 
     /// Controls the maximum `Slider` value.
-    const Observer<double> maximum;
+    const LazyObserver<double> maximum;
 
     /// Control the lowest value in a `Slider` with multiple thumbs. **Do not push values if the `Slider` has just one thumb.**
     const BehaviorSubject<double> minValue;
@@ -226,13 +247,19 @@ public:
     const BehaviorSubject<double> maxValue;
 
     /// Controls the default value of the `Slider`.​ Pass `DBL_MAX` to prevent double-clicking from resetting the slider.
-    const Observer<double> doubleClickReturnValue;
+    const LazyObserver<double> doubleClickReturnValue;
 
     /// Controls the step size for values.
-    const Observer<double> interval;
+    const LazyObserver<double> interval;
+
+    /// Controls the `Slider` skew factor.
+    const LazyObserver<double> skewFactor;
+
+    /// Controls whether the `Slider` skew is symmetric around the centre of the range.
+    const LazyObserver<bool> symmetricSkew;
 
     /// Sets the mid point for the `Slider` skew factor.
-    const Observer<double> skewFactorMidPoint;
+    const LazyObserver<double> skewFactorMidPoint;
 
     /// Whether the `Slider` is currently being dragged.
     const Observable<bool> dragging;
@@ -244,7 +271,7 @@ public:
     const Observer<bool> showTextBox;
 
     /// Controls whether the text-box is editable.
-    const Observer<bool> textBoxIsEditable;
+    const LazyObserver<bool> textBoxIsEditable;
 
     /// Controls whether changes are discarded when hiding the text-box. The default is `false`.
     const Observer<bool> discardChangesWhenHidingTextBox;
@@ -255,6 +282,8 @@ public:
     /// Controls how a `Slider` value is displayed as a `String`.​ If you don't use this, the slider will use its `getTextFromValue` member function.
     const Observer<std::function<juce::String(double)>> getTextFromValue;
 
+    size_t getNumSubscriptions() const override;
+
 private:
     DisposeBag disposeBag;
 
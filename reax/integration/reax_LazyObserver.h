@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ Controls a property of a `juce::Component`, like the font of a `Label`. Used by the GUI extensions for properties that can only be set.
+
+ It has the interface of an `Observer`, but is more lightweight: As long as only onNext is called, it applies the values to the `Component` directly. The `Observer` (and the subject behind it) is only created when it's needed for the first time, e.g. when an Observable subscribes to it:
+
+     someObservable.subscribe(myLabel.rx.font);
+
+ So properties that are never used don't cost any subjects or subscriptions.
+
+ A LazyObserver converts to an `Observer` implicitly. Template functions can't deduce `T` from that conversion, so call asObserver() to pass it where an `Observer<T>` is deduced.
+
+ Must only be used on the message thread.
+ */
+template<typename T>
+class LazyObserver
+{
+public:
+    /// A function that applies a new value to the `Component`.
+    typedef void (*Apply)(juce::Component&, const T&);
+
+    /// Creates a new instance, which calls `apply` with `component` and the new value.
+    LazyObserver(juce::Component& component, Apply apply)
+    : component(component),
+      apply(apply)
+    {}
+
+    ///@{
+    /// Applies a new value to the `Component`. Values are ignored after onError or onCompleted.
+    void onNext(const T& value) const
+    {
+        // Once the Observer exists, values go through it, so it can stop them after onError or onCompleted
+        if (observer)
+            observer->subject.onNext(value);
+        else
+            apply(component, value);
+    }
+
+    void onNext(T&& value) const
+    {
+        if (observer)
+            observer->subject.onNext(std::move(value));
+        else
+            apply(component, value);
+    }
+    ///@}
+
+    /// Notifies the Observer that an error has occurred, like Observer::onError.
+    void onError(std::exception_ptr error) const
+    {
+        asObserver().onError(error);
+    }
+
+    /// Notifies the Observer that no more values will be pushed. Values are ignored afterwards.
+    void onCompleted() const
+    {
+        asObserver().onCompleted();
+    }
+
+    /// Returns an Observer that applies its values to the `Component`. It's created on the first call, and stops applying values when the LazyObserver is destroyed.
+    Observer<T> asObserver() const
+    {
+        if (!observer) {
+            observer.reset(new LazyState());
+
+            juce::Component& component = this->component;
+            const Apply apply = this->apply;
+            observer->subject.subscribe([&component, apply](const T& value) {
+                                 apply(component, value);
+                             })
+                .disposedBy(observer->disposeBag);
+        }
+
+        return observer->subject;
+    }
+
+    /// Converts to an `Observer`. @see asObserver
+    operator Observer<T>() const
+    {
+        return asObserver();
+    }
+
+private:
+    struct LazyState
+    {
+        PublishSubject<T> subject;
+        DisposeBag disposeBag;
+    };
+
+    juce::Component& component;
+    const Apply apply;
+    mutable std::unique_ptr<LazyState> observer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LazyObserver)
+};
@@ -1,3 +1,37 @@
+namespace detail {
+// Identifiers are pooled, so they can be hashed (and compared) by their pointer, without looking at the characters
+struct IdentifierHash
+{
+    size_t operator()(const Identifier& identifier) const
+    {
+        return std::hash<const void*>()(identifier.getCharPointer().getAddress());
+    }
+};
+
+// Returns the IDs of the AudioProcessor's parameters that belong to the AudioProcessorValueTreeState, in the AudioProcessor's order. The IDs are read from the state's child trees, so this works without RTTI.
+StringArray getParameterIDs(AudioProcessorValueTreeState& state)
+{
+    std::unordered_map<const AudioProcessorParameter*, String> ids;
+    for (int i = 0; i < state.state.getNumChildren(); ++i) {
+        const String parameterID = state.state.getChild(i).getProperty("id").toString();
+        if (parameterID.isEmpty())
+            continue;
+
+        if (const AudioProcessorParameter* parameter = state.getParameter(parameterID))
+            ids[parameter] = parameterID;
+    }
+
+    StringArray parameterIDs;
+    for (auto* parameter : state.processor.getParameters()) {
+        const auto it = ids.find(parameter);
+        if (it != ids.end())
+            parameterIDs.add(it->second);
+    }
+
+    return parameterIDs;
+}
+}
+
 ValueExtension::ValueExtension(const Value& inputValue)
 : subject(inputValue.getValue()),
   value(inputValue)
@@ -20,6 +54,56 @@ void ValueExtension::valueChanged(Value&)
         subject.onNext(value.getValue());
 }
 
+struct ValueTreeExtension::Impl
+{
+    // The lazily created subjects of propertyChanged
+    std::unordered_map<Identifier, PublishSubject<ValueTree>, detail::IdentifierHash> properties;
+};
+
+ValueTreeExtension::ValueTreeExtension(const ValueTree& inputTree)
+: tree(inputTree),
+  childAdded(_childAdded),
+  childRemoved(_childRemoved),
+  childOrderChanged(_childOrderChanged),
+  impl(new Impl())
+{
+    // tree is a member variable, so no need to call removeListener in destructor
+    tree.addListener(this);
+}
+
+ValueTreeExtension::~ValueTreeExtension() {}
+
+Observable<ValueTree> ValueTreeExtension::propertyChanged(const Identifier& property) const
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    return impl->properties[property];
+}
+
+void ValueTreeExtension::valueTreePropertyChanged(ValueTree& treeWhosePropertyHasChanged, const Identifier& property)
+{
+    // Don't create a subject for properties that nobody observes
+    const auto it = impl->properties.find(property);
+    if (it != impl->properties.end())
+        it->second.onNext(treeWhosePropertyHasChanged);
+}
+
+void ValueTreeExtension::valueTreeChildAdded(ValueTree& parentTree, ValueTree& childWhichHasBeenAdded)
+{
+    _childAdded.onNext(ChildChange{ parentTree, childWhichHasBeenAdded, parentTree.indexOf(childWhichHasBeenAdded) });
+}
+
+void ValueTreeExtension::valueTreeChildRemoved(ValueTree& parentTree, ValueTree& childWhichHasBeenRemoved, int indexFromWhichChildWasRemoved)
+{
+    _childRemoved.onNext(ChildChange{ parentTree, childWhichHasBeenRemoved, indexFromWhichChildWasRemoved });
+}
+
+void ValueTreeExtension::valueTreeChildOrderChanged(ValueTree& parentTreeWhoseChildrenHaveMoved, int oldIndex, int newIndex)
+{
+    _childOrderChanged.onNext(ChildOrderChange{ parentTreeWhoseChildrenHaveMoved, oldIndex, newIndex });
+}
+
 AudioProcessorExtension::AudioProcessorExtension(AudioProcessor& parent)
 : parent(parent),
   _processorChanged(1),
@@ -33,6 +117,14 @@ AudioProcessorExtension::~AudioProcessorExtension()
     parent.removeListener(this);
 }
 
+AudioBlockSource& AudioProcessorExtension::audioBlocks(int numSlots, int maxChannels, int maxSamples) const
+{
+    // Create the sources on the message thread, not on the audio thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    return *audioBlockSources.add(new AudioBlockSource(numSlots, maxChannels, maxSamples));
+}
+
 void AudioProcessorExtension::audioProcessorChanged(AudioProcessor*)
 {
     // If there's already a value in the queue, it will be emitted soon. So there's no need to add another one.
@@ -41,21 +133,221 @@ void AudioProcessorExtension::audioProcessorChanged(AudioProcessor*)
 
 struct AudioProcessorValueTreeStateExtension::Impl
 {
-    std::map<String, Reactive<Value>> parameterValues;
+    // Receives parameter changes on any thread (possibly the audio thread), and emits only the latest value on the message thread
+    class ParameterSource : private AudioProcessorValueTreeState::Listener, private AsyncUpdater
+    {
+    public:
+        ParameterSource(AudioProcessorValueTreeState& state, const String& parameterID)
+        : subject(getRawValue(state, parameterID)),
+          state(state),
+          parameterID(parameterID),
+          latestValue(subject.getValue())
+        {
+            state.addParameterListener(parameterID, this);
+        }
+
+        ~ParameterSource()
+        {
+            state.removeParameterListener(parameterID, this);
+            cancelPendingUpdate();
+        }
+
+        const BehaviorSubject<float> subject;
+
+    private:
+        AudioProcessorValueTreeState& state;
+        const String parameterID;
+        std::atomic<float> latestValue;
+
+        static float getRawValue(AudioProcessorValueTreeState& state, const String& parameterID)
+        {
+            const auto rawValue = state.getRawParameterValue(parameterID);
+
+            // There's no parameter with the given ID!
+            jassert(rawValue != nullptr);
+
+            return (rawValue != nullptr ? static_cast<float>(*rawValue) : 0.f);
+        }
+
+        void parameterChanged(const String&, float newValue) override
+        {
+            // If there's an update pending already, it will emit this value
+            latestValue.store(newValue);
+            triggerAsyncUpdate();
+        }
+
+        void handleAsyncUpdate() override
+        {
+            const float newValue = latestValue.load();
+            if (newValue != subject.getValue())
+                subject.onNext(newValue);
+        }
+    };
+
+    // Collects the changes of all parameters in a dirty bitmap, and emits them as a single batch on the message thread
+    class ChangedParameters : private AsyncUpdater
+    {
+    public:
+        explicit ChangedParameters(AudioProcessorValueTreeState& state)
+        : state(state)
+        {
+            for (const auto& parameterID : detail::getParameterIDs(state))
+                listeners.emplace_back(new IndexListener(*this, static_cast<int>(listeners.size()), parameterID));
+
+            latestValues = std::vector<std::atomic<float>>(listeners.size());
+            dirtyBits = std::vector<std::atomic<uint32>>((listeners.size() + BitsPerWord - 1) / BitsPerWord);
+            changes.resize(listeners.size());
+
+            for (auto& listener : listeners)
+                state.addParameterListener(listener->parameterID, listener.get());
+        }
+
+        ~ChangedParameters()
+        {
+            for (auto& listener : listeners)
+                state.removeParameterListener(listener->parameterID, listener.get());
+
+            cancelPendingUpdate();
+        }
+
+        PublishSubject<Span<ParameterChange>> subject;
+
+    private:
+        static const size_t BitsPerWord = 32;
+
+        // Knows the index of its parameter, so parameter changes don't need a lookup
+        struct IndexListener : public AudioProcessorValueTreeState::Listener
+        {
+            IndexListener(ChangedParameters& owner, int index, const String& parameterID)
+            : owner(owner),
+              index(index),
+              parameterID(parameterID)
+            {}
+
+            void parameterChanged(const String&, float newValue) override
+            {
+                owner.markChanged(index, newValue);
+            }
+
+            ChangedParameters& owner;
+            const int index;
+            const String parameterID;
+        };
+
+        AudioProcessorValueTreeState& state;
+        std::vector<std::unique_ptr<IndexListener>> listeners;
+        std::vector<std::atomic<float>> latestValues;
+        std::vector<std::atomic<uint32>> dirtyBits;
+        // Reused memory for the emitted batches
+        std::vector<ParameterChange> changes;
+
+        // May be called on any thread, including the audio thread
+        void markChanged(int index, float newValue)
+        {
+            const auto i = static_cast<size_t>(index);
+            latestValues[i].store(newValue);
+            dirtyBits[i / BitsPerWord].fetch_or(uint32(1) << (i % BitsPerWord));
+            triggerAsyncUpdate();
+        }
+
+        void handleAsyncUpdate() override
+        {
+            size_t numChanges = 0;
+
+            for (size_t word = 0; word < dirtyBits.size(); ++word) {
+                uint32 bits = dirtyBits[word].exchange(0);
+
+                for (size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+                    if ((bits & 1) == 0)
+                        continue;
+
+                    const size_t i = word * BitsPerWord + bit;
+                    auto& change = changes[numChanges++];
+                    change.parameterIndex = listeners[i]->index;
+                    change.parameterID = listeners[i]->parameterID;
+                    change.value = latestValues[i].load();
+                }
+            }
+
+            if (numChanges > 0)
+                subject.onNext(Span<ParameterChange>(changes.data(), numChanges));
+        }
+    };
+
+    // The lazily created subjects of a parameter
+    struct Parameter
+    {
+        std::unique_ptr<Reactive<Value>> value;
+        std::unique_ptr<ParameterSource> source;
+    };
+
+    explicit Impl(AudioProcessorValueTreeState& state)
+    : state(state)
+    {}
+
+    Reactive<Value>& getValue(const Identifier& parameterID)
+    {
+        auto& parameter = parameters[parameterID];
+        if (!parameter.value)
+            parameter.value.reset(new Reactive<Value>(state.getParameterAsValue(parameterID)));
+
+        return *parameter.value;
+    }
+
+    ParameterSource& getSource(const Identifier& parameterID)
+    {
+        auto& parameter = parameters[parameterID];
+        if (!parameter.source)
+            parameter.source.reset(new ParameterSource(state, parameterID.toString()));
+
+        return *parameter.source;
+    }
+
+    AudioProcessorValueTreeState& state;
+    std::unordered_map<Identifier, Parameter, detail::IdentifierHash> parameters;
+    std::unique_ptr<ChangedParameters> changedParameters;
 };
 
 AudioProcessorValueTreeStateExtension::AudioProcessorValueTreeStateExtension(AudioProcessorValueTreeState& parent)
-: impl(new Impl()),
+: impl(new Impl(parent)),
   parent(parent)
 {}
 
 AudioProcessorValueTreeStateExtension::~AudioProcessorValueTreeStateExtension() {}
 
-BehaviorSubject<var> AudioProcessorValueTreeStateExtension::parameterValue(StringRef parameterID) const
+BehaviorSubject<var> AudioProcessorValueTreeStateExtension::parameterValue(const Identifier& parameterID) const
 {
     // Create a Reactive<Value> for the parameter, if not already done
-    if (impl->parameterValues.find(parameterID) == impl->parameterValues.end())
-        impl->parameterValues.emplace(parameterID, parent.getParameterAsValue(parameterID));
+    return impl->getValue(parameterID).rx.subject;
+}
+
+Observable<float> AudioProcessorValueTreeStateExtension::parameterObservable(const Identifier& parameterID) const
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    return impl->getSource(parameterID).subject;
+}
+
+Observable<Span<AudioProcessorValueTreeStateExtension::ParameterChange>> AudioProcessorValueTreeStateExtension::changedParameters() const
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (!impl->changedParameters)
+        impl->changedParameters.reset(new Impl::ChangedParameters(parent));
+
+    return impl->changedParameters->subject;
+}
+
+void AudioProcessorValueTreeStateExtension::prebindAll() const
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
 
-    return impl->parameterValues.at(parameterID).rx.subject;
+    for (const auto& id : detail::getParameterIDs(parent)) {
+        const Identifier parameterID(id);
+        impl->getValue(parameterID);
+        impl->getSource(parameterID);
+    }
 }
@@ -23,6 +23,96 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ValueExtension)
 };
 
+/**
+ Adds reactive extensions to a `juce::ValueTree`.
+
+ It uses a single `ValueTree::Listener` for the whole tree, so it's cheap even for large trees: Instead of one `Value` (with a listener and a subject) per property, the Observables emit incremental changes of the tree and all of its descendants. Memory only grows with the number of properties that are observed, not with the size of the tree:
+
+     ValueTreeExtension document(documentTree);
+
+     document.propertyChanged("name").subscribe([](const ValueTree& node) {
+         // node is the tree (or descendant) whose 'name' property has changed
+     });
+
+     document.childAdded.subscribe([](const ValueTreeExtension::ChildChange& change) {
+         // Insert a view for change.child at change.index
+     });
+
+ All Observables emit synchronously on the thread that changes the tree (which should be the message thread).
+ */
+class ValueTreeExtension : private juce::ValueTree::Listener
+{
+public:
+    /// A child that has been added to or removed from the tree or one of its descendants.
+    struct ChildChange
+    {
+        /// The tree whose children have changed.
+        juce::ValueTree parent;
+        juce::ValueTree child;
+        /// The index of the child in the parent. For removed children, this is the index from which it has been removed.
+        int index;
+
+        bool operator==(const ChildChange& other) const
+        {
+            return (parent == other.parent && child == other.child && index == other.index);
+        }
+    };
+
+    /// A child that has been moved within the tree or one of its descendants.
+    struct ChildOrderChange
+    {
+        /// The tree whose children have been reordered.
+        juce::ValueTree parent;
+        int oldIndex;
+        int newIndex;
+
+        bool operator==(const ChildOrderChange& other) const
+        {
+            return (parent == other.parent && oldIndex == other.oldIndex && newIndex == other.newIndex);
+        }
+    };
+
+    /// Creates a new instance for a given `ValueTree`. The extension refers to the **shared data** of `inputTree`, so it notices changes from any `ValueTree` that refers to the same data.
+    ValueTreeExtension(const juce::ValueTree& inputTree);
+
+    ~ValueTreeExtension();
+
+    /**
+     Returns an Observable that emits the tree (or descendant) whose property with the given name has changed, or has been removed.
+
+     The subjects are created lazily, once per property name, and looked up by the `Identifier`'s pointer. In frequently called code, keep the `Identifier` (instead of passing a string literal). Must be called on the message thread.
+     */
+    Observable<juce::ValueTree> propertyChanged(const juce::Identifier& property) const;
+
+private:
+    juce::ValueTree tree;
+    PublishSubject<ChildChange> _childAdded;
+    PublishSubject<ChildChange> _childRemoved;
+    PublishSubject<ChildOrderChange> _childOrderChanged;
+
+public:
+    /// Emits whenever a child has been added to the tree or one of its descendants.
+    const Observable<ChildChange> childAdded;
+
+    /// Emits whenever a child has been removed from the tree or one of its descendants.
+    const Observable<ChildChange> childRemoved;
+
+    /// Emits whenever the children of the tree or one of its descendants have been reordered.
+    const Observable<ChildOrderChange> childOrderChanged;
+
+private:
+    struct Impl;
+    const juce::ScopedPointer<Impl> impl;
+
+    void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree& parentTree, juce::ValueTree& childWhichHasBeenRemoved, int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(juce::ValueTree& parentTreeWhoseChildrenHaveMoved, int oldIndex, int newIndex) override;
+    void valueTreeParentChanged(juce::ValueTree&) override {}
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ValueTreeExtension)
+};
+
 /**
  Adds reactive extensions to an `AudioProcessor`.
  
@@ -45,7 +135,16 @@ public:
      */
     const Observable<Empty> processorChanged;
 
+    /**
+     Creates an AudioBlockSource with a preallocated pool of `numSlots` audio buffers (with `maxChannels` channels and `maxSamples` samples each), for passing audio from `processBlock` to the editor without copying it on the message thread.
+
+     Call this once per stream, on the message thread (e.g. in the processor's constructor), and keep the returned reference. The source lives as long as this extension. @see AudioBlockSource
+     */
+    AudioBlockSource& audioBlocks(int numSlots, int maxChannels, int maxSamples) const;
+
 private:
+    // Created by audioBlocks
+    mutable juce::OwnedArray<AudioBlockSource> audioBlockSources;
     DisposeBag disposeBag;
     
     void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
@@ -61,6 +160,21 @@ private:
  */
 class AudioProcessorValueTreeStateExtension {
 public:
+    /// A change of a parameter's value, emitted by changedParameters.
+    struct ParameterChange
+    {
+        /// The index of the parameter, counting only the `AudioProcessor`'s parameters that belong to the `AudioProcessorValueTreeState`.
+        int parameterIndex;
+        juce::String parameterID;
+        /// The new (denormalised) value.
+        float value;
+
+        bool operator==(const ParameterChange& other) const
+        {
+            return (parameterIndex == other.parameterIndex && parameterID == other.parameterID && value == other.value);
+        }
+    };
+
     /// Creates a new instance for a given `AudioProcessorValueTreeState`.
     AudioProcessorValueTreeStateExtension(juce::AudioProcessorValueTreeState& parent);
     
@@ -72,8 +186,37 @@ public:
      If this is called early in the app lifecycle, the subject contains `var()` for a short amount of time, and not the parameter's default value. This is because JUCE updates the `ValueTree` asynchronously.
      
      Parameter values can be changed from the audio thread; in this case the subject's `Observable` side emits asynchronously.
+     
+     The subjects are looked up by the `Identifier`'s pointer, without comparing strings. In frequently called code, keep the `Identifier` (instead of passing a string literal), so it doesn't need to be looked up in the `StringPool` each time.
+     */
+    BehaviorSubject<juce::var> parameterValue(const juce::Identifier& parameterID) const;
+
+    /**
+     Returns an Observable that emits the (denormalised) value of the parameter with the given ID.
+     
+     Unlike parameterValue, this doesn't go through the `ValueTree`: It listens to the parameter directly, and emits the current value immediately when subscribing. Parameter changes from the audio thread (e.g. host automation) are coalesced: The Observable emits asynchronously on the message thread, and only the latest value if the parameter has changed several times in between.
+     
+     Must be called on the message thread.
+     */
+    Observable<float> parameterObservable(const juce::Identifier& parameterID) const;
+
+    /**
+     Returns an Observable that emits all parameters that have changed since the last emission, as a single batch.
+     
+     Use this instead of one subscription per parameter if there are many parameters: When a preset is loaded, a view can refresh in a single pass. Parameter changes on any thread (including the audio thread) just mark the parameter as changed. The Observable emits asynchronously on the message thread, at most once per message loop iteration, with the latest value of each changed parameter.
+     
+     The batch is **only valid during the `onNext` call.** @see Span
+     
+     Covers the parameters that are in the `AudioProcessorValueTreeState`'s `state` when this is called for the first time. Must be called on the message thread.
+     */
+    Observable<Span<ParameterChange>> changedParameters() const;
+
+    /**
+     Creates the subjects for parameterValue and parameterObservable for all parameters in the `AudioProcessorValueTreeState`'s `state`, so they aren't created lazily later.
+     
+     Call this when constructing your editor, so the first interaction with a control doesn't have to set up its subjects. Must be called on the message thread.
      */
-    BehaviorSubject<juce::var> parameterValue(const juce::StringRef parameterID) const;
+    void prebindAll() const;
     
 private:
     struct Impl;
@@ -0,0 +1,129 @@
+namespace {
+// Checks whether the range maps values like a plain NormalisableRange with the same start, end, interval and skew, i.e. doesn't use custom conversion functions
+bool hasDefaultMapping(const NormalisableRange<float>& range)
+{
+    const NormalisableRange<float> defaultRange(range.start, range.end, range.interval, range.skew, range.symmetricSkew);
+
+    for (float proportion : { 0.f, 0.25f, 0.5f, 0.75f, 1.f }) {
+        if (std::abs(range.convertFrom0to1(proportion) - defaultRange.convertFrom0to1(proportion)) > 1e-4f * std::abs(range.end - range.start))
+            return false;
+    }
+
+    return true;
+}
+}
+
+ParameterAttachment::ParameterAttachment(AudioProcessorParameter& parameter, const NormalisableRange<float>& range, SliderExtension& slider)
+: parameter(parameter),
+  range(range),
+  slider(slider),
+  latestValue(parameter.getValue())
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    // The Slider can only map its values with a start, end, interval and skew. Custom conversion functions aren't supported!
+    jassert(hasDefaultMapping(range));
+
+    slider.minimum.onNext(range.start);
+    slider.maximum.onNext(range.end);
+    if (range.interval > 0.f)
+        slider.interval.onNext(range.interval);
+    if (range.symmetricSkew)
+        slider.symmetricSkew.onNext(true);
+    if (range.skew != 1.f)
+        slider.skewFactor.onNext(range.skew);
+
+    handleAsyncUpdate();
+
+    slider.value.skip(1).subscribe([this](double newValue) { sliderValueChanged(newValue); }).disposedBy(disposeBag);
+    slider.dragging.skip(1).subscribe([this](bool dragging) { draggingChanged(dragging); }).disposedBy(disposeBag);
+
+    parameter.addListener(this);
+}
+
+ParameterAttachment::ParameterAttachment(AudioProcessorValueTreeState& state, const String& parameterID, SliderExtension& slider)
+: ParameterAttachment(getParameter(state, parameterID), state.getParameterRange(parameterID), slider)
+{}
+
+ParameterAttachment::~ParameterAttachment()
+{
+    parameter.removeListener(this);
+    cancelPendingUpdate();
+
+    if (isDragging)
+        parameter.endChangeGesture();
+}
+
+AudioProcessorParameter& ParameterAttachment::getParameter(AudioProcessorValueTreeState& state, const String& parameterID)
+{
+    auto parameter = state.getParameter(parameterID);
+
+    // There's no parameter with the given ID!
+    jassert(parameter != nullptr);
+
+    return *parameter;
+}
+
+void ParameterAttachment::sliderValueChanged(double newValue)
+{
+    // Don't send the parameter's own value back to the host
+    if (isUpdatingSlider)
+        return;
+
+    const float normalisedValue = range.convertTo0to1(static_cast<float>(newValue));
+    if (normalisedValue == parameter.getValue())
+        return;
+
+    latestValue.store(normalisedValue);
+
+    if (isDragging)
+        setParameterValue(normalisedValue);
+    else {
+        parameter.beginChangeGesture();
+        setParameterValue(normalisedValue);
+        parameter.endChangeGesture();
+    }
+}
+
+void ParameterAttachment::setParameterValue(float normalisedValue)
+{
+    // The parameter calls parameterValueChanged synchronously, which must not send the value back to the Slider
+    const ScopedValueSetter<bool> settingParameter(isSettingParameter, true);
+    parameter.setValueNotifyingHost(normalisedValue);
+}
+
+void ParameterAttachment::draggingChanged(bool dragging)
+{
+    if (dragging == isDragging)
+        return;
+
+    isDragging = dragging;
+
+    if (dragging)
+        parameter.beginChangeGesture();
+    else
+        parameter.endChangeGesture();
+}
+
+void ParameterAttachment::parameterValueChanged(int, float newValue)
+{
+    // Ignore the echo of setParameterValue. Changes on other threads are never an echo.
+    if (MessageManager::existsAndIsCurrentThread() && isSettingParameter)
+        return;
+
+    // If there's an update pending already, it will apply this value
+    latestValue.store(newValue);
+    triggerAsyncUpdate();
+}
+
+void ParameterAttachment::handleAsyncUpdate()
+{
+    // Compare normalised values, so a Slider value that the range rounds (e.g. to its interval) isn't replaced by the rounded value
+    const float normalisedValue = latestValue.load();
+    if (normalisedValue == range.convertTo0to1(static_cast<float>(slider.value.getValue())))
+        return;
+
+    const ScopedValueSetter<bool> updatingSlider(isUpdatingSlider, true);
+    slider.value.onNext(range.convertFrom0to1(normalisedValue));
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ Connects a `Slider` to an `AudioProcessorParameter`, without going through a `juce::Value` and the `ValueTree`.
+
+ Slider values are written straight to the parameter (with `setValueNotifyingHost`). While the `Slider` is dragged, the changes are wrapped in a single `beginChangeGesture`/`endChangeGesture` pair, so the host records one automation gesture per drag. Changes that aren't part of a drag (e.g. typing into the text box or double-clicking) get a gesture each.
+
+ Parameter changes from any thread (e.g. host automation on the audio thread) are stored in an atomic, and applied to the `Slider` asynchronously on the message thread. If the parameter changes several times in between, only the latest value is applied.
+
+     Reactive<Slider> gainSlider;
+     ParameterAttachment gainAttachment(processor.state, "gain", gainSlider.rx);
+
+ The range, interval, skew and value of the `Slider` are set from the parameter when the attachment is created. Ranges with custom conversion functions (`convertFrom0to1Func` etc.) aren't supported, because a `Slider` only maps its values with a start, end, interval and skew. Create and destroy it on the message thread. The parameter and the `SliderExtension` must outlive the attachment.
+ */
+class ParameterAttachment : private juce::AudioProcessorParameter::Listener, private juce::AsyncUpdater
+{
+public:
+    /// Creates a new instance, which connects `slider` to `parameter`. `range` converts between the `Slider` value and the parameter's normalised value.
+    ParameterAttachment(juce::AudioProcessorParameter& parameter, const juce::NormalisableRange<float>& range, SliderExtension& slider);
+
+    /// Creates a new instance, which connects `slider` to the parameter with the given ID, using its range.
+    ParameterAttachment(juce::AudioProcessorValueTreeState& state, const juce::String& parameterID, SliderExtension& slider);
+
+    /// Ends a gesture that is still in progress, and disconnects the `Slider` from the parameter.
+    ~ParameterAttachment();
+
+private:
+    juce::AudioProcessorParameter& parameter;
+    const juce::NormalisableRange<float> range;
+    SliderExtension& slider;
+
+    // The latest normalised parameter value, written on any thread
+    std::atomic<float> latestValue;
+    bool isDragging = false;
+    bool isUpdatingSlider = false;
+    // Only accessed on the message thread
+    bool isSettingParameter = false;
+    DisposeBag disposeBag;
+
+    static juce::AudioProcessorParameter& getParameter(juce::AudioProcessorValueTreeState& state, const juce::String& parameterID);
+
+    void sliderValueChanged(double newValue);
+    void setParameterValue(float normalisedValue);
+    void draggingChanged(bool dragging);
+    void parameterValueChanged(int, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterAttachment)
+};
@@ -35,6 +35,16 @@ Reactive<Value>& Reactive<Value>::operator=(const var& newValue)
     return *this;
 }
 
+Reactive<ValueTree>::Reactive(const Identifier& type)
+: ValueTree(type),
+  rx(*this)
+{}
+
+Reactive<ValueTree>::Reactive(const ValueTree& other)
+: ValueTree(other),
+  rx(*this)
+{}
+
 Reactive<AudioProcessorValueTreeState>::Reactive(AudioProcessor& processorToConnectTo, UndoManager* undoManagerToUse)
 : AudioProcessorValueTreeState(processorToConnectTo, undoManagerToUse),
   rx(*this)
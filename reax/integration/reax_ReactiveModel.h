@@ -50,6 +50,35 @@ private:
     Reactive& operator=(const Reactive&) = delete;
 };
 
+/**
+ Adds reactive extensions to a `juce::ValueTree`.
+
+ It's a `juce::ValueTree`, so you can use it as usual, and access `myTree.rx` to observe changes of the tree and its descendants:
+
+     Reactive<juce::ValueTree> document("Document");
+     document.rx.childAdded.subscribe(...);
+
+ @see ValueTreeExtension
+ */
+template<>
+class Reactive<juce::ValueTree> : public juce::ValueTree
+{
+public:
+    /// Creates a new instance. Has the same behavior as the `juce::ValueTree` equivalent.
+    ///@{
+    explicit Reactive(const juce::Identifier& type);
+    Reactive(const juce::ValueTree& other);
+    ///@}
+
+    /// The reactive extension object.
+    const ValueTreeExtension rx;
+
+private:
+    // The extension would keep observing the previous tree
+    Reactive& operator=(const Reactive&) = delete;
+    Reactive& operator=(const juce::ValueTree&) = delete;
+};
+
 /**
  Adds reactive extensions to an `AudioProcessor`.
  */
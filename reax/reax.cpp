@@ -10,9 +10,21 @@ using namespace juce;
     
 #include "integration/reax_GUIExtensions.cpp"
 #include "integration/reax_ModelExtensions.cpp"
+#include "integration/reax_ParameterAttachment.cpp"
 #include "integration/reax_ReactiveModel.cpp"
 
 #include "util/internal/reax_any.cpp"
+#include "util/internal/reax_PoolAllocator.cpp"
+#include "util/internal/reax_FrameTicker.cpp"
+#include "util/reax_AudioBlockSource.cpp"
+#include "util/reax_Diagnostics.cpp"
+#include "util/reax_Instrumentation.cpp"
+#include "util/reax_LockFreeSourceHub.cpp"
+#include "util/reax_MidiEventSource.cpp"
+#include "util/reax_RealtimeChecks.cpp"
 }
 
+// Must be in the global namespace
+#include "util/internal/reax_RealtimeAllocationHooks.cpp"
+
 #pragma clang diagnostic pop
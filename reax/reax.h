@@ -16,6 +16,35 @@ END_JUCE_MODULE_DECLARATION
 
 #pragma once
 
+/** Config: REAX_ENABLE_INSTRUMENTATION
+    Enables reax::Instrumentation, which counts emissions, drops and latencies of LockFreeSources, and records trace events that can be exported for chrome://tracing or Perfetto. Adds some overhead to every emission, so it's disabled by default.
+*/
+#ifndef REAX_ENABLE_INSTRUMENTATION
+#define REAX_ENABLE_INSTRUMENTATION 0
+#endif
+
+/** Config: REAX_ENABLE_DIAGNOSTICS
+    Enables reax::Diagnostics, which counts live subjects, subscriptions and queued values, and warns about subjects and subscriptions that are still alive at shutdown. Adds a counter update to every subscription, so it's disabled by default.
+*/
+#ifndef REAX_ENABLE_DIAGNOSTICS
+#define REAX_ENABLE_DIAGNOSTICS 0
+#endif
+
+/** Config: REAX_ENABLE_REALTIME_CHECKS
+    Enables reax::RealtimeChecks, which reports memory allocations inside the realtime entry points (like LockFreeSource::onNext). Replaces the global operator new and operator delete (unless REAX_REALTIME_CHECKS_REPLACE_OPERATOR_NEW is 0). Meant for debug and CI builds, so it's disabled by default.
+*/
+#ifndef REAX_ENABLE_REALTIME_CHECKS
+#define REAX_ENABLE_REALTIME_CHECKS 0
+#endif
+
+// Observable::toAwaitable is only available with C++20 coroutines
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define REAX_HAS_COROUTINES 1
+#include <coroutine>
+#else
+#define REAX_HAS_COROUTINES 0
+#endif
+
 #include "util/internal/concurrentqueue.h"
 
 #include <juce_core/juce_core.h>
@@ -24,9 +53,14 @@ END_JUCE_MODULE_DECLARATION
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cmath>
+#include <cstring>
 #include <exception>
 #include <functional>
+#include <future>
 #include <initializer_list>
 #include <iostream>
 #include <map>
@@ -34,6 +68,7 @@ END_JUCE_MODULE_DECLARATION
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -46,22 +81,45 @@ namespace reax {
 /// Used for Observables that don't emit a meaningful value, and just notify that something has changed.
 typedef std::tuple<> Empty;
 
+#include "util/internal/reax_PoolAllocator.h"
 #include "util/internal/reax_any.h"
+#include "util/internal/reax_AtomicValue.h"
+#include "util/internal/reax_FrameTicker.h"
+#include "util/reax_Instrumentation.h"
+#include "util/reax_MemoryPool.h"
+#include "util/reax_RealtimeChecks.h"
+#include "util/reax_Diagnostics.h"
+#include "util/reax_CongestionPolicy.h"
+#include "util/reax_SignalReductions.h"
 #include "rx/reax_Subscription.h"
 #include "rx/reax_DisposeBag.h"
 #include "rx/internal/reax_Observer_Impl.h"
 #include "rx/reax_Observer.h"
 #include "rx/reax_Scheduler.h"
+#include "rx/reax_Propagation.h"
 #include "rx/internal/reax_Observable_Impl.h"
 #include "rx/reax_Observable.h"
+#include "rx/reax_TypedPipeline.h"
 #include "rx/internal/reax_Subjects_Impl.h"
 #include "rx/reax_Subjects.h"
+#include "rx/reax_Transaction.h"
+#include "rx/reax_Computed.h"
 
+#include "util/reax_Shared.h"
+#include "util/reax_Span.h"
+#include "util/internal/reax_SingleProducerQueue.h"
+#include "util/reax_LockFreeSourceHub.h"
 #include "util/reax_LockFreeSource.h"
 #include "util/reax_LockFreeTarget.h"
+#include "util/reax_TimestampedLockFreeTarget.h"
+#include "util/reax_LatestValueSource.h"
+#include "util/reax_AudioBlockSource.h"
+#include "util/reax_MidiEventSource.h"
 
+#include "integration/reax_LazyObserver.h"
 #include "integration/reax_GUIExtensions.h"
 #include "integration/reax_ModelExtensions.h"
+#include "integration/reax_ParameterAttachment.h"
 #include "integration/reax_Reactive.h"
 #include "integration/reax_ReactiveGUI.h"
 #include "integration/reax_ReactiveModel.h"
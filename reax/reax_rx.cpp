@@ -14,21 +14,33 @@ REAX_ENABLE_EXTRA_WARNINGS
 namespace reax {
 using namespace juce;
 
+#include "util/internal/reax_PoolAllocator.h"
 #include "util/internal/reax_any.h"
+#include "util/internal/reax_FrameTicker.h"
+#include "util/internal/reax_SingleProducerQueue.h"
+#include "util/reax_Instrumentation.h"
+#include "util/reax_RealtimeChecks.h"
+#include "util/reax_Diagnostics.h"
+#include "util/reax_CongestionPolicy.h"
     
 #include "rx/reax_Subscription.h"
+#include "rx/internal/reax_PropagationWave.h"
 #include "rx/internal/reax_Observable_Impl.h"
 #include "rx/reax_Scheduler.h"
 #include "rx/internal/reax_Observer_Impl.h"
 #include "rx/internal/reax_Scheduler_Impl.h"
 #include "rx/internal/reax_Subjects_Impl.h"
+#include "rx/reax_Transaction.h"
+#include "rx/internal/reax_Transaction_Impl.h"
 #include "rx/reax_DisposeBag.h"
+#include "rx/internal/reax_PropagationWave.cpp"
 #include "rx/reax_Subscription.cpp"
 #include "rx/reax_DisposeBag.cpp"
 #include "rx/reax_Scheduler.cpp"
 #include "rx/internal/reax_Scheduler_Impl.cpp"
 #include "rx/internal/reax_Observable_Impl.cpp"
 #include "rx/internal/reax_Observer_Impl.cpp"
+#include "rx/reax_Transaction.cpp"
 #include "rx/internal/reax_Subjects_Impl.cpp"
 }
 
@@ -61,6 +61,18 @@ inline rxcpp::observable<any> unwrap(const any& wrapped)
         return wrapped.get<std::shared_ptr<ValueObservable>>()->getObservable().map([](const var& value) { return any(value); });
 }
 
+// Counts the subscription in Diagnostics until it ends
+void trackSubscription(rxcpp::subscription& subscription)
+{
+#if REAX_ENABLE_DIAGNOSTICS
+    // If the subscription has ended already, the callback runs immediately
+    Diagnostics::subscriptionAdded();
+    subscription.add([]() { Diagnostics::subscriptionRemoved(); });
+#else
+    ignoreUnused(subscription);
+#endif
+}
+
 template<typename T>
 rxcpp::observable<any> _range(const T& first, const T& last, unsigned int step)
 {
@@ -72,6 +84,787 @@ rxcpp::observable<any> _range(const T& first, const T& last, unsigned int step)
     return o.map([](const T& value) { return any(value); });
 }
 
+// Runs all stages in a single operator, instead of one operator per stage
+rxcpp::observable<any> _transform(const rxcpp::observable<any>& source, const std::vector<detail::ObservableImpl::Stage>& stages)
+{
+    typedef std::vector<detail::ObservableImpl::Stage> Stages;
+
+    return source.lift<any>([stages](const rxcpp::subscriber<any>& destination) {
+        // Each subscription gets its own copy of the stages, so stateful stages don't share their state
+        auto localStages = std::make_shared<Stages>(stages);
+
+        return rxcpp::make_subscriber<any>(destination,
+                                           [destination, localStages](const any& value) {
+                                               any result(value);
+
+                                               try {
+                                                   for (auto& stage : *localStages) {
+                                                       if (!stage(result))
+                                                           return;
+                                                   }
+                                               } catch (...) {
+                                                   destination.on_error(std::current_exception());
+                                                   return;
+                                               }
+
+                                               destination.on_next(std::move(result));
+                                           },
+                                           [destination](std::exception_ptr error) { destination.on_error(error); },
+                                           [destination]() { destination.on_completed(); });
+    });
+}
+
+// The state of one parallelMap subscription. Each value is evaluated in its own subscription to the scheduled Observable, and the results are put into a reorder buffer until they can be emitted in source order.
+//
+// Notifications are emitted without holding the mutex, so a subscriber may synchronously push values back into the source. Only one thread emits at a time: Others append to the ready queue, which the emitting thread drains.
+//
+// The number of values in the waiting queue isn't bounded: If the source emits faster than the results are evaluated, it grows until the evaluation catches up.
+class ParallelMap : public std::enable_shared_from_this<ParallelMap>
+{
+public:
+    typedef std::function<any(const any&)> Function;
+
+    ParallelMap(const rxcpp::subscriber<any>& destination, const detail::SchedulerImpl::Schedule& schedule, const Function& function, unsigned int maxConcurrency)
+    : destination(destination),
+      schedule(schedule),
+      function(function),
+      maxConcurrency(jmax(1u, maxConcurrency))
+    {}
+
+    void onNext(const any& value)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+        waiting.push_back(value);
+        startWaiting(lock);
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished)
+                return;
+
+            finished = true;
+            terminalError = error;
+            terminationPending = true;
+        }
+
+        emitReady();
+    }
+
+    void onCompleted()
+    {
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+            sourceCompleted = true;
+            completeIfDone();
+        }
+
+        emitReady();
+    }
+
+private:
+    const rxcpp::subscriber<any> destination;
+    const detail::SchedulerImpl::Schedule schedule;
+    const Function function;
+    const size_t maxConcurrency;
+
+    std::mutex mutex;
+    // Values that can't be started yet, because maxConcurrency values are evaluated or buffered
+    std::deque<any> waiting;
+    // Results that are waiting for the results of earlier values
+    std::map<size_t, any> results;
+    // Results that are in order, and can be emitted
+    std::deque<any> ready;
+    // The error to emit after the ready results, if terminationPending is set. Completes if it's null.
+    std::exception_ptr terminalError;
+    // The index of the next value that is started
+    size_t nextIndex = 0;
+    // The index of the next result that is emitted
+    size_t nextToEmit = 0;
+    bool sourceCompleted = false;
+    // Whether the termination has been decided. No more results are accepted afterwards.
+    bool finished = false;
+    // Whether the termination still has to be emitted, after the ready results
+    bool terminationPending = false;
+    // Whether a thread is currently emitting
+    bool emitting = false;
+
+    // Starts evaluating as many waiting values as allowed. The subscriptions are made after unlocking, in case the scheduler calls back synchronously.
+    void startWaiting(std::unique_lock<std::mutex>& lock)
+    {
+        std::vector<std::pair<size_t, any>> started;
+        while (!finished && !waiting.empty() && nextIndex - nextToEmit < maxConcurrency) {
+            started.emplace_back(nextIndex++, std::move(waiting.front()));
+            waiting.pop_front();
+        }
+
+        lock.unlock();
+
+        for (auto& indexAndValue : started)
+            start(indexAndValue.first, indexAndValue.second);
+    }
+
+    void start(size_t index, const any& value)
+    {
+        const auto self = shared_from_this();
+
+        // Each value gets its own lifetime, so completing it doesn't unsubscribe the destination
+        rxcpp::composite_subscription lifetime;
+        const auto token = destination.add(lifetime);
+        const auto destinationCopy = destination;
+        lifetime.add([destinationCopy, token]() {
+            destinationCopy.remove(token);
+        });
+
+        schedule(rxcpp::observable<>::just(value))
+            .subscribe(lifetime,
+                       [self, index](const any& scheduledValue) {
+                           any result(0);
+
+                           try {
+                               result = self->function(scheduledValue);
+                           } catch (...) {
+                               self->onError(std::current_exception());
+                               return;
+                           }
+
+                           self->onResult(index, std::move(result));
+                       },
+                       [self](std::exception_ptr error) { self->onError(error); });
+    }
+
+    void onResult(size_t index, any&& result)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+        if (finished)
+            return;
+
+        results.emplace(index, std::move(result));
+
+        // Move all results that are in order to the ready queue
+        while (!results.empty() && results.begin()->first == nextToEmit) {
+            ready.push_back(std::move(results.begin()->second));
+            results.erase(results.begin());
+            nextToEmit++;
+        }
+
+        completeIfDone();
+        startWaiting(lock);
+        emitReady();
+    }
+
+    // The mutex must be locked
+    void completeIfDone()
+    {
+        if (finished || !sourceCompleted || !waiting.empty() || nextToEmit != nextIndex)
+            return;
+
+        finished = true;
+        terminationPending = true;
+    }
+
+    // Emits the ready results, and then the termination if it's pending. Returns immediately if another thread (or an outer call on this thread) is already emitting: That call emits the new results, too.
+    void emitReady()
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+        if (emitting)
+            return;
+
+        emitting = true;
+        while (!ready.empty()) {
+            const any result(std::move(ready.front()));
+            ready.pop_front();
+
+            lock.unlock();
+            destination.on_next(result);
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            lock.lock();
+        }
+
+        if (!terminationPending) {
+            emitting = false;
+            return;
+        }
+
+        // Keep emitting set, so nothing is emitted after the termination
+        terminationPending = false;
+        const auto error = terminalError;
+        lock.unlock();
+
+        if (error)
+            destination.on_error(error);
+        else
+            destination.on_completed();
+    }
+};
+
+// Runs action once on the scheduler. It's cancelled if the destination unsubscribes before.
+void scheduleAction(const rxcpp::subscriber<any>& destination, const detail::SchedulerImpl::Schedule& schedule, const std::function<void()>& action)
+{
+    // Each action gets its own lifetime, so completing it doesn't unsubscribe the destination
+    rxcpp::composite_subscription lifetime;
+    const auto token = destination.add(lifetime);
+    lifetime.add([destination, token]() {
+        destination.remove(token);
+    });
+
+    schedule(rxcpp::observable<>::just(any(0)))
+        .subscribe(lifetime, [action](const any&) { action(); });
+}
+
+// The state of one bounded observeOn subscription. Values are buffered until the scheduler runs a drain, and at most one drain is scheduled at a time.
+class BoundedObserveOn : public std::enable_shared_from_this<BoundedObserveOn>
+{
+public:
+    BoundedObserveOn(const rxcpp::subscriber<any>& destination, const detail::SchedulerImpl::Schedule& schedule, size_t capacity, CongestionPolicy congestionPolicy)
+    : destination(destination),
+      schedule(schedule),
+      capacity(jmax<size_t>(1, capacity)),
+      congestionPolicy(congestionPolicy)
+    {}
+
+    void onNext(const any& value)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (buffer.size() >= capacity) {
+            if (congestionPolicy == CongestionPolicy::DropNewest) {
+                REAX_TRACE_EVENT("Observable::observeOn drop", 0);
+                return;
+            }
+
+            if (congestionPolicy == CongestionPolicy::DropOldest) {
+                REAX_TRACE_EVENT("Observable::observeOn drop", 0);
+                buffer.pop_front();
+            }
+        }
+
+        buffer.push_back(value);
+        scheduleDrain(lock);
+    }
+
+    void onError(std::exception_ptr e)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+        terminated = true;
+        error = e;
+        scheduleDrain(lock);
+    }
+
+    void onCompleted()
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::unique_lock<std::mutex> lock(mutex);
+        terminated = true;
+        scheduleDrain(lock);
+    }
+
+private:
+    const rxcpp::subscriber<any> destination;
+    const detail::SchedulerImpl::Schedule schedule;
+    const size_t capacity;
+    const CongestionPolicy congestionPolicy;
+
+    std::mutex mutex;
+    std::deque<any> buffer;
+    bool isDrainScheduled = false;
+    bool terminated = false;
+    bool finished = false;
+    std::exception_ptr error;
+
+    // Schedules a drain, unless one is scheduled already. The subscription is made after unlocking, in case the scheduler calls back synchronously.
+    void scheduleDrain(std::unique_lock<std::mutex>& lock)
+    {
+        if (isDrainScheduled)
+            return;
+
+        isDrainScheduled = true;
+        lock.unlock();
+
+        const auto self = shared_from_this();
+        scheduleAction(destination, schedule, [self]() { self->drain(); });
+    }
+
+    // Called on the scheduler. Emits all buffered values, including those that arrive while draining.
+    void drain()
+    {
+        for (;;) {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::unique_lock<std::mutex> lock(mutex);
+
+            if (buffer.empty()) {
+                if (terminated && !finished) {
+                    // isDrainScheduled stays true, so nothing is scheduled anymore
+                    finished = true;
+                    lock.unlock();
+
+                    if (error)
+                        destination.on_error(error);
+                    else
+                        destination.on_completed();
+                }
+                else
+                    isDrainScheduled = false;
+
+                return;
+            }
+
+            const any value(std::move(buffer.front()));
+            buffer.pop_front();
+            lock.unlock();
+
+            destination.on_next(value);
+        }
+    }
+};
+
+// The state of one observeOnLatest subscription. Only the latest value is kept, and at most one dispatch is scheduled at a time.
+class LatestObserveOn : public std::enable_shared_from_this<LatestObserveOn>
+{
+public:
+    LatestObserveOn(const rxcpp::subscriber<any>& destination, const detail::SchedulerImpl::Schedule& schedule)
+    : destination(destination),
+      schedule(schedule)
+    {}
+
+    void onNext(const any& value)
+    {
+        // Copy outside of the lock, and destroy the replaced value after unlocking, so the lock is only held for a swap
+        any copy(value);
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(latestLock);
+
+            if (hasLatest) {
+                REAX_TRACE_EVENT("Observable::observeOnLatest overwrite", 0);
+            }
+
+            std::swap(latest, copy);
+            hasLatest = true;
+        }
+
+        scheduleDispatchIfNeeded();
+    }
+
+    void onError(std::exception_ptr e)
+    {
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(latestLock);
+            error = e;
+            terminated = true;
+        }
+
+        scheduleDispatchIfNeeded();
+    }
+
+    void onCompleted()
+    {
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(latestLock);
+            terminated = true;
+        }
+
+        scheduleDispatchIfNeeded();
+    }
+
+private:
+    const rxcpp::subscriber<any> destination;
+    const detail::SchedulerImpl::Schedule schedule;
+
+    std::atomic<bool> isDispatchScheduled{ false };
+
+    // Only locked to swap the pending value in and out, never while calling the destination
+    SpinLock latestLock;
+    any latest{ 0 };
+    bool hasLatest = false;
+    bool terminated = false;
+    std::exception_ptr error;
+
+    bool hasPendingWork()
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const SpinLock::ScopedLockType lock(latestLock);
+        return hasLatest || terminated;
+    }
+
+    void scheduleDispatchIfNeeded()
+    {
+        if (isDispatchScheduled.exchange(true))
+            return;
+
+        const auto self = shared_from_this();
+        scheduleAction(destination, schedule, [self]() { self->dispatch(); });
+    }
+
+    // Called on the scheduler. Emits the latest value (or the termination), then schedules another dispatch if a newer value has arrived in the meantime.
+    void dispatch()
+    {
+        bool shouldEmit = false;
+        bool shouldTerminate = false;
+        any value(0);
+        std::exception_ptr terminalError;
+
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(latestLock);
+
+            if (hasLatest) {
+                value = std::move(latest);
+                latest = any(0);
+                hasLatest = false;
+                shouldEmit = true;
+            }
+            else if (terminated) {
+                shouldTerminate = true;
+                terminalError = error;
+            }
+        }
+
+        if (shouldEmit)
+            destination.on_next(value);
+
+        if (shouldTerminate) {
+            // isDispatchScheduled stays true, so nothing is scheduled anymore
+            if (terminalError)
+                destination.on_error(terminalError);
+            else
+                destination.on_completed();
+
+            return;
+        }
+
+        isDispatchScheduled.store(false);
+
+        if (hasPendingWork())
+            scheduleDispatchIfNeeded();
+    }
+};
+
+// The state of one combineLatestArray, zipArray or glitch-free combineLatest / withLatestFrom subscription. It subscribes to all sources directly (instead of nesting binary operators), and each value only updates the slot of its source.
+//
+// If glitchFree is true, values that arrive during a PropagationWave don't emit right away. Instead, the combination emits once when the wave settles, with the latest values of all sources.
+class NWayCombination : public std::enable_shared_from_this<NWayCombination>
+{
+public:
+    enum class Mode {
+        CombineLatest,
+        // Only the first source triggers an emission
+        WithLatestFrom,
+        Zip
+    };
+
+    typedef std::function<any(const std::vector<any>&)> Combine;
+
+    static ObservableImpl create(Mode mode, const Array<ObservableImpl>& observables, const Combine& combine, bool glitchFree = false)
+    {
+        std::vector<rxcpp::observable<any>> sources;
+        for (auto& observable : observables)
+            sources.push_back(unwrap(observable.wrapped));
+
+        return wrap(rxcpp::observable<>::create<any>([mode, sources, combine, glitchFree](const rxcpp::subscriber<any>& destination) {
+            if (sources.empty()) {
+                destination.on_completed();
+                return;
+            }
+
+            const auto state = std::make_shared<NWayCombination>(mode, destination, sources.size(), combine, glitchFree);
+
+            for (size_t i = 0; i < sources.size(); ++i) {
+                rxcpp::composite_subscription lifetime;
+                destination.add(lifetime);
+
+                sources[i].subscribe(rxcpp::make_subscriber<any>(lifetime,
+                                                                 [state, i](const any& value) { state->onNext(i, value); },
+                                                                 [state](std::exception_ptr error) { state->onError(error); },
+                                                                 [state, i]() { state->onCompleted(i); }));
+            }
+        }));
+    }
+
+    NWayCombination(Mode mode, const rxcpp::subscriber<any>& destination, size_t numSources, const Combine& combine, bool glitchFree)
+    : mode(mode),
+      glitchFree(glitchFree),
+      destination(destination),
+      combine(combine),
+      latestValues(numSources, any(0)),
+      hasValue(numSources, false),
+      isCompleted(numSources, false),
+      queues(mode == Mode::Zip ? numSources : 0)
+    {}
+
+    void onNext(size_t index, const any& value)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        if (mode != Mode::Zip) {
+            latestValues[index] = value;
+
+            if (!hasValue[index]) {
+                hasValue[index] = true;
+                ++numWithValue;
+            }
+
+            // Settle after the operators that emit into this one
+            if (glitchFree)
+                rank = jmax(rank, PropagationWave::getEmittingRank() + 1);
+
+            if (mode == Mode::WithLatestFrom && index != 0)
+                return;
+
+            if (glitchFree && PropagationWave::isActive()) {
+                isTriggered = true;
+
+                // Once per wave. A callback of an earlier wave may have been discarded, e.g. if it ended with an exception.
+                const auto waveID = PropagationWave::getCurrentID();
+                if (settleWaveID != waveID) {
+                    settleWaveID = waveID;
+                    const auto self = shared_from_this();
+                    PropagationWave::settleLater(rank, [self]() { self->settle(); });
+                }
+            }
+            else if (numWithValue == latestValues.size())
+                emit(latestValues);
+        }
+        else {
+            queues[index].push_back(value);
+
+            for (auto& queue : queues) {
+                if (queue.empty())
+                    return;
+            }
+
+            // Every source has a value, so take the oldest one from each
+            for (size_t i = 0; i < queues.size(); ++i) {
+                latestValues[i] = std::move(queues[i].front());
+                queues[i].pop_front();
+            }
+
+            emit(latestValues);
+            completeIfZipIsExhausted();
+        }
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const std::lock_guard<std::recursive_mutex> lock(mutex);
+        destination.on_error(error);
+    }
+
+    void onCompleted(size_t index)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        if (isCompleted[index])
+            return;
+
+        isCompleted[index] = true;
+        ++numCompleted;
+
+        if (mode != Mode::Zip) {
+            // Don't lose a combination that is waiting for the wave to settle
+            if (isTriggered)
+                settle();
+
+            // If a source completes without a value, there will never be a combination
+            if (!hasValue[index] || numCompleted == isCompleted.size())
+                destination.on_completed();
+        }
+        else
+            completeIfZipIsExhausted();
+    }
+
+private:
+    const Mode mode;
+    const bool glitchFree;
+    const rxcpp::subscriber<any> destination;
+    const Combine combine;
+
+    // Serializes the values of the sources, which may emit on different threads. Recursive, because the destination may make a source emit synchronously.
+    std::recursive_mutex mutex;
+    std::vector<any> latestValues;
+    std::vector<bool> hasValue;
+    std::vector<bool> isCompleted;
+    size_t numWithValue = 0;
+    size_t numCompleted = 0;
+
+    // The values that haven't been zipped yet
+    std::vector<std::deque<any>> queues;
+
+    // Only used if glitchFree is true
+    int rank = 0;
+    // The ID of the PropagationWave in which the last settle callback has been scheduled
+    uint64 settleWaveID = 0;
+    bool isTriggered = false;
+
+    void settle()
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        // A value that arrives later in the same wave schedules a new callback
+        settleWaveID = 0;
+
+        // May have been settled early, by onCompleted (or by the callback of another wave)
+        const bool shouldEmit = (isTriggered && numWithValue == latestValues.size());
+        isTriggered = false;
+
+        if (shouldEmit)
+            emit(latestValues);
+    }
+
+    void emit(const std::vector<any>& values)
+    {
+        if (!destination.is_subscribed())
+            return;
+
+        const PropagationWave::EmittingScope scope(rank);
+
+        try {
+            destination.on_next(combine(values));
+        }
+        catch (...) {
+            destination.on_error(std::current_exception());
+        }
+    }
+
+    // A zip completes when a completed source has no more values
+    void completeIfZipIsExhausted()
+    {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            if (isCompleted[i] && queues[i].empty()) {
+                destination.on_completed();
+                return;
+            }
+        }
+    }
+};
+
+// The state of one sampleOnFrame subscription. Values may arrive on any thread. The latest one is emitted on the message thread, when the shared FrameTicker ticks.
+class FrameSampler : public std::enable_shared_from_this<FrameSampler>, private detail::FrameTicker::Client, private AsyncUpdater
+{
+public:
+    explicit FrameSampler(const rxcpp::subscriber<any>& destination)
+    : destination(destination)
+    {}
+
+    void onNext(const any& value)
+    {
+        // Copy the value before locking, and destroy the previous one after unlocking, so the lock is never held during a heap operation
+        any previousValue(value);
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(spinLock);
+            std::swap(latestValue, previousValue);
+            hasLatestValue = true;
+        }
+
+        if (MessageManager::existsAndIsCurrentThread())
+            requestFrame();
+        else
+            triggerAsyncUpdate();
+    }
+
+    void onError(std::exception_ptr error)
+    {
+        terminate([error](const rxcpp::subscriber<any>& destination) { destination.on_error(error); });
+    }
+
+    void onCompleted()
+    {
+        terminate([](const rxcpp::subscriber<any>& destination) { destination.on_completed(); });
+    }
+
+    // Must be called before the sampler is destroyed. Cancels the frame on the message thread.
+    void dispose()
+    {
+        const auto self = shared_from_this();
+        MessageManager::callAsync([self]() {
+            self->disposed = true;
+            self->cancelPendingUpdate();
+            detail::FrameTicker::getInstance().cancelFrame(*self);
+        });
+    }
+
+private:
+    typedef std::function<void(const rxcpp::subscriber<any>&)> Terminate;
+
+    const rxcpp::subscriber<any> destination;
+
+    SpinLock spinLock;
+    any latestValue{ 0 };
+    bool hasLatestValue = false;
+    Terminate termination;
+
+    // Only used on the message thread
+    bool disposed = false;
+
+    void terminate(const Terminate& terminateDestination)
+    {
+        Terminate newTermination(terminateDestination);
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(spinLock);
+            std::swap(termination, newTermination);
+        }
+
+        triggerAsyncUpdate();
+    }
+
+    void requestFrame()
+    {
+        if (!disposed)
+            detail::FrameTicker::getInstance().requestFrame(*this);
+    }
+
+    void handleAsyncUpdate() override
+    {
+        Terminate terminateDestination;
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(spinLock);
+            terminateDestination = std::move(termination);
+            termination = nullptr;
+        }
+
+        if (terminateDestination) {
+            disposed = true;
+            detail::FrameTicker::getInstance().cancelFrame(*this);
+            terminateDestination(destination);
+        }
+        else
+            requestFrame();
+    }
+
+    void frameDidTick() override
+    {
+        any value(0);
+        bool hasValue = false;
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const SpinLock::ScopedLockType lock(spinLock);
+            std::swap(value, latestValue);
+            std::swap(hasValue, hasLatestValue);
+        }
+
+        if (hasValue && !disposed && destination.is_subscribed())
+            destination.on_next(value);
+    }
+};
+
 template<typename Function, typename... Os>
 rxcpp::observable<any> _combineLatest(const any& wrapped, Function&& function, Os&&... observables)
 {
@@ -146,6 +939,36 @@ ObservableImpl ObservableImpl::from(Array<any>&& values)
     return wrap(rxcpp::observable<>::iterate(std::move(values), rxcpp::identity_immediate()));
 }
 
+ObservableImpl ObservableImpl::fromGenerator(const std::function<bool(any&)>& generator)
+{
+    return wrap(rxcpp::observable<>::create<any>([generator](const rxcpp::subscriber<any>& subscriber) {
+        auto localGenerator = generator;
+
+        // Overwritten by the generator before it's emitted
+        any value(0);
+
+        // Produce the next value only after the subscriber has processed the previous one, and stop if it unsubscribes
+        while (subscriber.is_subscribed()) {
+            bool hasValue = false;
+
+            try {
+                hasValue = localGenerator(value);
+            }
+            catch (...) {
+                subscriber.on_error(std::current_exception());
+                return;
+            }
+
+            if (!hasValue) {
+                subscriber.on_completed();
+                return;
+            }
+
+            subscriber.on_next(value);
+        }
+    }));
+}
+
 ObservableImpl ObservableImpl::fromValue(Value value)
 {
     return any(std::make_shared<ValueObservable>(value));
@@ -157,6 +980,12 @@ ObservableImpl ObservableImpl::interval(const juce::RelativeTime& period)
     return wrap(o.map([](long long value) { return any(value); }));
 }
 
+ObservableImpl ObservableImpl::interval(const juce::RelativeTime& period, const SchedulerImpl& scheduler)
+{
+    auto o = rxcpp::observable<>::interval(durationFromRelativeTime(period), rxcpp::identity_one_worker(scheduler.timerScheduler));
+    return wrap(o.map([](long long value) { return any(value); }));
+}
+
 ObservableImpl ObservableImpl::just(const any& value)
 {
     return wrap(rxcpp::observable<>::just(value));
@@ -199,9 +1028,18 @@ Subscription ObservableImpl::subscribe(const std::function<void(const any&)>& on
                                        const std::function<void(std::exception_ptr)>& onError,
                                        const std::function<void()>& onCompleted) const
 {
+#if REAX_ENABLE_INSTRUMENTATION
+    const auto tracedOnNext = [onNext](const any& value) {
+        REAX_TRACE_SCOPE("Subscriber::onNext", 0);
+        onNext(value);
+    };
+    rxcpp::subscription subscription = unwrap(wrapped).subscribe(tracedOnNext, onError, onCompleted);
+#else
     rxcpp::subscription subscription = unwrap(wrapped).subscribe(onNext, onError, onCompleted);
+#endif
 
-    return Subscription(any(subscription));
+    trackSubscription(subscription);
+    return Subscription(subscription);
 }
 
 Subscription ObservableImpl::subscribe(const ObserverImpl& observer) const
@@ -209,7 +1047,8 @@ Subscription ObservableImpl::subscribe(const ObserverImpl& observer) const
     auto subscriber = observer.wrapped.get<rxcpp::subscriber<any>>();
     rxcpp::subscription subscription = unwrap(wrapped).subscribe(subscriber);
 
-    return Subscription(any(subscription));
+    trackSubscription(subscription);
+    return Subscription(subscription);
 }
 
 
@@ -263,6 +1102,47 @@ Subscription ObservableImpl::subscribe(const ObserverImpl& observer) const
             return any(0); \
     }
 
+ObservableImpl ObservableImpl::buffer(unsigned int count, unsigned int skip, const std::function<any(const std::vector<any>&)>& combine) const
+{
+    // Overlapping (or gapped) chunks need more than one chunk at a time
+    if (skip != count)
+        return wrap(unwrap(wrapped).buffer(count, skip).map(combine));
+
+    return wrap(unwrap(wrapped).lift<any>([count, combine](const rxcpp::subscriber<any>& destination) {
+        // The chunk is reused for the whole subscription, so its storage is only allocated once
+        const auto chunk = std::make_shared<std::vector<any>>();
+        chunk->reserve(count);
+
+        return rxcpp::make_subscriber<any>(destination,
+                                           [destination, chunk, count, combine](const any& value) {
+                                               chunk->push_back(value);
+
+                                               if (chunk->size() == count) {
+                                                   const any combined = combine(*chunk);
+                                                   chunk->clear();
+                                                   destination.on_next(combined);
+                                               }
+                                           },
+                                           [destination](std::exception_ptr error) { destination.on_error(error); },
+                                           [destination, chunk, combine]() {
+                                               if (!chunk->empty())
+                                                   destination.on_next(combine(*chunk));
+
+                                               destination.on_completed();
+                                           });
+    }));
+}
+
+ObservableImpl ObservableImpl::bufferWithTime(const juce::RelativeTime& span, const SchedulerImpl& scheduler, const std::function<any(const std::vector<any>&)>& combine) const
+{
+    return wrap(unwrap(wrapped).buffer_with_time(durationFromRelativeTime(span), rxcpp::identity_one_worker(scheduler.timerScheduler)).map(combine));
+}
+
+ObservableImpl ObservableImpl::bufferWithTimeOrCount(const juce::RelativeTime& span, unsigned int count, const SchedulerImpl& scheduler, const std::function<any(const std::vector<any>&)>& combine) const
+{
+    return wrap(unwrap(wrapped).buffer_with_time_or_count(durationFromRelativeTime(span), count, rxcpp::identity_one_worker(scheduler.timerScheduler)).map(combine));
+}
+
 ObservableImpl ObservableImpl::combineLatest(std::initializer_list<ObservableImpl> others, const any& function) const 
 {
     REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION_WITH_FUNCTION(combineLatest, others, function)
@@ -278,6 +1158,11 @@ ObservableImpl ObservableImpl::debounce(const juce::RelativeTime& period) const
     return wrap(unwrap(wrapped).debounce(durationFromRelativeTime(period)));
 }
 
+ObservableImpl ObservableImpl::debounce(const juce::RelativeTime& period, const SchedulerImpl& scheduler) const
+{
+    return wrap(unwrap(wrapped).debounce(durationFromRelativeTime(period), rxcpp::identity_one_worker(scheduler.timerScheduler)));
+}
+
 ObservableImpl ObservableImpl::distinctUntilChanged(const std::function<bool(const any&, const any&)>& equals) const
 {
     return wrap(unwrap(wrapped).distinct_until_changed(equals));
@@ -290,8 +1175,14 @@ ObservableImpl ObservableImpl::elementAt(int index) const
 
 ObservableImpl ObservableImpl::filter(const std::function<bool(const any&)>& predicate) const
 {
-    // On Visual Studio, the predicate must be wrapped in a lambda, otherwise RxCpp fails to compile
-    return wrap(unwrap(wrapped).filter([predicate](const any& value) { return predicate(value); }));
+    return fuse([predicate](any& value) {
+        return predicate(value);
+    });
+}
+
+ObservableImpl ObservableImpl::finally(const std::function<void()>& function) const
+{
+    return wrap(unwrap(wrapped).finally([function]() { function(); }));
 }
 
 ObservableImpl ObservableImpl::flatMap(const std::function<ObservableImpl(const any&)>& f) const
@@ -303,7 +1194,10 @@ ObservableImpl ObservableImpl::flatMap(const std::function<ObservableImpl(const
 
 ObservableImpl ObservableImpl::map(const std::function<any(const any&)>& function) const
 {
-    return wrap(unwrap(wrapped).map(function));
+    return fuse([function](any& value) {
+        value = function(value);
+        return true;
+    });
 }
 
 ObservableImpl ObservableImpl::merge(const juce::Array<ObservableImpl>& others) const {
@@ -320,6 +1214,32 @@ ObservableImpl ObservableImpl::sample(const juce::RelativeTime& interval) const
     return wrap(unwrap(wrapped).sample_with_time(durationFromRelativeTime(interval)));
 }
 
+ObservableImpl ObservableImpl::sample(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const
+{
+    return wrap(unwrap(wrapped).sample_with_time(durationFromRelativeTime(interval), rxcpp::identity_one_worker(scheduler.timerScheduler)));
+}
+
+ObservableImpl ObservableImpl::sampleOnFrame() const
+{
+    return wrap(unwrap(wrapped).lift<any>([](const rxcpp::subscriber<any>& destination) {
+        const auto sampler = std::make_shared<FrameSampler>(destination);
+
+        // The FrameTicker refers to the sampler, so it must be cancelled on the message thread before the sampler can be destroyed
+        destination.add([sampler]() {
+            sampler->dispose();
+        });
+
+        // The source gets its own lifetime, so its completion doesn't unsubscribe the destination before the completion is forwarded on the message thread
+        rxcpp::composite_subscription sourceLifetime;
+        destination.add(sourceLifetime);
+
+        return rxcpp::make_subscriber<any>(sourceLifetime,
+                                           [sampler](const any& value) { sampler->onNext(value); },
+                                           [sampler](std::exception_ptr error) { sampler->onError(error); },
+                                           [sampler]() { sampler->onCompleted(); });
+    }));
+}
+
 ObservableImpl ObservableImpl::scan(const any& startValue, const std::function<any(const any&, const any&)>& f) const
 {
     return wrap(unwrap(wrapped).scan(startValue, f));
@@ -370,6 +1290,11 @@ ObservableImpl ObservableImpl::takeWhile(const std::function<bool(const any&)>&
     return wrap(unwrap(wrapped).take_while([predicate](const any& value) { return predicate(value); }));
 }
 
+ObservableImpl ObservableImpl::transform(const std::function<bool(any&)>& stage) const
+{
+    return fuse(stage);
+}
+
 ObservableImpl ObservableImpl::withLatestFrom(std::initializer_list<ObservableImpl> others, const any& function) const {
     REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION_WITH_FUNCTION(withLatestFrom, others, function)
 }
@@ -379,27 +1304,104 @@ ObservableImpl ObservableImpl::zip(std::initializer_list<ObservableImpl> others,
     REAX_OBSERVABLE_IMPL_UNROLLED_LIST_IMPLEMENTATION_WITH_FUNCTION(zip, others, function)
 }
 
+ObservableImpl ObservableImpl::combineLatestArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine, bool glitchFree)
+{
+    return NWayCombination::create(NWayCombination::Mode::CombineLatest, observables, combine, glitchFree);
+}
+
+ObservableImpl ObservableImpl::mergeArray(const juce::Array<ObservableImpl>& observables)
+{
+    std::vector<rxcpp::observable<any>> sources;
+    for (auto& observable : observables)
+        sources.push_back(unwrap(observable.wrapped));
+
+    return wrap(rxcpp::observable<>::iterate(sources).merge());
+}
+
+ObservableImpl ObservableImpl::withLatestFromArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine, bool glitchFree)
+{
+    return NWayCombination::create(NWayCombination::Mode::WithLatestFrom, observables, combine, glitchFree);
+}
+
+ObservableImpl ObservableImpl::zipArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine)
+{
+    return NWayCombination::create(NWayCombination::Mode::Zip, observables, combine);
+}
+
 
 #pragma mark - Scheduling
 
 ObservableImpl ObservableImpl::observeOn(const SchedulerImpl& scheduler) const
 {
+#if REAX_ENABLE_INSTRUMENTATION
+    return wrap(scheduler.schedule(unwrap(wrapped)).tap([](const any&) {
+        REAX_TRACE_EVENT("Observable::observeOn", 0);
+    }));
+#else
     return wrap(scheduler.schedule(unwrap(wrapped)));
+#endif
 }
 
+ObservableImpl ObservableImpl::observeOn(const SchedulerImpl& scheduler, size_t capacity, CongestionPolicy congestionPolicy) const
+{
+    const auto schedule = scheduler.schedule;
 
-#pragma mark - Misc
+    return wrap(unwrap(wrapped).lift<any>([schedule, capacity, congestionPolicy](const rxcpp::subscriber<any>& destination) {
+        const auto state = std::make_shared<BoundedObserveOn>(destination, schedule, capacity, congestionPolicy);
+
+        // The source gets its own lifetime, so its completion doesn't unsubscribe the values that are still buffered
+        rxcpp::composite_subscription sourceLifetime;
+        destination.add(sourceLifetime);
+
+        return rxcpp::make_subscriber<any>(sourceLifetime,
+                                           [state](const any& value) { state->onNext(value); },
+                                           [state](std::exception_ptr error) { state->onError(error); },
+                                           [state]() { state->onCompleted(); });
+    }));
+}
+
+ObservableImpl ObservableImpl::observeOnLatest(const SchedulerImpl& scheduler) const
+{
+    const auto schedule = scheduler.schedule;
+
+    return wrap(unwrap(wrapped).lift<any>([schedule](const rxcpp::subscriber<any>& destination) {
+        const auto state = std::make_shared<LatestObserveOn>(destination, schedule);
+
+        // The source gets its own lifetime, so its completion doesn't unsubscribe the pending value
+        rxcpp::composite_subscription sourceLifetime;
+        destination.add(sourceLifetime);
+
+        return rxcpp::make_subscriber<any>(sourceLifetime,
+                                           [state](const any& value) { state->onNext(value); },
+                                           [state](std::exception_ptr error) { state->onError(error); },
+                                           [state]() { state->onCompleted(); });
+    }));
+}
 
-juce::Array<any> ObservableImpl::toArray(const std::function<void(std::exception_ptr)>& onError) const
+ObservableImpl ObservableImpl::parallelMap(const SchedulerImpl& scheduler, const std::function<any(const any&)>& function, unsigned int maxConcurrency) const
 {
-    Array<any> values;
+    const auto schedule = scheduler.schedule;
 
-    unwrap(wrapped).as_blocking().subscribe([&](const any& value) {
-        values.add(value);
-    },
-                                            onError);
+    return wrap(unwrap(wrapped).lift<any>([schedule, function, maxConcurrency](const rxcpp::subscriber<any>& destination) {
+        const auto state = std::make_shared<ParallelMap>(destination, schedule, function, maxConcurrency);
 
-    return values;
+        // The source gets its own lifetime, so its completion doesn't unsubscribe the values that are still evaluated
+        rxcpp::composite_subscription sourceLifetime;
+        destination.add(sourceLifetime);
+
+        return rxcpp::make_subscriber<any>(sourceLifetime,
+                                           [state](const any& value) { state->onNext(value); },
+                                           [state](std::exception_ptr error) { state->onError(error); },
+                                           [state]() { state->onCompleted(); });
+    }));
+}
+
+
+#pragma mark - Misc
+
+void ObservableImpl::blockingSubscribe(const std::function<void(const any&)>& onNext, const std::function<void(std::exception_ptr)>& onError) const
+{
+    unwrap(wrapped).as_blocking().subscribe(onNext, onError);
 }
 
 void ObservableImpl::TerminateOnError(std::exception_ptr)
@@ -410,4 +1412,21 @@ void ObservableImpl::TerminateOnError(std::exception_ptr)
 
 void ObservableImpl::EmptyOnCompleted()
 {}
+
+
+#pragma mark - Fusion
+
+ObservableImpl ObservableImpl::fuse(const Stage& stage) const
+{
+    // If this Observable is fused already, apply all stages to its source. Otherwise, this Observable is the source.
+    // Only the rxcpp::observable is kept, so the fused Observable doesn't extend the lifetime of an Observable::fromValue source.
+    const rxcpp::observable<any> source = unwrap(fusion ? fusion->source : wrapped);
+    auto stages = (fusion ? fusion->stages : std::vector<Stage>());
+    stages.push_back(stage);
+
+    ObservableImpl fused(wrap(_transform(source, stages)));
+    fused.fusion = std::make_shared<Fusion>(Fusion{ wrap(source), std::move(stages) });
+
+    return fused;
+}
 }
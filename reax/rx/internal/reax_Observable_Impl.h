@@ -16,8 +16,11 @@ struct ObservableImpl
     static ObservableImpl empty();
     static ObservableImpl error(const std::exception& error);
     static ObservableImpl from(juce::Array<any>&& values);
+    // Calls generator until it returns false. Each subscription gets its own copy of the generator.
+    static ObservableImpl fromGenerator(const std::function<bool(any&)>& generator);
     static ObservableImpl fromValue(juce::Value value);
     static ObservableImpl interval(const juce::RelativeTime& interval);
+    static ObservableImpl interval(const juce::RelativeTime& interval, const SchedulerImpl& scheduler);
     static ObservableImpl just(const any& value);
     static ObservableImpl never();
     static ObservableImpl integralRange(long long first, long long last, unsigned int step);
@@ -33,17 +36,26 @@ struct ObservableImpl
     Subscription subscribe(const ObserverImpl& observer) const;
 
     // Operators
+    // combine is called with the values of each chunk
+    ObservableImpl buffer(unsigned int count, unsigned int skip, const std::function<any(const std::vector<any>&)>& combine) const;
+    ObservableImpl bufferWithTime(const juce::RelativeTime& span, const SchedulerImpl& scheduler, const std::function<any(const std::vector<any>&)>& combine) const;
+    ObservableImpl bufferWithTimeOrCount(const juce::RelativeTime& span, unsigned int count, const SchedulerImpl& scheduler, const std::function<any(const std::vector<any>&)>& combine) const;
     ObservableImpl combineLatest(std::initializer_list<ObservableImpl> others, const any& function) const;
     ObservableImpl concat(const juce::Array<ObservableImpl>& others) const;
     ObservableImpl debounce(const juce::RelativeTime& interval) const;
+    ObservableImpl debounce(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const;
     ObservableImpl distinctUntilChanged(const std::function<bool(const any&, const any&)>& equals) const;
     ObservableImpl elementAt(int index) const;
     ObservableImpl filter(const std::function<bool(const any&)>& predicate) const;
+    // Calls function when a subscription ends (by unsubscribing, onError or onCompleted)
+    ObservableImpl finally(const std::function<void()>& function) const;
     ObservableImpl flatMap(const std::function<ObservableImpl(const any&)>& function) const;
     ObservableImpl map(const std::function<any(const any&)>& function) const;
     ObservableImpl merge(const juce::Array<ObservableImpl>& others) const;
     ObservableImpl reduce(const any& startValue, const std::function<any(const any&, const any&)>& f) const;
     ObservableImpl sample(const juce::RelativeTime& interval) const;
+    ObservableImpl sample(const juce::RelativeTime& interval, const SchedulerImpl& scheduler) const;
+    ObservableImpl sampleOnFrame() const;
     ObservableImpl scan(const any& startValue, const std::function<any(const any&, const any&)>& f) const;
     ObservableImpl skip(unsigned int numValues) const;
     ObservableImpl skipUntil(const ObservableImpl& other) const;
@@ -53,14 +65,28 @@ struct ObservableImpl
     ObservableImpl takeLast(unsigned int numValues) const;
     ObservableImpl takeUntil(const ObservableImpl& other) const;
     ObservableImpl takeWhile(const std::function<bool(const any&)>& predicate) const;
+    ObservableImpl transform(const std::function<bool(any&)>& stage) const;
     ObservableImpl withLatestFrom(std::initializer_list<ObservableImpl> others, const any& function) const;
     ObservableImpl zip(std::initializer_list<ObservableImpl> others, const any& function) const;
 
+    // Operators for any number of Observables. combine is called with one value per Observable. If glitchFree is true, values settle at the end of the PropagationWave.
+    static ObservableImpl combineLatestArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine, bool glitchFree = false);
+    static ObservableImpl mergeArray(const juce::Array<ObservableImpl>& observables);
+    // Emits when the first Observable emits
+    static ObservableImpl withLatestFromArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine, bool glitchFree);
+    static ObservableImpl zipArray(const juce::Array<ObservableImpl>& observables, const std::function<any(const std::vector<any>&)>& combine);
+
     // Scheduling
     ObservableImpl observeOn(const SchedulerImpl& scheduler) const;
+    // Buffers at most `capacity` values that haven't been delivered on the scheduler yet
+    ObservableImpl observeOn(const SchedulerImpl& scheduler, size_t capacity, CongestionPolicy congestionPolicy) const;
+    // Keeps only the latest value that hasn't been delivered on the scheduler yet
+    ObservableImpl observeOnLatest(const SchedulerImpl& scheduler) const;
+    ObservableImpl parallelMap(const SchedulerImpl& scheduler, const std::function<any(const any&)>& function, unsigned int maxConcurrency) const;
 
     // Misc
-    juce::Array<any> toArray(const std::function<void(std::exception_ptr)>& onError) const;
+    // Subscribes and blocks until the Observable terminates
+    void blockingSubscribe(const std::function<void(const any&)>& onNext, const std::function<void(std::exception_ptr)>& onError) const;
 
     // Default error/completion handlers
     [[ noreturn ]] static void TerminateOnError(std::exception_ptr);
@@ -71,5 +97,22 @@ struct ObservableImpl
 
     // The wrapped rxcpp::observable<any>
     any wrapped;
+
+    // A stateless operator that can be fused with adjacent ones. It transforms the value in place, and returns false if the value should be dropped.
+    typedef std::function<bool(any&)> Stage;
+
+    // The rxcpp::observable<any> that consecutive map, filter or transform operators were applied to, and their stages
+    struct Fusion
+    {
+        any source;
+        std::vector<Stage> stages;
+    };
+
+    // Only set if this Observable was created by map, filter or transform. wrapped runs all stages in a single operator.
+    std::shared_ptr<const Fusion> fusion;
+
+private:
+    // Returns an Observable that applies stage after the stages of this Observable, in the same operator.
+    ObservableImpl fuse(const Stage& stage) const;
 };
 }
@@ -5,7 +5,10 @@ ObserverImpl::ObserverImpl(const any& wrapped)
 
 void ObserverImpl::onNext(any&& next) const
 {
+    // Glitch-free operators settle when the value has propagated through all Observables
+    PropagationWave wave;
     wrapped.get<rxcpp::subscriber<any>>().on_next(std::move(next));
+    wave.settle();
 }
 
 void ObserverImpl::onError(std::exception_ptr error) const
@@ -0,0 +1,127 @@
+namespace {
+struct SettleCallback
+{
+    int rank;
+    // Callbacks with the same rank run in the order in which they have been scheduled
+    uint64 sequence;
+    std::function<void()> settle;
+
+    // For the heap: The callback with the lowest rank is on top
+    bool operator<(const SettleCallback& other) const
+    {
+        return (rank != other.rank ? rank > other.rank : sequence > other.sequence);
+    }
+};
+
+// Trivial, so accessing them doesn't allocate (in contrast to thread-locals with constructors)
+thread_local int waveDepth = 0;
+thread_local int emittingRank = -1;
+thread_local uint64 nextSequence = 0;
+thread_local std::vector<SettleCallback>* settleCallbacks = nullptr;
+
+// The ID of the outermost wave on the thread, or 0 if none has been requested yet. IDs are only assigned on request, so a wave without glitch-free operators doesn't touch the shared counter.
+thread_local uint64 currentID = 0;
+std::atomic<uint64> nextID{ 1 };
+
+// Owns the settle callbacks of the thread. Only touched when they're created, so a wave without glitch-free operators never accesses it.
+thread_local std::unique_ptr<std::vector<SettleCallback>> settleCallbacksOwner;
+}
+
+namespace detail {
+PropagationWave::PropagationWave()
+: isOutermost(waveDepth == 0)
+{
+    ++waveDepth;
+}
+
+PropagationWave::~PropagationWave()
+{
+    // If settle() hasn't been called (e.g. because an exception is propagating), the pending callbacks are dropped: They can't be settled by a later wave.
+    // Operators schedule a new callback in the next wave, because its ID is different. Keep the vector, so the next wave reuses its memory.
+    if (isOutermost) {
+        if (settleCallbacks)
+            settleCallbacks->clear();
+
+        currentID = 0;
+    }
+
+    --waveDepth;
+}
+
+void PropagationWave::settle()
+{
+    // Settled twice!
+    jassert(!isSettled);
+    isSettled = true;
+
+    if (!isOutermost || !settleCallbacks)
+        return;
+
+    std::exception_ptr firstError;
+
+    // The wave stays active while settling, so values emitted by the callbacks are settled in the same loop
+    while (!settleCallbacks->empty()) {
+        std::pop_heap(settleCallbacks->begin(), settleCallbacks->end());
+        const auto callback = std::move(settleCallbacks->back().settle);
+        settleCallbacks->pop_back();
+
+        try {
+            callback();
+        }
+        catch (...) {
+            if (!firstError)
+                firstError = std::current_exception();
+        }
+    }
+
+    if (firstError)
+        std::rethrow_exception(firstError);
+}
+
+bool PropagationWave::isActive()
+{
+    return (waveDepth > 0);
+}
+
+void PropagationWave::settleLater(int rank, const std::function<void()>& settle)
+{
+    // There's no wave that could be settled!
+    jassert(isActive());
+
+    // Created once per thread, and reused by all waves on it
+    if (!settleCallbacks) {
+        settleCallbacksOwner.reset(new std::vector<SettleCallback>());
+        settleCallbacks = settleCallbacksOwner.get();
+    }
+
+    settleCallbacks->push_back(SettleCallback{ rank, nextSequence++, settle });
+    std::push_heap(settleCallbacks->begin(), settleCallbacks->end());
+}
+
+int PropagationWave::getEmittingRank()
+{
+    return emittingRank;
+}
+
+uint64 PropagationWave::getCurrentID()
+{
+    // There's no wave!
+    jassert(isActive());
+
+    if (currentID == 0)
+        currentID = nextID.fetch_add(1);
+
+    return currentID;
+}
+
+PropagationWave::EmittingScope::EmittingScope(int rank)
+: previousRank(emittingRank)
+{
+    emittingRank = rank;
+}
+
+PropagationWave::EmittingScope::~EmittingScope()
+{
+    emittingRank = previousRank;
+}
+}
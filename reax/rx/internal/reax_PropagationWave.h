@@ -0,0 +1,58 @@
+#pragma once
+
+namespace detail {
+/**
+ The synchronous propagation of one value through the Observables on the calling thread. A wave begins when a value is pushed into an Observer (e.g. Subject::onNext), or when the message thread runs a scheduled action, and ends when that call returns.
+
+ Operators with Propagation::GlitchFree don't emit during the wave. They call settleLater, and emit once when the outermost wave is settled, after all of their sources have been updated. The settle callbacks are run in order of their rank: An operator's rank is larger than the rank of every operator that emits into it, so an operator that depends on another one settles after it.
+
+ Only uses trivial thread-locals, so a wave on the audio thread doesn't allocate (unless an operator calls settleLater). The settle callbacks are stored in a vector per thread, which is created by the first settleLater call on the thread and reused by all later waves.
+ */
+class PropagationWave
+{
+public:
+    /// Begins a wave, or continues the wave that is already active on the calling thread.
+    PropagationWave();
+
+    /// Ends the wave. Doesn't run any settle callbacks: If the outermost wave ends without having been settled (e.g. because an exception is propagating), its pending callbacks are discarded.
+    ~PropagationWave();
+
+    /**
+     If this is the outermost wave, runs the settle callbacks (which may schedule more callbacks). Does nothing for a nested wave. The owner must call it once, after propagating the value, and before the wave ends.
+
+     If a callback throws, the remaining callbacks still run, and the first exception is rethrown afterwards.
+     */
+    void settle();
+
+    /// Returns true if a wave is active on the calling thread.
+    static bool isActive();
+
+    /// Runs `settle` when the outermost wave on the calling thread ends. Must only be called while a wave is active.
+    static void settleLater(int rank, const std::function<void()>& settle);
+
+    /// Returns the rank of the operator that is currently emitting on the calling thread, or -1.
+    static int getEmittingRank();
+
+    /// Returns an ID of the outermost wave on the calling thread, which is unique across threads. Operators use it to find out whether they have scheduled a callback in the current wave already. Must only be called while a wave is active.
+    static juce::uint64 getCurrentID();
+
+    /// Marks the values that are emitted during its lifetime as coming from an operator with the given rank.
+    class EmittingScope
+    {
+    public:
+        explicit EmittingScope(int rank);
+        ~EmittingScope();
+
+    private:
+        const int previousRank;
+
+        JUCE_DECLARE_NON_COPYABLE(EmittingScope)
+    };
+
+private:
+    const bool isOutermost;
+    bool isSettled = false;
+
+    JUCE_DECLARE_NON_COPYABLE(PropagationWave)
+};
+}
@@ -1,5 +1,73 @@
 namespace detail {
-SchedulerImpl::SchedulerImpl(const Schedule& schedule)
-: schedule(schedule)
+SchedulerImpl::SchedulerImpl(const Schedule& schedule, const rxcpp::schedulers::scheduler& timerScheduler)
+: schedule(schedule),
+  timerScheduler(timerScheduler)
 {}
+
+#pragma mark - VirtualClock
+
+namespace {
+    struct VirtualClockWorker : public rxcpp::schedulers::worker_interface
+    {
+        explicit VirtualClockWorker(const std::shared_ptr<const VirtualClock>& clock)
+        : clock(clock)
+        {}
+
+        clock_type::time_point now() const override
+        {
+            return clock->now();
+        }
+
+        void schedule(const rxcpp::schedulers::schedulable& scheduled) const override
+        {
+            clock->schedule(now(), scheduled);
+        }
+
+        void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& scheduled) const override
+        {
+            clock->schedule(when, scheduled);
+        }
+
+        // Keeps the clock alive while it's used
+        const std::shared_ptr<const VirtualClock> clock;
+    };
+}
+
+VirtualClock::clock_type::time_point VirtualClock::now() const
+{
+    return clock;
+}
+
+rxcpp::schedulers::worker VirtualClock::create_worker(rxcpp::composite_subscription lifetime) const
+{
+    return rxcpp::schedulers::worker(lifetime, std::make_shared<VirtualClockWorker>(std::static_pointer_cast<const VirtualClock>(shared_from_this())));
+}
+
+void VirtualClock::schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& action) const
+{
+    // Actions with the same time stay in FIFO order
+    const auto position = std::upper_bound(queue.begin(), queue.end(), when, [](clock_type::time_point time, const Pending& p) {
+        return time < p.when;
+    });
+    queue.insert(position, Pending{ when, action });
+}
+
+void VirtualClock::advanceTo(clock_type::time_point time) const
+{
+    rxcpp::schedulers::recursion recursion;
+    recursion.reset(true);
+
+    // Actions may schedule more actions while they run, so take them from the queue one by one
+    while (!queue.empty() && queue.front().when <= time) {
+        const auto item = queue.front();
+        queue.pop_front();
+
+        clock = std::max(clock, item.when);
+
+        if (item.action.is_subscribed())
+            item.action(recursion.get_recurse());
+    }
+
+    clock = std::max(clock, time);
+}
 }
@@ -5,8 +5,41 @@ struct SchedulerImpl
 {
     typedef std::function<rxcpp::observable<any>(const rxcpp::observable<any>&)> Schedule;
 
-    SchedulerImpl(const Schedule& schedule);
+    SchedulerImpl(const Schedule& schedule, const rxcpp::schedulers::scheduler& timerScheduler);
 
     const Schedule schedule;
+
+    // Runs the timers of time-based operators (like Observable::debounce), which also emit on it
+    const rxcpp::schedulers::scheduler timerScheduler;
+};
+
+// The clock of a VirtualTimeScheduler. Scheduled actions wait in a time-ordered queue, until the clock is advanced past them.
+class VirtualClock : public rxcpp::schedulers::scheduler_interface
+{
+public:
+    clock_type::time_point now() const override;
+
+    rxcpp::schedulers::worker create_worker(rxcpp::composite_subscription lifetime) const override;
+
+    void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& action) const;
+
+    // Runs all actions that are due until `time` (including the ones that are due now), then sets the clock to `time`
+    void advanceTo(clock_type::time_point time) const;
+
+private:
+    struct Pending
+    {
+        clock_type::time_point when;
+        rxcpp::schedulers::schedulable action;
+    };
+
+    mutable clock_type::time_point clock;
+    mutable std::deque<Pending> queue;
+};
+
+struct VirtualTimeImpl
+{
+    const std::shared_ptr<VirtualClock> virtualClock = std::make_shared<VirtualClock>();
+    const rxcpp::schedulers::scheduler scheduler = rxcpp::schedulers::make_scheduler(virtualClock);
 };
 }
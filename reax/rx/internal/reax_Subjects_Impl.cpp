@@ -1,4 +1,340 @@
 namespace {
+// A subject whose subscribers are stored in an immutable vector. Emitting iterates over the current snapshot without locking (loading the snapshot may take the standard library's short shared_ptr lock); subscribing and unsubscribing copy the vector and swap it atomically.
+class CopyOnWriteSubject : public std::enable_shared_from_this<CopyOnWriteSubject>
+{
+public:
+    typedef std::vector<std::pair<uint64, rxcpp::subscriber<any>>> Subscribers;
+
+    CopyOnWriteSubject()
+    : subscribers(std::make_shared<const Subscribers>())
+    {}
+
+    void onNext(const any& value) const
+    {
+        const std::shared_ptr<const Subscribers> snapshot = std::atomic_load(&subscribers);
+
+        // Subscribers that have been unsubscribed since the snapshot was taken are skipped by on_next
+        for (auto& subscriber : *snapshot)
+            subscriber.second.on_next(value);
+    }
+
+    void onError(std::exception_ptr e)
+    {
+        for (auto& subscriber : *terminate(e))
+            subscriber.second.on_error(e);
+    }
+
+    void onCompleted()
+    {
+        for (auto& subscriber : *terminate(std::exception_ptr()))
+            subscriber.second.on_completed();
+    }
+
+    void subscribe(const rxcpp::subscriber<any>& subscriber)
+    {
+        uint64 id = 0;
+        bool isTerminated = false;
+        std::exception_ptr terminalError;
+
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (terminated) {
+                isTerminated = true;
+                terminalError = error;
+            }
+            else {
+                id = ++lastId;
+
+                auto newSubscribers = std::make_shared<Subscribers>(*subscribers);
+                newSubscribers->emplace_back(id, subscriber);
+                std::atomic_store(&subscribers, std::shared_ptr<const Subscribers>(std::move(newSubscribers)));
+            }
+        }
+
+        // Like rxcpp's subjects, notify late subscribers about the termination
+        if (isTerminated) {
+            if (terminalError)
+                subscriber.on_error(terminalError);
+            else
+                subscriber.on_completed();
+
+            return;
+        }
+
+        // Weak, because the subscriber is owned by the subscriber list
+        std::weak_ptr<CopyOnWriteSubject> weakThis(shared_from_this());
+        subscriber.add([weakThis, id]() {
+            if (auto strongThis = weakThis.lock())
+                strongThis->unsubscribe(id);
+        });
+    }
+
+private:
+    std::shared_ptr<const Subscribers> subscribers;
+
+    // Serializes changes to the subscriber list. Never held while calling a subscriber.
+    std::mutex mutex;
+    uint64 lastId = 0;
+    bool terminated = false;
+    std::exception_ptr error;
+
+    void unsubscribe(uint64 id)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto newSubscribers = std::make_shared<Subscribers>(*subscribers);
+        newSubscribers->erase(std::remove_if(newSubscribers->begin(), newSubscribers->end(), [id](const Subscribers::value_type& subscriber) { return subscriber.first == id; }),
+                              newSubscribers->end());
+        std::atomic_store(&subscribers, std::shared_ptr<const Subscribers>(std::move(newSubscribers)));
+    }
+
+    // Clears the subscriber list and returns the subscribers that must be notified. Returns an empty list if already terminated.
+    std::shared_ptr<const Subscribers> terminate(std::exception_ptr e)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (terminated)
+            return std::make_shared<const Subscribers>();
+
+        terminated = true;
+        error = e;
+
+        return std::atomic_exchange(&subscribers, std::make_shared<const Subscribers>());
+    }
+};
+
+// A replay subject that stores the values in a ring of `bufferSize` slots, which is allocated upfront.
+//
+// The lock only protects the ring and the subscriber list. Values are delivered after unlocking, from a snapshot of the subscriber list, so subscribers may block on other threads that emit into or subscribe to this subject. Each value gets a sequence number. A new subscriber takes a snapshot of the ring and is added to the list in the same critical section, so the replay covers exactly the values before its first live sequence number. Live values that arrive while it's still replaying are queued, and delivered after the replay.
+class RingReplaySubject : public std::enable_shared_from_this<RingReplaySubject>
+{
+public:
+    // The slots are filled with placeholders, which are never emitted
+    explicit RingReplaySubject(size_t bufferSize)
+    : ring(bufferSize, any(0))
+    {}
+
+    void onNext(const any& value)
+    {
+        uint64 sequenceNumber = 0;
+        std::shared_ptr<const Subscribers> snapshot;
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (terminated)
+                return;
+
+            if (!ring.empty()) {
+                ring[(start + numValues) % ring.size()] = value;
+
+                if (numValues < ring.size())
+                    ++numValues;
+                else
+                    start = (start + 1) % ring.size();
+            }
+
+            sequenceNumber = nextSequenceNumber++;
+            snapshot = subscribers;
+        }
+
+        for (auto& subscriber : *snapshot)
+            subscriber->deliver(Item{ Item::Next, value, nullptr }, sequenceNumber);
+    }
+
+    void onError(std::exception_ptr e)
+    {
+        terminate(Item{ Item::Error, any(0), e });
+    }
+
+    void onCompleted()
+    {
+        terminate(Item{ Item::Completed, any(0), nullptr });
+    }
+
+    void subscribe(const rxcpp::subscriber<any>& destination)
+    {
+        const auto subscriber = std::make_shared<Subscriber>(destination);
+        std::vector<any> replay;
+        rxcpp::util::maybe<Item> termination;
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+
+            replay.reserve(numValues);
+            for (size_t i = 0; i < numValues; ++i)
+                replay.push_back(ring[(start + i) % ring.size()]);
+
+            if (terminated)
+                termination.reset(terminalItem);
+            else {
+                subscriber->firstLiveSequenceNumber = nextSequenceNumber;
+
+                auto newSubscribers = std::make_shared<Subscribers>(*subscribers);
+                newSubscribers->push_back(subscriber);
+                subscribers = newSubscribers;
+            }
+        }
+
+        if (termination.empty()) {
+            std::weak_ptr<RingReplaySubject> weakThis(shared_from_this());
+            const std::weak_ptr<Subscriber> weakSubscriber(subscriber);
+            destination.add([weakThis, weakSubscriber]() {
+                if (auto strongThis = weakThis.lock())
+                    strongThis->unsubscribe(weakSubscriber);
+            });
+        }
+
+        for (auto& value : replay)
+            subscriber->emit(Item{ Item::Next, value, nullptr });
+
+        if (!termination.empty())
+            subscriber->emit(termination.get());
+
+        subscriber->finishReplay();
+    }
+
+private:
+    struct Item
+    {
+        enum Kind
+        {
+            Next,
+            Error,
+            Completed
+        };
+
+        Kind kind;
+        any value;
+        std::exception_ptr error;
+    };
+
+    // A subscriber, and the live values that arrive while it's still receiving the replay
+    struct Subscriber
+    {
+        explicit Subscriber(const rxcpp::subscriber<any>& destination)
+        : destination(destination)
+        {}
+
+        // Called for live values, after the subject has been unlocked
+        void deliver(const Item& item, uint64 sequenceNumber)
+        {
+            // Covered by the replay
+            if (sequenceNumber < firstLiveSequenceNumber)
+                return;
+
+            {
+                REAX_LOCK_WILL_BE_ACQUIRED();
+                std::lock_guard<std::mutex> lock(queueLock);
+                if (isReplaying) {
+                    queue.push_back(item);
+                    return;
+                }
+            }
+
+            emit(item);
+        }
+
+        // Delivers the queued live values, until the queue stays empty
+        void finishReplay()
+        {
+            for (;;) {
+                rxcpp::util::maybe<Item> item;
+                {
+                    REAX_LOCK_WILL_BE_ACQUIRED();
+                    std::lock_guard<std::mutex> lock(queueLock);
+                    if (queue.empty()) {
+                        isReplaying = false;
+                        return;
+                    }
+
+                    item.reset(queue.front());
+                    queue.pop_front();
+                }
+
+                emit(item.get());
+            }
+        }
+
+        void emit(const Item& item) const
+        {
+            if (!destination.is_subscribed())
+                return;
+
+            switch (item.kind) {
+                case Item::Next:
+                    destination.on_next(item.value);
+                    break;
+                case Item::Error:
+                    destination.on_error(item.error);
+                    break;
+                case Item::Completed:
+                    destination.on_completed();
+                    break;
+            }
+        }
+
+        const rxcpp::subscriber<any> destination;
+        uint64 firstLiveSequenceNumber = 0;
+
+        std::mutex queueLock;
+        bool isReplaying = true;
+        std::deque<Item> queue;
+    };
+
+    typedef std::vector<std::shared_ptr<Subscriber>> Subscribers;
+
+    // Protects the ring and the subscriber list. Never held while calling a subscriber.
+    std::mutex mutex;
+    std::vector<any> ring;
+    size_t start = 0;
+    size_t numValues = 0;
+    uint64 nextSequenceNumber = 0;
+
+    // Copy-on-write, so emitting a value only copies the pointer
+    std::shared_ptr<const Subscribers> subscribers = std::make_shared<const Subscribers>();
+    bool terminated = false;
+    Item terminalItem{ Item::Completed, any(0), nullptr };
+
+    void terminate(const Item& item)
+    {
+        uint64 sequenceNumber = 0;
+        std::shared_ptr<const Subscribers> snapshot;
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (terminated)
+                return;
+
+            terminated = true;
+            terminalItem = item;
+            sequenceNumber = nextSequenceNumber++;
+            snapshot = subscribers;
+            subscribers = std::make_shared<const Subscribers>();
+        }
+
+        for (auto& subscriber : *snapshot)
+            subscriber->deliver(item, sequenceNumber);
+    }
+
+    void unsubscribe(const std::weak_ptr<Subscriber>& weakSubscriber)
+    {
+        const auto subscriber = weakSubscriber.lock();
+
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto newSubscribers = std::make_shared<Subscribers>(*subscribers);
+        newSubscribers->erase(std::remove(newSubscribers->begin(), newSubscribers->end(), subscriber), newSubscribers->end());
+        subscribers = newSubscribers;
+    }
+};
+
 template<typename SubjectType, typename... Args>
 detail::SubjectImpl MakeSubjectImpl(Args&&... args)
 {
@@ -11,7 +347,38 @@ detail::SubjectImpl MakeSubjectImpl(Args&&... args)
 namespace detail {
 SubjectImpl SubjectImpl::MakeBehaviorSubjectImpl(any&& initial)
 {
-    return MakeSubjectImpl<rxcpp::subjects::behavior<any>>(std::move(initial));
+    return MakeBehaviorSubjectImpl(std::move(initial), nullptr);
+}
+
+SubjectImpl SubjectImpl::MakeBehaviorSubjectImpl(any&& initial, const std::function<void(const any&)>& willEmit)
+{
+    auto subject = std::make_shared<rxcpp::subjects::behavior<any>>(std::move(initial));
+    const auto subscriber = subject->get_subscriber();
+
+    const TransactionState::Emit emit = [subscriber, willEmit](const any& value) {
+        if (willEmit)
+            willEmit(value);
+
+        subscriber.on_next(value);
+    };
+
+    // Values are deferred while a Transaction is active on the calling thread
+    const std::shared_ptr<const void> key(subject);
+    auto observer = rxcpp::make_subscriber<any>([key, emit](const any& value) {
+                                                    if (!TransactionState::getCurrent().defer(key, value, emit))
+                                                        emit(value);
+                                                },
+                                                [key, subscriber](std::exception_ptr e) {
+                                                    TransactionState::getCurrent().flush(key.get());
+                                                    subscriber.on_error(e);
+                                                },
+                                                [key, subscriber]() {
+                                                    TransactionState::getCurrent().flush(key.get());
+                                                    subscriber.on_completed();
+                                                })
+                        .as_dynamic();
+
+    return SubjectImpl(any(subject), any(observer), any(subject->get_observable().as_dynamic()));
 }
 
 SubjectImpl SubjectImpl::MakePublishSubjectImpl()
@@ -19,19 +386,60 @@ SubjectImpl SubjectImpl::MakePublishSubjectImpl()
     return MakeSubjectImpl<rxcpp::subjects::subject<any>>();
 }
 
+SubjectImpl SubjectImpl::MakeConcurrentPublishSubjectImpl()
+{
+    auto subject = std::make_shared<CopyOnWriteSubject>();
+
+    auto observer = rxcpp::make_subscriber<any>([subject](const any& value) { subject->onNext(value); },
+                                                [subject](std::exception_ptr e) { subject->onError(e); },
+                                                [subject]() { subject->onCompleted(); })
+                        .as_dynamic();
+
+    auto observable = rxcpp::observable<>::create<any>([subject](const rxcpp::subscriber<any>& subscriber) {
+        subject->subscribe(subscriber);
+    });
+
+    return SubjectImpl(any(subject), any(observer), any(observable.as_dynamic()));
+}
+
 SubjectImpl SubjectImpl::MakeReplaySubjectImpl(size_t bufferSize)
 {
     return MakeSubjectImpl<rxcpp::subjects::replay<any, rxcpp::identity_one_worker>>(bufferSize, rxcpp::identity_immediate());
 }
 
+SubjectImpl SubjectImpl::MakePreallocatedReplaySubjectImpl(size_t bufferSize)
+{
+    auto subject = std::make_shared<RingReplaySubject>(bufferSize);
+
+    auto observer = rxcpp::make_subscriber<any>([subject](const any& value) { subject->onNext(value); },
+                                                [subject](std::exception_ptr e) { subject->onError(e); },
+                                                [subject]() { subject->onCompleted(); })
+                        .as_dynamic();
+
+    auto observable = rxcpp::observable<>::create<any>([subject](const rxcpp::subscriber<any>& subscriber) {
+        subject->subscribe(subscriber);
+    });
+
+    return SubjectImpl(any(subject), any(observer), any(observable.as_dynamic()));
+}
+
 any SubjectImpl::getValue() const
 {
     return wrapped.get<std::shared_ptr<rxcpp::subjects::behavior<any>>>()->get_value();
 }
 
+bool SubjectImpl::hasObservers() const
+{
+    return wrapped.get<std::shared_ptr<rxcpp::subjects::subject<any>>>()->has_observers();
+}
+
 SubjectImpl::SubjectImpl(const any& subject, const any& observer, const any& observable)
 : ObserverImpl(observer),
   ObservableImpl(observable),
   wrapped(subject)
+#if REAX_ENABLE_DIAGNOSTICS
+  ,
+  diagnosticsToken(Diagnostics::trackSubject())
+#endif
 {}
 }
@@ -4,13 +4,25 @@ namespace detail {
 struct SubjectImpl : public ObserverImpl, public ObservableImpl
 {
     static SubjectImpl MakeBehaviorSubjectImpl(any&& initial);
+    // Calls willEmit with each new value, before the value is emitted. Emissions are deferred while a Transaction is active.
+    static SubjectImpl MakeBehaviorSubjectImpl(any&& initial, const std::function<void(const any&)>& willEmit);
     static SubjectImpl MakePublishSubjectImpl();
+    static SubjectImpl MakeConcurrentPublishSubjectImpl();
     static SubjectImpl MakeReplaySubjectImpl(size_t bufferSize);
+    static SubjectImpl MakePreallocatedReplaySubjectImpl(size_t bufferSize);
 
     any getValue() const;
 
+    // Only for PublishSubjects
+    bool hasObservers() const;
+
     explicit SubjectImpl(const any& subject, const any& observer, const any& observable);
     
     const any wrapped;
+
+#if REAX_ENABLE_DIAGNOSTICS
+    // Shared between copies, so each subject is counted once
+    const std::shared_ptr<void> diagnosticsToken;
+#endif
 };
 }
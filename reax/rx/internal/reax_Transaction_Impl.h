@@ -0,0 +1,36 @@
+#pragma once
+
+namespace detail {
+// The changes that are deferred by the Transactions on one thread
+class TransactionState
+{
+public:
+    typedef std::function<void(const any&)> Emit;
+
+    // Returns the state of the calling thread
+    static TransactionState& getCurrent();
+
+    // If a Transaction is active, remembers `value` as the latest value of `subject` and returns true. Otherwise, returns false, and the value must be emitted right away.
+    bool defer(const std::shared_ptr<const void>& subject, const any& value, const Emit& emit);
+
+    // Emits the deferred value of `subject` (if any) now, e.g. before it terminates
+    void flush(const void* subject);
+
+    void begin();
+    void end();
+    bool isActive() const;
+
+private:
+    struct Deferred
+    {
+        std::shared_ptr<const void> subject;
+        any value;
+        Emit emit;
+    };
+
+    int depth = 0;
+    std::vector<Deferred> deferred;
+    // The index of each subject in deferred
+    std::unordered_map<const void*, size_t> indices;
+};
+}
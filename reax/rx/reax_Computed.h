@@ -0,0 +1,157 @@
+#pragma once
+
+/**
+ A derived value that is computed lazily from an upstream Observable, and cached until upstream changes.
+
+ Use this instead of Observable::map for expensive values (like layout geometry, or formatted text for many labels) that aren't always needed:
+
+     Computed<juce::String> label(gain.combineLatest(unit), [](float gain, const juce::String& unit) {
+         return formatGain(gain, unit);
+     });
+
+     label.getValue();               // Computes the value, or returns the cached one
+     label.subscribe(updateLabel);   // Observes upstream, and recomputes whenever it changes
+
+ While nobody subscribes, the Computed doesn't observe upstream at all: Upstream changes don't cost anything, and getValue() takes the current upstream value (by subscribing to it briefly) and only recomputes if that value has changed. While there are subscribers, upstream is observed, and the value is recomputed (and emitted) whenever upstream emits a different value. When the last subscriber unsubscribes, the upstream subscription is paused again.
+
+ Upstream must emit its current value on subscribe, like a BehaviorSubject (or a combineLatest of BehaviorSubjects). Otherwise, getValue() throws a std::runtime_error until upstream has emitted a value. New subscribers receive the current value first. Upstream values are compared with operator== (if they have one), so unchanged values don't cause a recomputation.
+
+ Reading an unobserved Computed has a cost: Each getValue() subscribes to upstream and unsubscribes again (for a combineLatest, that's one subscription per source). And if the upstream type has no operator==, each value is a different one, so each getValue() recomputes. If you read the value often, keep a subscription to the Computed, so it observes upstream and getValue() just returns the cached value.
+
+ Like a Subject, the Observable side stays connected if it's copied and the Computed is destroyed. Not thread-safe: Use it on one thread (usually the message thread).
+ */
+template<typename T>
+class Computed : public Observable<T>
+{
+public:
+    /// Creates a new instance, which calls `compute` with the latest value of `upstream` when its value is needed. Doesn't compute or subscribe to `upstream` yet.
+    template<typename U, typename Function>
+    Computed(const Observable<U>& upstream, Function&& compute)
+    : Computed(std::make_shared<State<U>>(upstream, std::forward<Function>(compute)))
+    {}
+
+    /// Returns the computed value. Recomputes it first, if upstream has changed since it has been computed. Throws a std::runtime_error if upstream hasn't emitted a value yet.
+    T getValue() const
+    {
+        return state->getValue();
+    }
+
+    /// Returns true while the Computed has subscribers, so it observes upstream.
+    bool isObservingUpstream() const
+    {
+        return state->numSubscribers > 0;
+    }
+
+private:
+    typedef detail::any any;
+
+    // The part of the state that doesn't depend on the upstream type
+    struct StateBase
+    {
+        virtual ~StateBase() {}
+        virtual T getValue() = 0;
+        virtual void connect() = 0;
+        virtual void disconnect() = 0;
+
+        PublishSubject<T> subject;
+        int numSubscribers = 0;
+    };
+
+    template<typename U>
+    struct State : public StateBase
+    {
+        template<typename Function>
+        State(const Observable<U>& upstream, Function&& compute)
+        : upstream(upstream),
+          compute(std::forward<Function>(compute))
+        {}
+
+        T getValue() override
+        {
+            // Not observing upstream, so take its current value
+            if (StateBase::numSubscribers == 0)
+                upstream.subscribe([this](const U& value) { setInput(value); }).unsubscribe();
+
+            if (!hasInput)
+                throw std::runtime_error("Computed::getValue: Upstream hasn't emitted a value. It must emit its current value on subscribe, like a BehaviorSubject.");
+
+            updateIfNeeded();
+            return *value;
+        }
+
+        void connect() override
+        {
+            if (StateBase::numSubscribers++ > 0)
+                return;
+
+            upstream.subscribe([this](const U& newInput) {
+                        setInput(newInput);
+
+                        if (updateIfNeeded())
+                            StateBase::subject.onNext(*value);
+                    })
+                .disposedBy(upstreamSubscription);
+        }
+
+        void disconnect() override
+        {
+            if (--StateBase::numSubscribers == 0)
+                upstreamSubscription.clear();
+        }
+
+        void setInput(const U& newInput)
+        {
+            input = any(newInput);
+            hasInput = true;
+        }
+
+        // Recomputes the value if the input has changed. Returns true if it has been recomputed.
+        bool updateIfNeeded()
+        {
+            if (!hasInput || (value && input == computedInput))
+                return false;
+
+            value.reset(new T(compute(input.template get<U>())));
+            computedInput = input;
+            return true;
+        }
+
+        const Observable<U> upstream;
+        const std::function<T(const U&)> compute;
+        DisposeBag upstreamSubscription;
+
+        // The latest upstream value, and the one that the cached value has been computed from
+        any input{ false };
+        any computedInput{ false };
+        bool hasInput = false;
+        std::unique_ptr<T> value;
+    };
+
+    const std::shared_ptr<StateBase> state;
+
+    explicit Computed(const std::shared_ptr<StateBase>& state)
+    : Observable<T>(makeObservable(state)),
+      state(state)
+    {}
+
+    static Observable<T> makeObservable(const std::shared_ptr<StateBase>& state)
+    {
+        return Observable<T>::defer([state]() {
+            // Observe upstream first, so the current value doesn't need a separate upstream subscription
+            state->connect();
+
+            try {
+                return Observable<T>(state->subject.startWith({ state->getValue() }).impl.finally([state]() {
+                    state->disconnect();
+                }));
+            }
+            catch (...) {
+                // The subscription fails with onError, so finally is never attached
+                state->disconnect();
+                throw;
+            }
+        });
+    }
+
+    JUCE_LEAK_DETECTOR(Computed)
+};
@@ -1,12 +1,96 @@
+const uint32 DisposeBag::NoSlot = std::numeric_limits<uint32>::max();
+
 DisposeBag::DisposeBag()
-: wrapped(rxcpp::composite_subscription()) {}
+: firstFree(NoSlot),
+  numUsed(0)
+{}
 
 DisposeBag::~DisposeBag()
 {
-    wrapped.get<rxcpp::composite_subscription>().unsubscribe();
+    clear();
+}
+
+DisposeBag::Handle DisposeBag::insert(const Subscription& subscription)
+{
+    uint32 index = firstFree;
+
+    if (index != NoSlot)
+        firstFree = slots[index].nextFree;
+    else {
+        index = static_cast<uint32>(slots.size());
+        slots.push_back(Slot{ Subscription::placeholder(), 0, NoSlot, false });
+    }
+
+    Slot& slot = slots[index];
+    slot.subscription = subscription;
+    slot.isUsed = true;
+    ++numUsed;
+
+    Handle handle;
+    handle.index = index;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+void DisposeBag::dispose(const Handle& handle)
+{
+    if (handle.index >= slots.size() || !slots[handle.index].isUsed || slots[handle.index].generation != handle.generation)
+        return;
+
+    // Copy it, because unsubscribing may insert into this DisposeBag
+    const Subscription subscription = slots[handle.index].subscription;
+    release(handle.index);
+    slots[handle.index].nextFree = firstFree;
+    firstFree = handle.index;
+
+    subscription.unsubscribe();
+}
+
+void DisposeBag::clear()
+{
+    // Take the Subscriptions out and release all slots before unsubscribing: Unsubscribing may insert into or dispose from this DisposeBag, and Subscriptions that are inserted meanwhile must stay in it. The released slots keep their generations, so old Handles don't match the new Subscriptions.
+    std::vector<Subscription> subscriptions;
+    subscriptions.swap(clearBuffer);
+    subscriptions.reserve(numUsed);
+
+    firstFree = NoSlot;
+    for (uint32 index = static_cast<uint32>(slots.size()); index-- > 0;) {
+        if (slots[index].isUsed) {
+            subscriptions.push_back(slots[index].subscription);
+            release(index);
+        }
+
+        slots[index].nextFree = firstFree;
+        firstFree = index;
+    }
+
+    // Unsubscribe in slot order
+    for (auto it = subscriptions.rbegin(); it != subscriptions.rend(); ++it)
+        it->unsubscribe();
+
+    // Keep the memory for the next clear
+    subscriptions.clear();
+    if (subscriptions.capacity() > clearBuffer.capacity())
+        clearBuffer.swap(subscriptions);
 }
 
-void DisposeBag::insert(const Subscription& subscription)
+void DisposeBag::reserve(size_t numSubscriptions)
 {
-    wrapped.get<rxcpp::composite_subscription>().add(subscription.wrapped.get<rxcpp::subscription>());
+    slots.reserve(numSubscriptions);
+}
+
+size_t DisposeBag::size() const
+{
+    return numUsed;
+}
+
+void DisposeBag::release(uint32 index)
+{
+    Slot& slot = slots[index];
+
+    // Drops the reference to the subscription, without allocating
+    slot.subscription = Subscription::placeholder();
+    slot.isUsed = false;
+    ++slot.generation;
+    --numUsed;
 }
@@ -4,21 +4,66 @@ class Subscription;
 
 /**
     Disposes added `Subscription​`s when it is destroyed.
+ 
+    The `Subscription`​s are stored in a contiguous slab of slots. Inserting and disposing a single `Subscription` take constant time, and free slots are reused. So a `DisposeBag` can be used for many short-lived subscriptions (e.g. one per row of a list, while scrolling).
+ 
+    A `DisposeBag` is not thread-safe: Call insert(), dispose() and clear() from one thread at a time.
  */
 class DisposeBag
 {
 public:
+    /// Identifies a `Subscription` in a `DisposeBag`, to dispose it individually. A default-constructed Handle doesn't refer to any `Subscription`.
+    class Handle
+    {
+    public:
+        Handle() = default;
+
+    private:
+        friend class DisposeBag;
+
+        juce::uint32 index = std::numeric_limits<juce::uint32>::max();
+        juce::uint32 generation = 0;
+    };
+
     /// Creates a new, empty `DisposeBag`.
     DisposeBag();
 
     /// Disposes all inserted `Subscription`​s in the `DisposeBag`.
     ~DisposeBag();
 
-    /// Inserts a `Subscription` into the `DisposeBag`. The `Subscription` is disposed when the `DisposeBag` is destroyed. 
-    void insert(const Subscription& subscription);
+    /// Inserts a `Subscription` into the `DisposeBag`. The `Subscription` is disposed when the `DisposeBag` is destroyed. Returns a Handle, which you can pass to dispose() to dispose the `Subscription` earlier.
+    Handle insert(const Subscription& subscription);
+
+    /// Disposes a single `Subscription` and removes it from the `DisposeBag`. Does nothing if it has already been disposed (or the `DisposeBag` has been cleared since).
+    void dispose(const Handle& handle);
+
+    /// Disposes all inserted `Subscription`​s. The `DisposeBag` keeps its capacity, so inserting new `Subscription`​s doesn't allocate until it grows beyond that.
+    void clear();
+
+    /// Makes room for `numSubscriptions` `Subscription`​s, so inserting them doesn't allocate.
+    void reserve(size_t numSubscriptions);
+
+    /// Returns the number of `Subscription`​s that haven't been disposed yet.
+    size_t size() const;
 
 private:
-    detail::any wrapped;
+    struct Slot
+    {
+        Subscription subscription;
+        juce::uint32 generation;
+        juce::uint32 nextFree;
+        bool isUsed;
+    };
+
+    static const juce::uint32 NoSlot;
+
+    std::vector<Slot> slots;
+    juce::uint32 firstFree;
+    size_t numUsed;
+    // Holds the Subscriptions while clear() unsubscribes them. Kept between calls, so clearing doesn't allocate unless the DisposeBag has grown.
+    std::vector<Subscription> clearBuffer;
+
+    void release(juce::uint32 index);
 
     JUCE_LEAK_DETECTOR(DisposeBag)
 };
@@ -3,6 +3,20 @@
 template<typename T>
 class Observer;
 
+template<typename T>
+class LazyObserver;
+
+template<typename Source, typename T, typename Stage>
+class TypedPipeline;
+
+template<typename T>
+class Computed;
+
+namespace detail {
+template<typename T>
+struct IdentityStage;
+}
+
 /**
  An Observable emits values over time.
  
@@ -92,12 +106,49 @@ public:
      */
     static Observable<T> from(const juce::Array<T>& array)
     {
-        juce::Array<any> values;
+        // The values are only wrapped when they're emitted
+        const auto values = std::make_shared<const juce::Array<T>>(array);
+        int index = 0;
 
-        for (auto& value : array)
-            values.add(Observable<T>::toAny(value));
+        return Impl::fromGenerator([values, index](any& next) mutable -> bool {
+            if (index >= values->size())
+                return false;
 
-        return Impl::from(std::move(values));
+            next = Observable<T>::toAny(values->getReference(index++));
+            return true;
+        });
+    }
+
+    /**
+     Creates an Observable that produces its values lazily, by calling a `generator` function. The generator stores the next value in its argument and returns `true`, or returns `false` if there are no more values. The Observable then completes.
+     
+     The next value is only produced after the subscriber has processed the previous one, and the generator isn't called anymore once the subscriber unsubscribes (e.g. when using Observable::take). So the values are never held in memory all at once. For example, to read a large file frame by frame:
+     
+         int64 position = 0;
+         Observable<AudioBuffer<float>>::fromGenerator([reader, position](AudioBuffer<float>& frame) mutable -> bool {
+             if (position >= reader->lengthInSamples)
+                 return false;
+     
+             frame.setSize(2, 512);
+             reader->read(&frame, 0, 512, position, true, true);
+             position += 512;
+             return true;
+         });
+     
+     Each subscription gets its own copy of the `generator`, so a generator that keeps its state in captured variables starts from the beginning for each subscriber. The generator is called on the thread that subscribes, until the Observable completes. An exception thrown by the generator notifies `onError`.
+     
+     If the values are passed to another thread (e.g. with Observable::observeOn), they are produced as fast as the generator can, and are queued on that thread.
+     */
+    static Observable<T> fromGenerator(const std::function<bool(T& next)>& generator)
+    {
+        return Impl::fromGenerator([generator](any& next) -> bool {
+            T value;
+            if (!generator(value))
+                return false;
+
+            next = Observable<T>::toAny(std::move(value));
+            return true;
+        });
     }
 
     /**
@@ -126,6 +177,13 @@ public:
         return Impl::interval(interval);
     }
 
+    /// Like interval(const juce::RelativeTime&), but the timer runs on `scheduler`, and the values are emitted on it. Pass a VirtualTimeScheduler to test it without waiting.
+    template<typename U = T>
+    static Observable<T> interval(const juce::RelativeTime& interval, const Scheduler& scheduler, typename std::enable_if<std::is_same<U, T>::value && std::is_same<int, T>::value>::type* = 0)
+    {
+        return Impl::interval(interval, *scheduler.impl);
+    }
+
     /**
      Creates an Observable which emits a single value.
      
@@ -219,6 +277,24 @@ public:
                               onCompleted);
     }
 
+    /**
+     Like subscribe, but moves each value into `onNext`. Use this to receive move-only values (like `std::unique_ptr<juce::AudioBuffer<float>>`), or to take ownership of a large value without copying it.
+
+     Values are moved out of the pipeline, so this must be the **only subscriber** that receives them: If another subscriber gets a value after it has been moved out, it throws an exception. Scalars and small values that are stored inline are copied instead.
+
+     To share large, immutable values between several subscribers without copying, use Shared<T> instead.
+     */
+    Subscription subscribeByMoving(const std::function<void(T&&)>& onNext,
+                                   const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError,
+                                   const std::function<void()>& onCompleted = Impl::EmptyOnCompleted) const
+    {
+        return impl.subscribe([onNext](const any& next) {
+            onNext(next.take<T>());
+        },
+                              onError,
+                              onCompleted);
+    }
+
     /**
      Subscribes an Observer to an Observable. The Observer is notified whenever the Observable emits a value, or notifies `onError` / `onCompleted`.
      
@@ -234,10 +310,72 @@ public:
 
         return impl.map(convert).subscribe(observer.impl);
     }
+
+    /// Subscribes a LazyObserver (a property of a GUI extension, like `myLabel.rx.font`) to an Observable.
+    template<typename U>
+    Subscription subscribe(const LazyObserver<U>& observer, typename std::enable_if<std::is_convertible<T, U>::value>::type* = 0) const
+    {
+        return subscribe(observer.asObserver());
+    }
         ///@}
 
 
 #pragma mark - Operators
+    /**
+     Collects the values of this Observable into chunks of `count` values, and emits each chunk as a juce::Array. When this Observable completes, the remaining values are emitted as a smaller chunk (if there are any).
+     
+     Use this to process high-rate streams (like MIDI input or log lines) in batches instead of one value at a time:
+     
+         Observable<int>::range(1, 7).buffer(3); // Emits { 1, 2, 3 }, { 4, 5, 6 } and { 7 }
+     
+     Each chunk is filled in a buffer that's reused for the whole subscription, and is copied into an Array with the exact size once it's complete.
+     */
+    Observable<juce::Array<T>> buffer(unsigned int count) const
+    {
+        // Must buffer at least one value!
+        jassert(count > 0);
+
+        return impl.buffer(count, count, &valuesToArray);
+    }
+
+    /**
+     Like buffer(unsigned int), but starts a new chunk every `skip` values. If `skip` is smaller than `count`, the chunks overlap. If it's larger, some values are dropped.
+     
+         Observable<int>::range(1, 5).buffer(3, 1); // Emits { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 }, { 4, 5 } and { 5 }
+     */
+    Observable<juce::Array<T>> buffer(unsigned int count, unsigned int skip) const
+    {
+        // Must buffer at least one value, and start a new chunk after at least one value!
+        jassert(count > 0 && skip > 0);
+
+        return impl.buffer(count, skip, &valuesToArray);
+    }
+
+    /**
+     Collects the values which this Observable emits during each `span`, and emits them as a juce::Array at the end of the span. Empty chunks are emitted too, so a subscriber can rely on being called once per span.
+     
+     The timer runs on `scheduler`, and the chunks are emitted on it. By default, that's the message thread, so you can paint the values (like meter points) in batches:
+     
+         meterPoints.bufferWithTime(RelativeTime::seconds(1.0 / 30)).subscribe([this](const Array<float>& points) { meter.addPoints(points); });
+     
+     The span has millisecond resolution.
+     */
+    Observable<juce::Array<T>> bufferWithTime(const juce::RelativeTime& span, const Scheduler& scheduler = Scheduler::messageThread()) const
+    {
+        return impl.bufferWithTime(span, *scheduler.impl, &valuesToArray);
+    }
+
+    /**
+     Like bufferWithTime, but emits a chunk early if it has reached `count` values. Then a new span starts. Use this to bound both the delay and the size of the chunks.
+     */
+    Observable<juce::Array<T>> bufferWithTimeOrCount(const juce::RelativeTime& span, unsigned int count, const Scheduler& scheduler = Scheduler::messageThread()) const
+    {
+        // Must buffer at least one value!
+        jassert(count > 0);
+
+        return impl.bufferWithTimeOrCount(span, count, *scheduler.impl, &valuesToArray);
+    }
+
     ///@{
     /**
      Returns an Observable that emits **whenever** a value is emitted by either this Observable **or** one of the `others`. It combines the **latest** value from each Observable via the given function and emits what was returned by the function.
@@ -264,6 +402,33 @@ public:
 
         return impl.combineLatest({ others.impl... }, toAny(untypedFunction));
     }
+    /// Like combineLatest, but with a given Propagation. Use Propagation::GlitchFree if the `others` depend on the same source as this Observable.
+    template<typename... Ts>
+    Observable<std::tuple<T, Ts...>> combineLatest(Propagation propagation, const Observable<Ts>&... others) const
+    {
+        return combineLatest(propagation, std::make_tuple<const T&, const Ts&...>, others...);
+    }
+    /// \overload
+    template<typename... Ts, typename Function>
+    Observable<CallResult<Function, T, Ts...>> combineLatest(Propagation propagation, Function&& function, const Observable<Ts>&... others) const
+    {
+        if (propagation == Propagation::Immediate)
+            return combineLatest(std::forward<Function>(function), others...);
+
+        static_assert(sizeof...(Ts) > 0, "Must pass at least one other Observable to combineLatest.");
+
+        return Impl::combineLatestArray({ impl, others.impl... }, toVectorFunction<Ts...>(function, typename MakeIndexSequence<sizeof...(Ts)>::type()), true);
+    }
+
+    /**
+     Like combineLatest, but for any number of Observables of the same type, e.g. the states of all channel strips. Emits an Array with the latest value from each Observable, in the same order as `observables`.
+
+     It's a single operator, so the number of Observables isn't limited, and a new value only replaces the value of its own Observable. If `observables` is empty, the returned Observable completes immediately. @see Propagation
+     */
+    static Observable<juce::Array<T>> combineLatest(const juce::Array<Observable<T>>& observables, Propagation propagation = Propagation::Immediate)
+    {
+        return Impl::combineLatestArray(toImpls(observables), &valuesToArray, propagation == Propagation::GlitchFree);
+    }
     ///@}
 
     /**
@@ -298,6 +463,28 @@ public:
         return impl.debounce(interval);
     }
 
+    /// Like debounce(const juce::RelativeTime&), but the timer runs on `scheduler`, and the values are emitted on it. Pass a VirtualTimeScheduler to test it without waiting.
+    Observable<T> debounce(const juce::RelativeTime& interval, const Scheduler& scheduler) const
+    {
+        return impl.debounce(interval, *scheduler.impl);
+    }
+
+    /**
+     Applies a peak meter's hold behaviour to an Observable of peak values (e.g. from Observable::peak): Emits the highest peak for `holdCount` values, and afterwards lets it fall by `decayFactor` per value, until a higher peak arrives. @see DecayingPeakHold
+     
+     Each subscription has its own held peak.
+     */
+    template<typename U = T>
+    Observable<float> decayingPeakHold(unsigned int holdCount, float decayFactor, typename std::enable_if<std::is_same<U, T>::value && std::is_same<U, float>::value>::type* = 0) const
+    {
+        DecayingPeakHold peakHold(holdCount, decayFactor);
+
+        return impl.transform([peakHold](any& value) mutable -> bool {
+            value = any(peakHold.process(value.get<float>()));
+            return true;
+        });
+    }
+
     /**
      Returns an Observable which emits the same values as this Observable, but suppresses consecutive duplicate values.
      
@@ -308,14 +495,85 @@ public:
      If T is comparable using ==, this is used to determine whether two values are equal. Otherwise, the values are compared by their addresses.
      
      If, for some reason, the custom type T doesn't have operator==, you can pass a custom equality function.
+     
+     If T is an arithmetic type (e.g. int, float, double), the values are compared directly, without calling a std::function.
      */
-    Observable<T> distinctUntilChanged(const std::function<bool(const T&, const T&)>& equals = std::equal_to<T>()) const
+    Observable<T> distinctUntilChanged() const
+    {
+        return distinctUntilChanged(std::is_arithmetic<T>());
+    }
+    /// \overload
+    Observable<T> distinctUntilChanged(const std::function<bool(const T&, const T&)>& equals) const
     {
         return impl.distinctUntilChanged([equals](const any& lhs, const any& rhs) {
             return equals(lhs.get<T>(), rhs.get<T>());
         });
     }
 
+    /**
+     Returns an Observable which suppresses values that differ by at most `tolerance` from the value emitted before. Use it to ignore the jitter of e.g. parameter values during host automation.
+     
+     A value is compared to the last value that **has been emitted**, not to the one that has been suppressed before. So slowly drifting values are emitted once they have moved by more than `tolerance` in total.
+     
+     For example:
+     
+         Observable<double>::from({1.0, 1.001, 1.002, 1.2, 1.1}).distinctUntilChanged(0.05); // Emits: 1.0, 1.2, 1.1
+     
+     ​ **Asserts that `tolerance` isn't negative. A comparison with NaN counts as different, so NaN values are always emitted, and so is the first value after a NaN.**
+     */
+    template<typename U = T>
+    Observable<T> distinctUntilChanged(T tolerance, typename std::enable_if<std::is_same<U, T>::value && std::is_arithmetic<U>::value && !std::is_same<U, bool>::value>::type* = 0) const
+    {
+        // Tolerance must not be negative!
+        jassert(tolerance >= T(0));
+
+        bool hasLast = false;
+        T last = T();
+
+        return impl.transform([hasLast, last, tolerance](any& value) mutable -> bool {
+            const T current = value.get<T>();
+            // Computed like this, so it doesn't wrap around for unsigned types. If either value is NaN, the difference is NaN and the value is emitted.
+            if (hasLast && (current > last ? current - last : last - current) <= tolerance)
+                return false;
+
+            hasLast = true;
+            last = current;
+            return true;
+        });
+    }
+
+    /**
+     Returns an Observable which rounds each value to the nearest multiple of `step`, and suppresses consecutive duplicates of the rounded values. It emits the **rounded** values.
+     
+     For example:
+     
+         Observable<float>::from({0.12f, 0.14f, 0.26f, 0.24f, 0.31f}).distinctUntilChangedQuantized(0.25f); // Emits: 0.f, 0.25f
+     
+     Use it if only a limited resolution is displayed (e.g. the value of a slider with a fixed step size), to avoid redundant repaints.
+     
+     ​ **Asserts that `step` is positive.**
+     */
+    template<typename U = T>
+    Observable<T> distinctUntilChangedQuantized(T step, typename std::enable_if<std::is_same<U, T>::value && std::is_floating_point<U>::value>::type* = 0) const
+    {
+        // Step must be positive!
+        jassert(step > T(0));
+
+        bool hasLast = false;
+        T last = T();
+
+        return impl.transform([hasLast, last, step](any& value) mutable -> bool {
+            const T quantized = std::round(value.get<T>() / step) * step;
+            if (hasLast && quantized == last)
+                return false;
+
+            hasLast = true;
+            last = quantized;
+            value = any(quantized);
+            return true;
+        });
+    }
+
     /**
      Returns an Observable which emits only one value: The `index`th value emitted by this Observable.
      */
@@ -388,6 +646,45 @@ public:
         return impl.merge(otherImpls);
     }
 
+    /**
+     Merges the emitted values of any number of Observables into one Observable, in a single operator. If `observables` is empty, the returned Observable completes immediately.
+     */
+    static Observable<T> merge(const juce::Array<Observable<T>>& observables)
+    {
+        return Impl::mergeArray(toImpls(observables));
+    }
+
+    /**
+     For an Observable of sample blocks (like AudioBlock, juce::AudioBuffer<float> or juce::Array<float>), emits the minimum and maximum of `numBins` bins per block. Use it to draw waveforms with one bin per pixel. @see SignalReductions::minMaxEnvelope
+     
+     To avoid passing whole blocks between threads, consider using SignalReductions on the audio thread instead.
+     */
+    template<typename U = T>
+    Observable<juce::Array<juce::Range<float>>> minMaxEnvelope(int numBins, typename std::enable_if<std::is_same<U, T>::value && detail::SignalTraits<U>::IsSignal>::type* = 0) const
+    {
+        // Must compute at least one bin!
+        jassert(numBins > 0);
+
+        return impl.transform([numBins](any& value) -> bool {
+            value = any(SignalReductions::minMaxEnvelope(value.get<T>(), numBins));
+            return true;
+        });
+    }
+
+    /**
+     For an Observable of sample blocks (like AudioBlock, juce::AudioBuffer<float> or juce::Array<float>), emits the largest absolute sample value of each block. @see SignalReductions::peak
+     
+     To avoid passing whole blocks between threads, consider using SignalReductions on the audio thread instead.
+     */
+    template<typename U = T>
+    Observable<float> peak(typename std::enable_if<std::is_same<U, T>::value && detail::SignalTraits<U>::IsSignal>::type* = 0) const
+    {
+        return impl.transform([](any& value) -> bool {
+            value = any(SignalReductions::peak(value.get<T>()));
+            return true;
+        });
+    }
+
     /**
      Begins with a `startValue`, and then applies `f` to all values emitted by this Observable, and returns the aggregate result as a single-element Observable sequence.
      */
@@ -398,6 +695,20 @@ public:
         });
     }
 
+    /**
+     For an Observable of sample blocks (like AudioBlock, juce::AudioBuffer<float> or juce::Array<float>), emits the root mean square of each block. @see SignalReductions::rms
+     
+     To avoid passing whole blocks between threads, consider using SignalReductions on the audio thread instead.
+     */
+    template<typename U = T>
+    Observable<float> rms(typename std::enable_if<std::is_same<U, T>::value && detail::SignalTraits<U>::IsSignal>::type* = 0) const
+    {
+        return impl.transform([](any& value) -> bool {
+            value = any(SignalReductions::rms(value.get<T>()));
+            return true;
+        });
+    }
+
     /**
      Returns an Observable which checks every `interval` milliseconds whether this Observable has emitted any new values. If so, the returned Observable emits the latest value from this Observable.
      
@@ -410,6 +721,24 @@ public:
         return impl.sample(interval);
     }
 
+    /// Like sample(const juce::RelativeTime&), but the timer runs on `scheduler`, and the values are emitted on it. Pass a VirtualTimeScheduler to test it without waiting.
+    Observable<T> sample(const juce::RelativeTime& interval, const Scheduler& scheduler) const
+    {
+        return impl.sample(interval, *scheduler.impl);
+    }
+
+    /**
+     Returns an Observable that emits the latest value from this Observable once per display frame, on the JUCE message thread. If this Observable hasn't emitted a new value since the last frame, nothing is emitted.
+     
+     Use this instead of Observable::sample for GUI updates like level meters: All subscriptions share a single frame timer (@see Scheduler::messageThreadFrameAligned), instead of one timer per subscription. And if there are no new values, the message thread isn't woken up at all.
+     
+     This Observable may emit values on any thread.
+     */
+    Observable<T> sampleOnFrame() const
+    {
+        return impl.sampleOnFrame();
+    }
+
     /**
      Calls a function `f` with the given `startValue` and the first value emitted by this Observable. The value returned from `f` is remembered. When the second value is emitted, `f` is called with the remembered value (called the *accumulator*) and the second emitted value. The returned value is remembered, until the third value is emitted, and so on.
      
@@ -505,6 +834,56 @@ public:
         });
     }
 
+    /**
+     Returns a TypedPipeline, which applies `map`, `filter` and `scan` to the values of this Observable without type-erasing each intermediate value.
+
+     Use it for hot paths with many short operators. Convert the result back to an Observable when you need other operators, a Scheduler or a Subject.
+
+     @see TypedPipeline
+     */
+    TypedPipeline<T, T, detail::IdentityStage<T>> typed() const
+    {
+        return TypedPipeline<T, T, detail::IdentityStage<T>>(*this, detail::IdentityStage<T>());
+    }
+
+    /**
+     Returns a sliding window over this Observable: For each value, emits a juce::Array with the latest `count` values (in the order in which they have been emitted). The first few windows are smaller, until `count` values have been emitted.
+     
+         Observable<int>::range(1, 4).window(3); // Emits { 1 }, { 1, 2 }, { 1, 2, 3 } and { 2, 3, 4 }
+     
+     Use it for things like a scrolling waveform or a moving average.
+     
+     @see Observable::buffer
+     */
+    Observable<juce::Array<T>> window(unsigned int count) const
+    {
+        // The window must hold at least one value!
+        jassert(count > 0);
+
+        // The latest values, in a ring: Once it's full, the oldest value is overwritten in place
+        juce::Array<T> ring;
+        ring.ensureStorageAllocated(static_cast<int>(count));
+        int oldest = 0;
+
+        return impl.transform([ring, oldest, count](any& value) mutable -> bool {
+            if (ring.size() < static_cast<int>(count))
+                ring.add(value.get<T>());
+            else {
+                ring.getReference(oldest) = value.get<T>();
+                oldest = (oldest + 1) % ring.size();
+            }
+
+            // Build each window once, oldest value first
+            juce::Array<T> window;
+            window.ensureStorageAllocated(ring.size());
+            for (int i = 0; i < ring.size(); ++i)
+                window.add(ring.getReference((oldest + i) % ring.size()));
+
+            value = any(std::move(window));
+            return true;
+        });
+    }
+
     ///@{
     /**
      Returns an Observable that emits whenever a value is emitted by **this Observable**. It combines the latest value from each Observable via the given function and emits the result of this function.
@@ -529,6 +908,23 @@ public:
 
         return impl.withLatestFrom({ others.impl... }, toAny(untypedFunction));
     }
+    /// Like withLatestFrom, but with a given Propagation. With Propagation::GlitchFree, the `others` are updated before combining, if they depend on the same source as this Observable.
+    template<typename... Ts>
+    Observable<std::tuple<T, Ts...>> withLatestFrom(Propagation propagation, const Observable<Ts>&... others) const
+    {
+        return withLatestFrom(propagation, std::make_tuple<const T&, const Ts&...>, others...);
+    }
+    /// \overload
+    template<typename... Ts, typename Function>
+    Observable<CallResult<Function, T, Ts...>> withLatestFrom(Propagation propagation, Function&& function, const Observable<Ts>&... others) const
+    {
+        if (propagation == Propagation::Immediate)
+            return withLatestFrom(std::forward<Function>(function), others...);
+
+        static_assert(sizeof...(Ts) > 0, "Must pass at least one other Observable to withLatestFrom.");
+
+        return Impl::withLatestFromArray({ impl, others.impl... }, toVectorFunction<Ts...>(function, typename MakeIndexSequence<sizeof...(Ts)>::type()), true);
+    }
     ///@}
 
     ///@{
@@ -557,6 +953,16 @@ public:
 
         return impl.zip({ others.impl... }, toAny(untypedFunction));
     }
+
+    /**
+     Like zip, but for any number of Observables of the same type. Emits an Array with one value from each Observable, in the same order as `observables`.
+
+     It's a single operator, so the number of Observables isn't limited. If `observables` is empty, the returned Observable completes immediately.
+     */
+    static Observable<juce::Array<T>> zip(const juce::Array<Observable<T>>& observables)
+    {
+        return Impl::zipArray(toImpls(observables), &valuesToArray);
+    }
         ///@}
 
 
@@ -581,6 +987,61 @@ public:
         return impl.observeOn(*scheduler.impl);
     }
 
+    /**
+     Like observeOn(const Scheduler&), but buffers at most `capacity` values that haven't been delivered on the `scheduler` yet. So if this Observable emits faster than the scheduler can keep up (e.g. a background thread producer and Scheduler::messageThread), the memory and the delay until a value is delivered stay bounded.
+     
+     The `congestionPolicy` determines what happens to a new value if the buffer is full: CongestionPolicy::DropNewest discards it, CongestionPolicy::DropOldest discards the oldest buffered value instead. With a capacity of 1 and CongestionPolicy::DropOldest, only the latest value is delivered. CongestionPolicy::Allocate doesn't drop anything, and grows the buffer beyond `capacity`.
+     
+     All buffered values are delivered in one scheduled action, and at most one action is scheduled at a time. onError and onCompleted are delivered after the buffered values.
+     
+     ​ **Asserts that `capacity` is greater than 0.**
+     
+     @see CongestionPolicy
+     */
+    Observable<T> observeOn(const Scheduler& scheduler, size_t capacity, CongestionPolicy congestionPolicy) const
+    {
+        // The capacity must be > 0!
+        jassert(capacity > 0);
+
+        return impl.observeOn(*scheduler.impl, capacity, congestionPolicy);
+    }
+
+    /**
+     Like observeOn, but only delivers the latest value. Use this for streams of state (like a playhead position or the CPU load), where only the newest value matters.
+     
+     Each subscription has one slot for the latest value that hasn't been delivered yet. A new value overwrites it, instead of being queued. At most one action is scheduled on the `scheduler` at a time: It delivers the value from the slot, and schedules another action if a newer value has arrived in the meantime. So after the scheduler has been stalled, it delivers one up-to-date value instead of a burst of stale ones.
+     
+     onError and onCompleted are delivered after the pending value.
+     */
+    Observable<T> observeOnLatest(const Scheduler& scheduler) const
+    {
+        return impl.observeOnLatest(*scheduler.impl);
+    }
+
+    /**
+     Like Observable::map, but calls `function` for up to `maxConcurrency` values at the same time, on the given scheduler. The results are emitted in the same order as the values of this Observable.
+     
+     Use this with Scheduler::threadPool to spread expensive work (like analyzing audio files) across cores:
+     
+         const auto pool = Scheduler::threadPool();
+         files.parallelMap(pool, [](const File& file) { return analyze(file); }, 4)
+             .observeOn(Scheduler::messageThread())
+             .subscribe([&](const Analysis& analysis) { });
+     
+     At most `maxConcurrency` results are evaluated or waiting for earlier results at any time, so the reorder buffer is bounded. Further values wait until the oldest result has been emitted. The number of waiting values isn't bounded: If this Observable emits faster than `function` is evaluated, they accumulate until the evaluation catches up.
+     
+     The results are emitted one at a time, on the threads that evaluate them, and without holding a lock. So a subscriber may push values back into this Observable synchronously.
+     
+     An exception thrown by `function` notifies `onError`.
+     */
+    template<typename Function>
+    Observable<CallResult<Function, T>> parallelMap(const Scheduler& scheduler, Function&& function, unsigned int maxConcurrency = static_cast<unsigned int>(juce::SystemStats::getNumCpus())) const
+    {
+        return impl.parallelMap(*scheduler.impl, [function](const any& value) {
+            return toAny(function(value.get<T>()));
+        }, maxConcurrency);
+    }
+
 
 #pragma mark - Misc
     /**
@@ -593,13 +1054,178 @@ public:
     juce::Array<T> toArray(const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError) const
     {
         juce::Array<T> values;
-
-        for (const any& v : impl.toArray(onError))
-            values.add(v.get<T>());
+        impl.blockingSubscribe([&values](const any& value) {
+            values.add(value.get<T>());
+        },
+                               onError);
 
         return values;
     }
 
+    /**
+     Subscribes to this Observable without blocking, and collects all emitted values in a std::vector. When this Observable completes, the vector is moved into `onCompleted`.
+     
+     `onCompleted` and `onError` are called on the thread on which this Observable terminates. Unsubscribe the returned Subscription to stop collecting (then neither of them is called).
+     
+     ​ **If you don't pass an `onError` handler, an exception inside the Observable will terminate your app.**
+     */
+    Subscription toArrayAsync(const std::function<void(std::vector<T>&&)>& onCompleted,
+                              const std::function<void(std::exception_ptr)>& onError = Impl::TerminateOnError) const
+    {
+        const auto values = std::make_shared<std::vector<T>>();
+
+        return impl.subscribe([values](const any& value) {
+            values->push_back(value.get<T>());
+        },
+                              onError,
+                              [values, onCompleted]() {
+                                  onCompleted(std::move(*values));
+                              });
+    }
+
+    /// \cond internal
+    class ArrayFuture : public std::future<std::vector<T>>
+    {
+    public:
+        ArrayFuture(std::future<std::vector<T>>&& future, const Subscription& subscription)
+        : std::future<std::vector<T>>(std::move(future)),
+          subscription(new Subscription(subscription))
+        {}
+
+        ArrayFuture(ArrayFuture&&) = default;
+
+        ArrayFuture& operator=(ArrayFuture&& other)
+        {
+            cancelIfPending();
+            std::future<std::vector<T>>::operator=(std::move(other));
+            subscription = std::move(other.subscription);
+            return *this;
+        }
+
+        ~ArrayFuture()
+        {
+            cancelIfPending();
+        }
+
+    private:
+        std::unique_ptr<Subscription> subscription;
+
+        // Unsubscribes if nobody can get the result anymore. If the std::future part has been moved out (e.g. into a plain std::future), it's not valid, so the subscription is kept.
+        void cancelIfPending()
+        {
+            if (subscription && this->valid())
+                subscription->unsubscribe();
+        }
+    };
+    /// \endcond
+
+    /**
+     Subscribes to this Observable without blocking, and returns a future for all emitted values. The future becomes ready when this Observable completes. If this Observable notifies onError, the future rethrows the error when calling `get()`.
+     
+     The returned future is a std::future, which unsubscribes from this Observable if it's destroyed before `get()` has been called. If you move it into a plain std::future, it can't unsubscribe anymore.
+     
+     Be careful when you wait for the future on the message thread: If the Observable needs to process something *asynchronously* on the message thread, waiting will deadlock.
+     */
+    ArrayFuture toFuture() const
+    {
+        const auto promise = std::make_shared<std::promise<std::vector<T>>>();
+        auto future = promise->get_future();
+
+        const auto subscription = toArrayAsync([promise](std::vector<T>&& values) {
+            promise->set_value(std::move(values));
+        },
+                                               [promise](std::exception_ptr error) {
+                                                   promise->set_exception(error);
+                                               });
+
+        return ArrayFuture(std::move(future), subscription);
+    }
+
+#if REAX_HAS_COROUTINES
+    /// \cond internal
+    class ArrayAwaiter
+    {
+    public:
+        explicit ArrayAwaiter(const Observable<T>& source)
+        : observable(source),
+          state(std::make_shared<State>())
+        {}
+
+        ArrayAwaiter(ArrayAwaiter&&) = default;
+
+        ~ArrayAwaiter()
+        {
+            // If the coroutine is destroyed while it's suspended, stop collecting, and don't resume it
+            if (subscription && state->phase.exchange(State::Abandoned) == State::Suspended)
+                subscription->unsubscribe();
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            const auto sharedState = state;
+            sharedState->handle = handle;
+
+            subscription.reset(new Subscription(observable.toArrayAsync([sharedState](std::vector<T>&& values) {
+                sharedState->values = std::move(values);
+                sharedState->finish();
+            },
+                                                                        [sharedState](std::exception_ptr error) {
+                                                                            sharedState->error = error;
+                                                                            sharedState->finish();
+                                                                        })));
+
+            // If the Observable has already terminated while subscribing, don't suspend at all
+            return sharedState->phase.exchange(State::Suspended) == State::Waiting;
+        }
+
+        std::vector<T> await_resume()
+        {
+            if (state->error)
+                std::rethrow_exception(state->error);
+
+            return std::move(state->values);
+        }
+
+    private:
+        struct State
+        {
+            enum Phase { Waiting, Finished, Suspended, Abandoned };
+
+            std::atomic<int> phase{ Waiting };
+            std::coroutine_handle<> handle;
+            std::vector<T> values;
+            std::exception_ptr error;
+
+            void finish()
+            {
+                if (phase.exchange(Finished) == Suspended)
+                    handle.resume();
+            }
+        };
+
+        const Observable<T> observable;
+        const std::shared_ptr<State> state;
+        // Set when awaited. Unsubscribed if the coroutine is destroyed before this Observable terminates.
+        std::unique_ptr<Subscription> subscription;
+    };
+    /// \endcond
+
+    /**
+     Returns an awaitable for all emitted values, for use with `co_await` in a C++20 coroutine. It subscribes when awaited, and resumes the coroutine with a std::vector of all values when this Observable completes (on the thread on which it completes). If this Observable notifies onError, `co_await` rethrows the error. If the coroutine is destroyed while it's waiting, it unsubscribes from this Observable.
+     
+     Only available if the compiler supports coroutines.
+     */
+    ArrayAwaiter toAwaitable() const
+    {
+        return ArrayAwaiter(*this);
+    }
+#endif
+
     /// Covariant constructor: If `U` is convertible to `T`, then an `Observable<U>` is convertible to an `Observable<T>`.
     template<typename U>
     Observable(const Observable<U>& other, typename std::enable_if<std::is_convertible<U, T>::value>::type* = 0)
@@ -611,6 +1237,10 @@ private:
     friend class Observable;
     template<typename U>
     friend class Subject;
+    template<typename Source, typename U, typename Stage>
+    friend class TypedPipeline;
+    template<typename U>
+    friend class Computed;
 
     Impl impl;
 
@@ -629,6 +1259,78 @@ private:
     {
         return any(u.impl);
     }
+    // Moves temporaries (e.g. results of a map function) into the any, so move-only types can flow through operators
+    template<typename U>
+    static any toAny(U&& u, typename std::enable_if<!std::is_lvalue_reference<U>::value && !IsObservable<U>::value>::type* = 0)
+    {
+        return any(std::move(u));
+    }
+
+    // The fast path for arithmetic types, which compares the unboxed values in a fused stage
+    Observable<T> distinctUntilChanged(std::true_type /* isArithmetic */) const
+    {
+        bool hasLast = false;
+        T last = T();
+
+        return impl.transform([hasLast, last](any& value) mutable -> bool {
+            const T current = value.get<T>();
+            if (hasLast && current == last)
+                return false;
+
+            hasLast = true;
+            last = current;
+            return true;
+        });
+    }
+    Observable<T> distinctUntilChanged(std::false_type /* isArithmetic */) const
+    {
+        return distinctUntilChanged(std::equal_to<T>());
+    }
+
+    static juce::Array<Impl> toImpls(const juce::Array<Observable<T>>& observables)
+    {
+        juce::Array<Impl> impls;
+        for (auto& observable : observables)
+            impls.add(observable.impl);
+
+        return impls;
+    }
+
+    // Used by the Array overloads of combineLatest and zip
+    static any valuesToArray(const std::vector<any>& values)
+    {
+        juce::Array<T> array;
+        array.ensureStorageAllocated(static_cast<int>(values.size()));
+
+        for (auto& value : values)
+            array.add(value.get<T>());
+
+        return any(std::move(array));
+    }
+
+    // A compile-time list of the indices 0 ... N-1, like std::index_sequence in C++14
+    template<size_t...>
+    struct IndexSequence
+    {
+    };
+    template<size_t N, size_t... Indices>
+    struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...>
+    {
+    };
+    template<size_t... Indices>
+    struct MakeIndexSequence<0, Indices...>
+    {
+        typedef IndexSequence<Indices...> type;
+    };
+
+    // Calls function with the values of this Observable and the others, for the operators that combine a vector of values
+    template<typename... Ts, typename Function, size_t... Indices>
+    static std::function<any(const std::vector<any>&)> toVectorFunction(const Function& function, IndexSequence<Indices...>)
+    {
+        return [function](const std::vector<any>& values) {
+            return toAny(function(values[0].get<T>(), values[Indices + 1].template get<Ts>()...));
+        };
+    }
 
     // any_args<Ts...>::type is a parameter pack with the same length as Ts, where all types are any.
     template<typename>
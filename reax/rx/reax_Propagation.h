@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ Determines when Observable::combineLatest and Observable::withLatestFrom emit, if their sources depend on each other (a "diamond"):
+
+     auto combined = a.map(f).combineLatest(Propagation::GlitchFree, a.map(g));
+
+ Immediate: Emits as soon as a source emits. In the example, each value of `a` produces two combinations, and the first one pairs the new `f` result with the previous `g` result (a "glitch").
+
+ GlitchFree: Emits once, after a value has propagated through all Observables that depend on it, with the latest value of each source. In the example, each value of `a` produces exactly one combination. If glitch-free operators depend on each other, they emit in dependency order, so each one sees consistent values.
+
+ GlitchFree costs more per value: Each value that arrives during a propagation schedules a settle callback (copying a std::function, which may allocate), and the callbacks are kept in a priority queue until the propagation ends. The queue's memory is reused by later propagations on the same thread. So prefer Immediate for high-rate values (e.g. on the audio thread), unless the sources depend on each other.
+
+ A propagation begins when a value is pushed into an Observer (e.g. Subject::onNext, or an Observable created with Observable::create), when an action runs on Scheduler::messageThread, or when a Transaction ends (then all of its changes propagate together). Values from other sources (like Observable::range or Observable::interval) aren't part of a propagation, so glitch-free operators emit them immediately.
+ */
+enum class Propagation {
+    Immediate,
+    GlitchFree
+};
@@ -2,52 +2,657 @@ namespace {
     using namespace juce;
 
     // A Rx dispatcher for the JUCE message thread. It processes Observables that are observed on it.
-    class JUCEDispatcher : private Timer
+    //
+    // Scheduled actions wait in a time-ordered queue, which may be filled from any thread without blocking. So the dispatcher can be created on any thread, even before the message thread runs, and there's nothing that must be created on the message thread first (unlike a rxcpp::schedulers::run_loop, which is bound to the thread that creates it).
+    //
+    // It doesn't poll: When an action is scheduled that is due earlier than all other actions, it dispatches the due actions asynchronously, and arms a one-shot timer for the next scheduled action (if any). If alignToFrames is true, due actions are dispatched on the next display frame instead, together with all other actions that are due by then.
+    class JUCEDispatcher : private AsyncUpdater, private Timer, private detail::FrameTicker::Client
     {
     public:
-        JUCEDispatcher()
-        : runLoop(createRunLoop())
+        typedef rxcpp::schedulers::scheduler_interface::clock_type clock_type;
+
+        explicit JUCEDispatcher(bool alignToFrames)
+        : alignToFrames(alignToFrames),
+          scheduler(rxcpp::schedulers::make_scheduler<MessageThreadScheduler>(*this))
+        {
+            // Make sure that the FrameTicker outlives this dispatcher
+            if (alignToFrames)
+                detail::FrameTicker::getInstance();
+        }
+
+        ~JUCEDispatcher()
         {
-            // The run loop didn't get initialized! Please report this as a bug.
-            jassert(runLoop);
+            cancelPendingUpdate();
 
-            startTimerHz(60);
+            if (alignToFrames)
+                detail::FrameTicker::getInstance().cancelFrame(*this);
         }
 
         rxcpp::observe_on_one_worker createWorker() const
         {
-            return rxcpp::observe_on_run_loop(*runLoop);
+            return rxcpp::observe_on_one_worker(scheduler);
         }
 
-    private:
-        typedef ScopedPointer<rxcpp::schedulers::run_loop> RunLoop_ptr;
-        const RunLoop_ptr runLoop;
+        rxcpp::schedulers::scheduler getScheduler() const
+        {
+            return scheduler;
+        }
 
-        static RunLoop_ptr createRunLoop()
+        // May be called on any thread
+        void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& action)
         {
-            // Create the run loop on the message thread:
-            RunLoop_ptr rl;
-            static const auto create = [](void* rl) {
-                // Not called from the JUCE message thread! Please report this as a bug.
-                jassert(MessageManager::getInstance()->isThisTheMessageThread());
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const ScopedLock lock(queueLock);
+
+            // Actions with the same time stay in FIFO order
+            const auto position = std::upper_bound(queue.begin(), queue.end(), when, [](clock_type::time_point time, const Pending& p) {
+                return time < p.when;
+            });
+            const bool isEarliest = (position == queue.begin());
+            queue.insert(position, Pending{ when, action });
+
+            // JUCE can't post the update while there's no MessageManager. Then try again when the next action is scheduled.
+            if (isEarliest || !hasMessageManager) {
+                hasMessageManager = (MessageManager::getInstanceWithoutCreating() != nullptr);
+                triggerAsyncUpdate();
+            }
+        }
+
+    private:
+        class MessageThreadScheduler : public rxcpp::schedulers::scheduler_interface
+        {
+        public:
+            explicit MessageThreadScheduler(JUCEDispatcher& dispatcher)
+            : dispatcher(dispatcher)
+            {}
+
+            clock_type::time_point now() const override
+            {
+                return clock_type::now();
+            }
 
-                *static_cast<RunLoop_ptr*>(rl) = new rxcpp::schedulers::run_loop();
-                return static_cast<void*>(nullptr);
+            rxcpp::schedulers::worker create_worker(rxcpp::composite_subscription lifetime) const override
+            {
+                return rxcpp::schedulers::worker(lifetime, std::make_shared<Worker>(dispatcher));
+            }
+
+        private:
+            struct Worker : public rxcpp::schedulers::worker_interface
+            {
+                explicit Worker(JUCEDispatcher& dispatcher)
+                : dispatcher(dispatcher)
+                {}
+
+                clock_type::time_point now() const override
+                {
+                    return clock_type::now();
+                }
+
+                void schedule(const rxcpp::schedulers::schedulable& scheduled) const override
+                {
+                    dispatcher.schedule(now(), scheduled);
+                }
+
+                void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& scheduled) const override
+                {
+                    dispatcher.schedule(when, scheduled);
+                }
+
+                JUCEDispatcher& dispatcher;
             };
 
-            // This will block if this thread isn't the message thread:
-            MessageManager::getInstance()->callFunctionOnMessageThread(create, &rl);
+            JUCEDispatcher& dispatcher;
+        };
+
+        struct Pending
+        {
+            clock_type::time_point when;
+            rxcpp::schedulers::schedulable action;
+        };
+
+        const bool alignToFrames;
+        const rxcpp::schedulers::scheduler scheduler;
+
+        CriticalSection queueLock;
+        std::deque<Pending> queue;
+        // Set once an update has been triggered while the MessageManager existed
+        bool hasMessageManager = false;
 
-            return rl;
+        void handleAsyncUpdate() override
+        {
+            update();
         }
 
         void timerCallback() override
         {
-            // Run any scheduled actions
-            while (!runLoop->empty() && runLoop->peek().when < runLoop->now())
-                runLoop->dispatch();
+            update();
+        }
+
+        void frameDidTick() override
+        {
+            dispatchDueItems();
+            scheduleNextDispatch();
+        }
+
+        void update()
+        {
+            if (!alignToFrames)
+                dispatchDueItems();
+
+            scheduleNextDispatch();
+        }
+
+        // Takes the earliest action from the queue, if it's due
+        rxcpp::util::maybe<rxcpp::schedulers::schedulable> popDueItem()
+        {
+            REAX_LOCK_WILL_BE_ACQUIRED();
+            const ScopedLock lock(queueLock);
+
+            rxcpp::util::maybe<rxcpp::schedulers::schedulable> item;
+            if (!queue.empty() && queue.front().when <= clock_type::now()) {
+                item.reset(queue.front().action);
+                queue.pop_front();
+            }
+
+            return item;
+        }
+
+        void dispatchDueItems()
+        {
+            // Let actions recurse in place, like on the thread of a run loop. The queue isn't locked while they run, so they can schedule more actions.
+            rxcpp::schedulers::recursion recursion;
+            recursion.reset(true);
+
+            for (auto item = popDueItem(); !item.empty(); item = popDueItem()) {
+                if (item.get().is_subscribed()) {
+                    detail::PropagationWave wave;
+                    item.get()(recursion.get_recurse());
+                    wave.settle();
+                }
+            }
+        }
+
+        // Wakes up the message thread when the earliest scheduled item is due
+        void scheduleNextDispatch()
+        {
+            stopTimer();
+
+            clock_type::time_point next;
+            {
+                REAX_LOCK_WILL_BE_ACQUIRED();
+                const ScopedLock lock(queueLock);
+                if (queue.empty())
+                    return;
+
+                next = queue.front().when;
+            }
+
+            const auto delay = next - clock_type::now();
+            if (delay > std::chrono::milliseconds::zero()) {
+                // Round up, so the item is due when the timer fires
+                const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() + 1;
+                startTimer(static_cast<int>(milliseconds));
+            }
+            else if (alignToFrames)
+                detail::FrameTicker::getInstance().requestFrame(*this);
+            else
+                triggerAsyncUpdate();
         }
     };
+
+    // A fixed number of threads, shared by all subscriptions that are observed on it. Each subscription is assigned to one of the threads (round-robin), so its values are processed in order, while separate subscriptions run in parallel.
+    class ThreadPoolScheduler : public rxcpp::schedulers::scheduler_interface
+    {
+    public:
+        explicit ThreadPoolScheduler(int numThreads)
+        : ThreadPoolScheduler(numThreads, rxcpp::schedulers::make_new_thread())
+        {}
+
+        ThreadPoolScheduler(int numThreads, const rxcpp::schedulers::scheduler& newThread)
+        {
+            // There must be at least one thread!
+            jassert(numThreads > 0);
+
+            for (int i = 0; i < jmax(1, numThreads); ++i)
+                threads.push_back(newThread.create_worker());
+        }
+
+        ~ThreadPoolScheduler()
+        {
+            // Let the threads finish
+            for (auto& thread : threads)
+                thread.unsubscribe();
+        }
+
+        clock_type::time_point now() const override
+        {
+            return clock_type::now();
+        }
+
+        rxcpp::schedulers::worker create_worker(rxcpp::composite_subscription lifetime) const override
+        {
+            const auto& thread = threads[nextThread++ % threads.size()];
+            return rxcpp::schedulers::worker(lifetime, std::make_shared<Worker>(lifetime, thread, shared_from_this()));
+        }
+
+    private:
+        // Schedules the actions of one subscription on one of the threads
+        struct Worker : public rxcpp::schedulers::worker_interface
+        {
+            Worker(const rxcpp::composite_subscription& lifetime, const rxcpp::schedulers::worker& thread, const std::shared_ptr<const rxcpp::schedulers::scheduler_interface>& pool)
+            : lifetime(lifetime),
+              thread(thread),
+              pool(pool)
+            {
+                const auto token = this->thread.add(lifetime);
+                const auto threadCopy = thread;
+                this->lifetime.add([token, threadCopy]() {
+                    threadCopy.remove(token);
+                });
+            }
+
+            clock_type::time_point now() const override
+            {
+                return clock_type::now();
+            }
+
+            void schedule(const rxcpp::schedulers::schedulable& scheduled) const override
+            {
+                thread.schedule(lifetime, scheduled.get_action());
+            }
+
+            void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& scheduled) const override
+            {
+                thread.schedule(when, lifetime, scheduled.get_action());
+            }
+
+            rxcpp::composite_subscription lifetime;
+            rxcpp::schedulers::worker thread;
+            // Keeps the threads alive while they're used
+            std::shared_ptr<const rxcpp::schedulers::scheduler_interface> pool;
+        };
+
+        std::vector<rxcpp::schedulers::worker> threads;
+        mutable std::atomic<size_t> nextThread{ 0 };
+    };
+}
+
+namespace detail {
+// Hands the values of Observables that are observed on an AudioThreadScheduler to the audio thread, which delivers them in AudioThreadScheduler::drain.
+//
+// Each value (or termination) is copied into a node of a preallocated pool, and the node is passed to the audio thread through a single-producer queue. The producers (any thread except the audio thread) are serialized by a lock, so the audio thread never locks. After delivering a node, the audio thread passes it back through another queue, and the message thread releases its payload and returns it to the pool. So the audio thread never frees memory either. If the pool is empty, values wait in an overflow list until the message thread has released enough nodes.
+class AudioThreadHandoff : private Timer
+{
+public:
+    typedef rxcpp::subscriber<any> Destination;
+
+    enum Kind
+    {
+        Next,
+        Error,
+        Completed
+    };
+
+    AudioThreadHandoff()
+    : nodes(Capacity),
+      ready(Capacity, nullptr),
+      released(Capacity, nullptr)
+    {
+        freeNodes.reserve(Capacity);
+        for (auto& node : nodes)
+            freeNodes.push_back(&node);
+    }
+
+    void push(Kind kind, const std::shared_ptr<Destination>& destination, const any& value, std::exception_ptr error)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const ScopedLock lock(producerLock);
+
+        // Keep the order: If values are waiting already, wait behind them
+        if (freeNodes.empty() || !overflow.empty())
+            overflow.emplace_back(kind, value, destination, error);
+        else {
+            Node* const node = freeNodes.back();
+            freeNodes.pop_back();
+            node->kind = kind;
+            node->value = value;
+            node->destination = destination;
+            node->error = error;
+            ready.tryPush(node);
+        }
+
+        if (!isTimerRunning())
+            startTimer(ReleaseIntervalMs);
+    }
+
+    void drain()
+    {
+        ready.popBulk(ready.getCapacity(), [this](Node*&& node) {
+            if (node->destination->is_subscribed()) {
+                switch (node->kind) {
+                    case Next:
+                        node->destination->on_next(node->value);
+                        break;
+                    case Error:
+                        node->destination->on_error(node->error);
+                        break;
+                    case Completed:
+                        node->destination->on_completed();
+                        break;
+                }
+            }
+
+            // Can't fail: There are only Capacity nodes
+            released.tryPush(node);
+        });
+    }
+
+private:
+    static const size_t Capacity = 256;
+    static const int ReleaseIntervalMs = 10;
+
+    struct Node
+    {
+        Node()
+        : kind(Next),
+          value(0)
+        {}
+
+        Node(Kind kind, const any& value, const std::shared_ptr<Destination>& destination, std::exception_ptr error)
+        : kind(kind),
+          value(value),
+          destination(destination),
+          error(error)
+        {}
+
+        Kind kind;
+        any value;
+        std::shared_ptr<Destination> destination;
+        std::exception_ptr error;
+    };
+
+    std::vector<Node> nodes;
+    // Producer -> audio thread
+    SingleProducerQueue<Node*> ready;
+    // Audio thread -> message thread
+    SingleProducerQueue<Node*> released;
+
+    CriticalSection producerLock;
+    std::vector<Node*> freeNodes;
+    std::deque<Node> overflow;
+
+    // Releases the payloads of the delivered nodes on the message thread, and refills the pool
+    void timerCallback() override
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const ScopedLock lock(producerLock);
+
+        released.popBulk(released.getCapacity(), [this](Node*&& node) {
+            node->value = any(0);
+            node->destination.reset();
+            node->error = nullptr;
+            freeNodes.push_back(node);
+        });
+
+        while (!overflow.empty() && !freeNodes.empty()) {
+            Node* const node = freeNodes.back();
+            freeNodes.pop_back();
+            *node = std::move(overflow.front());
+            overflow.pop_front();
+            ready.tryPush(node);
+        }
+
+        if (freeNodes.size() == Capacity)
+            stopTimer();
+    }
+};
+
+// Passes the scheduled actions of timers (e.g. of delay or debounce) to the audio thread, which runs them in AudioThreadScheduler::drain.
+//
+// The actions go through a preallocated single-producer queue. The producers (any thread except the audio thread) are serialized by a lock, so the audio thread never locks. Actions are run in place, and destroyed when their slot is reused by a producer, so the audio thread never frees memory either. Actions that are scheduled for later, or that don't fit into the queue, wait in a pending list, which is pushed into the queue from the message thread when they're due.
+class AudioThreadQueue : private AsyncUpdater, private Timer
+{
+public:
+    typedef rxcpp::schedulers::scheduler_interface::clock_type clock_type;
+
+    AudioThreadQueue()
+    : queue(Capacity, rxcpp::schedulers::make_schedulable(rxcpp::schedulers::make_immediate().create_worker(), [](const rxcpp::schedulers::schedulable&) {}))
+    {}
+
+    void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& action)
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const ScopedLock lock(pendingLock);
+
+        // Actions with the same time stay in FIFO order
+        const auto position = std::upper_bound(pending.begin(), pending.end(), when, [](clock_type::time_point time, const Pending& p) {
+            return time < p.when;
+        });
+        pending.insert(position, Pending{ when, action });
+
+        pushDuePending();
+
+        if (!pending.empty())
+            triggerAsyncUpdate();
+    }
+
+    void drain()
+    {
+        // Let actions recurse in place, instead of scheduling themselves again
+        recursion.reset(true);
+
+        queue.popBulk(queue.getCapacity(), [this](rxcpp::schedulers::schedulable&& action) {
+            if (action.is_subscribed())
+                action(recursion.get_recurse());
+        });
+    }
+
+private:
+    static const size_t Capacity = 256;
+
+    struct Pending
+    {
+        clock_type::time_point when;
+        rxcpp::schedulers::schedulable action;
+    };
+
+    SingleProducerQueue<rxcpp::schedulers::schedulable> queue;
+    rxcpp::schedulers::recursion recursion;
+
+    CriticalSection pendingLock;
+    std::vector<Pending> pending;
+
+    // pendingLock must be locked
+    void pushDuePending()
+    {
+        const auto now = clock_type::now();
+        auto it = pending.begin();
+        while (it != pending.end() && it->when <= now && queue.tryPush(it->action))
+            ++it;
+
+        pending.erase(pending.begin(), it);
+    }
+
+    void handleAsyncUpdate() override
+    {
+        timerCallback();
+    }
+
+    void timerCallback() override
+    {
+        REAX_LOCK_WILL_BE_ACQUIRED();
+        const ScopedLock lock(pendingLock);
+        pushDuePending();
+
+        if (pending.empty()) {
+            stopTimer();
+            return;
+        }
+
+        // Retry when the next action is due, or soon if the queue is full
+        const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(pending.front().when - clock_type::now()).count();
+        startTimer(jmax(1, static_cast<int>(delay) + 1));
+    }
+};
+
+// The state of one AudioThreadScheduler. It's only owned by the AudioThreadScheduler (and its copies). The subscriptions and timers that use it only keep a weak reference, so it's destroyed together with the AudioThreadScheduler (on the message thread), and not on the audio thread.
+struct AudioThreadImpl
+{
+    AudioThreadHandoff handoff;
+    AudioThreadQueue queue;
+    std::atomic<bool> isDraining{ false };
+
+    void drain()
+    {
+        // Only one thread may drain an AudioThreadScheduler at a time! If there are several processors, give each one its own AudioThreadScheduler.
+        const bool wasDraining = isDraining.exchange(true);
+        jassert(!wasDraining);
+        ignoreUnused(wasDraining);
+
+        handoff.drain();
+        queue.drain();
+
+        isDraining.store(false);
+    }
+};
+
+// Runs the timers of time-based operators on an AudioThreadScheduler. Actions that are scheduled after the AudioThreadScheduler has been destroyed are dropped.
+class AudioThreadTimerScheduler : public rxcpp::schedulers::scheduler_interface
+{
+public:
+    explicit AudioThreadTimerScheduler(const std::weak_ptr<AudioThreadImpl>& audioThread)
+    : audioThread(audioThread)
+    {}
+
+    clock_type::time_point now() const override
+    {
+        return clock_type::now();
+    }
+
+    rxcpp::schedulers::worker create_worker(rxcpp::composite_subscription lifetime) const override
+    {
+        return rxcpp::schedulers::worker(lifetime, std::make_shared<Worker>(audioThread));
+    }
+
+private:
+    struct Worker : public rxcpp::schedulers::worker_interface
+    {
+        explicit Worker(const std::weak_ptr<AudioThreadImpl>& audioThread)
+        : audioThread(audioThread)
+        {}
+
+        clock_type::time_point now() const override
+        {
+            return clock_type::now();
+        }
+
+        void schedule(const rxcpp::schedulers::schedulable& scheduled) const override
+        {
+            schedule(now(), scheduled);
+        }
+
+        void schedule(clock_type::time_point when, const rxcpp::schedulers::schedulable& scheduled) const override
+        {
+            if (const auto impl = audioThread.lock())
+                impl->queue.schedule(when, scheduled);
+        }
+
+        const std::weak_ptr<AudioThreadImpl> audioThread;
+    };
+
+    const std::weak_ptr<AudioThreadImpl> audioThread;
+};
+
+// Passes the values of an Observable to the handoff of an AudioThreadScheduler. Values that arrive after the AudioThreadScheduler has been destroyed are dropped.
+SchedulerImpl::Schedule makeAudioThreadSchedule(const std::weak_ptr<AudioThreadImpl>& audioThread)
+{
+    typedef AudioThreadHandoff::Destination Destination;
+
+    return [audioThread](const rxcpp::observable<any>& observable) {
+        return observable.lift<any>([audioThread](const Destination& destination) {
+            const auto shared = std::make_shared<Destination>(destination);
+            const auto push = [shared, audioThread](AudioThreadHandoff::Kind kind, const any& value, std::exception_ptr error) {
+                if (const auto impl = audioThread.lock())
+                    impl->handoff.push(kind, shared, value, error);
+            };
+
+            return rxcpp::make_subscriber<any>(destination,
+                                               [push](const any& value) { push(AudioThreadHandoff::Next, value, nullptr); },
+                                               [push](std::exception_ptr error) { push(AudioThreadHandoff::Error, any(0), error); },
+                                               [push]() { push(AudioThreadHandoff::Completed, any(0), nullptr); });
+        });
+    };
+}
+}
+
+namespace {
+
+    // Creates the threads of a thread pool, and applies the ThreadOptions on each thread before it runs
+    rxcpp::schedulers::scheduler makeConfiguredNewThread(const Scheduler::ThreadOptions& options)
+    {
+        const auto threadCount = std::make_shared<std::atomic<int>>(0);
+
+        return rxcpp::schedulers::make_new_thread([options, threadCount](std::function<void()> run) {
+            const int index = ++*threadCount;
+            const String name = (options.numThreads > 1 ? options.name + " " + String(index) : options.name);
+
+            return std::thread([options, name, run]() {
+                Thread::setCurrentThreadName(name);
+                Thread::setCurrentThreadPriority(jlimit(0, 10, options.priority));
+
+                if (options.affinityMask != 0)
+                    Thread::setCurrentThreadAffinityMask(options.affinityMask);
+
+                run();
+            });
+        });
+    }
+
+    std::shared_ptr<detail::SchedulerImpl> createMessageThreadScheduler(const JUCEDispatcher& dispatcher)
+    {
+        const auto worker = dispatcher.createWorker();
+        return std::make_shared<detail::SchedulerImpl>([worker](const rxcpp::observable<detail::any>& observable) {
+            return observable.observe_on(worker);
+        },
+                                                       dispatcher.getScheduler());
+    }
+
+    std::shared_ptr<detail::SchedulerImpl> createSchedulerImpl(const rxcpp::schedulers::scheduler& scheduler)
+    {
+        const auto worker = rxcpp::observe_on_one_worker(scheduler);
+        return std::make_shared<detail::SchedulerImpl>([worker](const rxcpp::observable<detail::any>& observable) {
+            return observable.observe_on(worker);
+        },
+                                                       scheduler);
+    }
+}
+
+Scheduler::ThreadOptions Scheduler::ThreadOptions::withName(const String& newName) const
+{
+    ThreadOptions options(*this);
+    options.name = newName;
+    return options;
+}
+
+Scheduler::ThreadOptions Scheduler::ThreadOptions::withNumThreads(int newNumThreads) const
+{
+    ThreadOptions options(*this);
+    options.numThreads = newNumThreads;
+    return options;
+}
+
+Scheduler::ThreadOptions Scheduler::ThreadOptions::withPriority(int newPriority) const
+{
+    ThreadOptions options(*this);
+    options.priority = newPriority;
+    return options;
+}
+
+Scheduler::ThreadOptions Scheduler::ThreadOptions::withAffinityMask(uint32 newAffinityMask) const
+{
+    ThreadOptions options(*this);
+    options.affinityMask = newAffinityMask;
+    return options;
 }
 
 Scheduler::Scheduler(const std::shared_ptr<detail::SchedulerImpl>& impl)
@@ -55,23 +660,92 @@ Scheduler::Scheduler(const std::shared_ptr<detail::SchedulerImpl>& impl)
 
 Scheduler Scheduler::messageThread()
 {
-    static const JUCEDispatcher dispatcher;
-    const auto worker = dispatcher.createWorker();
-    return std::make_shared<detail::SchedulerImpl>([worker](const rxcpp::observable<detail::any>& observable) {
-        return observable.observe_on(worker);
-    });
+    static JUCEDispatcher dispatcher(false);
+    return createMessageThreadScheduler(dispatcher);
+}
+
+Scheduler Scheduler::messageThreadFrameAligned()
+{
+    static JUCEDispatcher dispatcher(true);
+    return createMessageThreadScheduler(dispatcher);
 }
 
 Scheduler Scheduler::backgroundThread()
 {
+    // Shared by the timers of all time-based operators on this scheduler, like rxcpp::serialize_event_loop shares its event loop
+    static const auto eventLoop = rxcpp::schedulers::make_event_loop();
+
     return std::make_shared<detail::SchedulerImpl>([](const rxcpp::observable<detail::any>& observable) {
         return observable.observe_on(rxcpp::serialize_event_loop());
-    });
+    },
+                                                   eventLoop);
 }
 
 Scheduler Scheduler::newThread()
 {
     return std::make_shared<detail::SchedulerImpl>([](const rxcpp::observable<detail::any>& observable) {
         return observable.observe_on(rxcpp::serialize_new_thread());
-    });
+    },
+                                                   rxcpp::schedulers::make_new_thread());
+}
+
+Scheduler Scheduler::threadPool(int numThreads)
+{
+    return createSchedulerImpl(rxcpp::schedulers::make_scheduler<ThreadPoolScheduler>(numThreads));
+}
+
+Scheduler Scheduler::threadPool(const ThreadOptions& options)
+{
+    return createSchedulerImpl(rxcpp::schedulers::make_scheduler<ThreadPoolScheduler>(options.numThreads, makeConfiguredNewThread(options)));
+}
+
+VirtualTimeScheduler Scheduler::virtualTime()
+{
+    return VirtualTimeScheduler();
+}
+
+AudioThreadScheduler::AudioThreadScheduler()
+: AudioThreadScheduler(std::make_shared<detail::AudioThreadImpl>())
+{}
+
+AudioThreadScheduler::AudioThreadScheduler(const std::shared_ptr<detail::AudioThreadImpl>& audioThread)
+: Scheduler(std::make_shared<detail::SchedulerImpl>(detail::makeAudioThreadSchedule(audioThread), rxcpp::schedulers::make_scheduler<detail::AudioThreadTimerScheduler>(audioThread))),
+  audioThread(audioThread)
+{}
+
+void AudioThreadScheduler::drain() const
+{
+    audioThread->drain();
+}
+
+VirtualTimeScheduler::VirtualTimeScheduler()
+: VirtualTimeScheduler(std::make_shared<detail::VirtualTimeImpl>())
+{}
+
+VirtualTimeScheduler::VirtualTimeScheduler(const std::shared_ptr<detail::VirtualTimeImpl>& clock)
+: Scheduler(createSchedulerImpl(clock->scheduler)),
+  clock(clock)
+{}
+
+RelativeTime VirtualTimeScheduler::getElapsedTime() const
+{
+    const auto elapsed = clock->virtualClock->now().time_since_epoch();
+    return RelativeTime::milliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+void VirtualTimeScheduler::advanceBy(const RelativeTime& duration) const
+{
+    // Virtual time can't go backwards!
+    jassert(duration.inMilliseconds() >= 0);
+
+    advanceTo(getElapsedTime() + duration);
+}
+
+void VirtualTimeScheduler::advanceTo(const RelativeTime& time) const
+{
+    // Virtual time can't go backwards!
+    jassert(time >= getElapsedTime());
+
+    const auto milliseconds = std::chrono::milliseconds(jmax(time, getElapsedTime()).inMilliseconds());
+    clock->virtualClock->advanceTo(detail::VirtualClock::clock_type::time_point(milliseconds));
 }
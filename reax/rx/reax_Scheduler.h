@@ -2,33 +2,179 @@
 
 namespace detail {
     struct SchedulerImpl;
+    struct VirtualTimeImpl;
+    struct AudioThreadImpl;
 }
 
+class AudioThreadScheduler;
+class VirtualTimeScheduler;
+
 /**
     A Scheduler is used to process parts of an Observable on a specific thread.
  
-    Use the Scheduler::messageThread, Scheduler::backgroundThread and Scheduler::newThread member functions and pass the returned Scheduler to Observable::observeOn.
+    Use the Scheduler::messageThread, Scheduler::messageThreadFrameAligned, Scheduler::backgroundThread, Scheduler::newThread and Scheduler::threadPool member functions and pass the returned Scheduler to Observable::observeOn. For the audio thread, use an AudioThreadScheduler that is owned by the processor.
+ 
+    Time-based operators (like Observable::debounce) can also take a Scheduler. Then their timers run on it, and so do the values they emit. Pass a VirtualTimeScheduler to test them without waiting.
  
-    @see Observable::observeOn
+    @see Observable::observeOn, AudioThreadScheduler, VirtualTimeScheduler
  */
 class Scheduler
 {
 public:
-    /// The JUCE message thread. 
+    /**
+        Configures the threads of a Scheduler that's created with Scheduler::threadPool(const ThreadOptions&).
+     
+        For example, to prepare waveforms on two threads with a higher priority than a disk scan:
+     
+            const auto waveforms = Scheduler::threadPool(Scheduler::ThreadOptions().withName("Waveforms").withNumThreads(2).withPriority(7));
+            const auto diskScan = Scheduler::threadPool(Scheduler::ThreadOptions().withName("Disk Scan").withPriority(2));
+     */
+    struct ThreadOptions
+    {
+        /// The name of the threads, e.g. for debuggers and profilers. If there's more than one thread, a number is appended.
+        juce::String name = "ReaX Scheduler";
+
+        /// The number of threads. Must be at least 1.
+        int numThreads = 1;
+
+        /// The priority of the threads, from 0 (lowest) to 10 (highest), like juce::Thread::setPriority. It may be limited by the operating system.
+        int priority = 5;
+
+        /// A bit mask of the CPU cores that the threads may run on, like juce::Thread::setAffinityMask. 0 means no restriction.
+        juce::uint32 affinityMask = 0;
+
+        ///@{
+        /// Returns a copy with a changed option.
+        ThreadOptions withName(const juce::String& newName) const;
+        ThreadOptions withNumThreads(int newNumThreads) const;
+        ThreadOptions withPriority(int newPriority) const;
+        ThreadOptions withAffinityMask(juce::uint32 newAffinityMask) const;
+        ///@}
+    };
+
+    /**
+        The JUCE message thread. Work is dispatched as soon as it's due, and the message thread isn't woken up if there's nothing to do.
+
+        May be called on any thread. It never waits for the message thread, so it's safe to call during plugin scanning or instantiation. Work that is scheduled before the message thread runs is dispatched when it starts, if the MessageManager exists already. Work that is scheduled before the MessageManager has been created is dispatched as soon as more work is scheduled after that.
+     */
     static Scheduler messageThread();
 
+    /**
+        The JUCE message thread, but work is dispatched at most once per display frame (see also detail::FrameTicker).
+     
+        Use this for GUI updates: All values that arrive between two frames are delivered in the same message thread callback, instead of waking up the message thread for each one of them.
+     */
+    static Scheduler messageThreadFrameAligned();
+
     /// A shared background thread. Use this if you don't want to block the message thread, but don't want to spawn a new thread either. The thread is shared between Observables. 
     static Scheduler backgroundThread();
 
     /// Makes the Observable spawn a new thread. 
     static Scheduler newThread();
 
+    /**
+        A pool of `numThreads` threads. Use this for parallel work (like analyzing many audio files), without spawning a thread for each Observable.
+     
+        Each subscription runs on one of the pool's threads, so the values of an Observable stay in order. Separate subscriptions are spread across the threads, and run in parallel.
+     
+        Each call creates a new pool. Keep the returned Scheduler and pass it to all Observables that should share the pool. The threads are stopped after the Scheduler and all subscriptions that use it have been destroyed.
+     */
+    static Scheduler threadPool(int numThreads = juce::SystemStats::getNumCpus());
+
+    /**
+        Like threadPool(int), but with named threads that have a given priority (and optionally, a CPU affinity). Use separate pools for heavy, low-priority work and for light, latency-sensitive work, so the former can't delay the latter.
+     
+        Like with threadPool(int), each call creates a new pool. Keep the returned Scheduler and reuse it.
+     */
+    static Scheduler threadPool(const ThreadOptions& options);
+
+    /// A scheduler with a virtual clock, for tests. Same as constructing a VirtualTimeScheduler.
+    static VirtualTimeScheduler virtualTime();
+
 private:
     template<typename T>
     friend class Observable;
+    friend class AudioThreadScheduler;
+    friend class VirtualTimeScheduler;
     
     std::shared_ptr<detail::SchedulerImpl> impl;
     Scheduler(const std::shared_ptr<detail::SchedulerImpl>&);
 
     JUCE_LEAK_DETECTOR(Scheduler)
 };
+
+/**
+    A Scheduler for the audio thread (or any other realtime thread). The work is done when you call drain, usually at the top of `processBlock`. Each processor owns its own AudioThreadScheduler, because the hosts may call the `processBlock`s of several plugin instances in parallel:
+ 
+        // Member of the processor, created on the message thread:
+        const AudioThreadScheduler audioThread;
+ 
+        // Message thread:
+        parameterValue.observeOn(audioThread).subscribe([this](float gain) {
+            smoothedGain.setValue(gain); // Called on the audio thread
+        });
+ 
+        // Audio thread:
+        void processBlock(AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            audioThread.drain();
+            // ...
+        }
+ 
+    Each value is copied into a preallocated node, which is passed to the audio thread through a lock-free queue. The message thread releases the delivered nodes and their values later, so draining neither locks nor frees memory. But the operators and the subscriber that run after observeOn must be realtime-safe, too. The timers of time-based operators (like delay) still go through rxcpp, and onError/onCompleted unsubscribe on the audio thread, which may lock.
+ 
+    Copies share the same queues. Create and destroy the AudioThreadScheduler on the message thread. Values that are observed on it after it (and all of its copies) have been destroyed are dropped. Don't observe work on it from the audio thread itself.
+ */
+class AudioThreadScheduler : public Scheduler
+{
+public:
+    /// Creates a scheduler with new, preallocated queues. Call this on the message thread.
+    AudioThreadScheduler();
+
+    /// Does the work that is scheduled on this scheduler. Call this from the audio thread only, e.g. at the top of `processBlock`. Only one thread may drain a scheduler at a time.
+    void drain() const;
+
+private:
+    std::shared_ptr<detail::AudioThreadImpl> audioThread;
+    explicit AudioThreadScheduler(const std::shared_ptr<detail::AudioThreadImpl>& audioThread);
+
+    JUCE_LEAK_DETECTOR(AudioThreadScheduler)
+};
+
+/**
+    A Scheduler with a virtual clock, which only moves forward when you call advanceBy or advanceTo. Scheduled work (including the timers of time-based operators) runs inside these calls, on the calling thread.
+ 
+    Use this to test time-based Observables deterministically, and without waiting:
+ 
+        const auto scheduler = Scheduler::virtualTime();
+        Array<String> searches;
+        searchField.debounce(RelativeTime::seconds(0.5), scheduler).subscribe([&](const String& text) { searches.add(text); });
+ 
+        searchField.onNext("Re");
+        scheduler.advanceBy(RelativeTime::seconds(0.2)); // Nothing yet
+        searchField.onNext("ReaX");
+        scheduler.advanceBy(RelativeTime::seconds(0.5)); // searches is { "ReaX" }
+ 
+    The clock starts at 0 and has millisecond resolution. Copies share the same clock. A VirtualTimeScheduler isn't thread-safe: Only use it from one thread, and don't advance it from work that runs on it.
+ */
+class VirtualTimeScheduler : public Scheduler
+{
+public:
+    /// Creates a scheduler with a new virtual clock.
+    VirtualTimeScheduler();
+
+    /// Returns how much virtual time has passed since the clock has been created.
+    juce::RelativeTime getElapsedTime() const;
+
+    /// Moves the clock forward by `duration`, and runs all work that's due until then (in order). Passing 0 runs the work that's due now.
+    void advanceBy(const juce::RelativeTime& duration) const;
+
+    /// Moves the clock forward to `time` (measured from the creation of the clock), and runs all work that's due until then. `time` must not be earlier than getElapsedTime().
+    void advanceTo(const juce::RelativeTime& time) const;
+
+private:
+    std::shared_ptr<detail::VirtualTimeImpl> clock;
+    explicit VirtualTimeScheduler(const std::shared_ptr<detail::VirtualTimeImpl>& clock);
+
+    JUCE_LEAK_DETECTOR(VirtualTimeScheduler)
+};
@@ -34,16 +34,61 @@ class BehaviorSubject : public Subject<T>
 public:
     /// Creates a new instance with a given initial value 
     explicit BehaviorSubject(const T& initial)
-    : Subject<T>(detail::SubjectImpl::MakeBehaviorSubjectImpl(detail::any(initial)))
+    : BehaviorSubject(initial, makeAtomicValue(initial, detail::IsAtomicallyStorable<T>()))
     {}
 
-    /// Returns the most recently emitted value. If no values have been emitted, it returns the initial value. 
+    /**
+     Returns the most recently emitted value. If no values have been emitted, it returns the initial value.
+     
+     If T is trivially copyable (e.g. float, double, bool or a struct of those), the value is stored atomically. Then getValue() never locks or allocates, so it's safe to call from a realtime thread (like the audio thread).
+     */
     T getValue() const
     {
-        return Subject<T>::impl.getValue().template get<T>();
+        return getValue(detail::IsAtomicallyStorable<T>());
     }
 
 private:
+    typedef detail::AtomicValue<T> AtomicValue;
+
+    // Only set if T is trivially copyable. It's updated before the subject emits, so subscribers see the new value.
+    const std::shared_ptr<AtomicValue> atomicValue;
+
+    BehaviorSubject(const T& initial, const std::shared_ptr<AtomicValue>& atomicValue)
+    : Subject<T>(makeImpl(initial, atomicValue, detail::IsAtomicallyStorable<T>())),
+      atomicValue(atomicValue)
+    {}
+
+    static detail::SubjectImpl makeImpl(const T& initial, const std::shared_ptr<AtomicValue>& atomicValue, std::true_type /* isAtomicallyStorable */)
+    {
+        return detail::SubjectImpl::MakeBehaviorSubjectImpl(detail::any(initial), [atomicValue](const detail::any& value) {
+            atomicValue->store(value.get<T>());
+        });
+    }
+    static detail::SubjectImpl makeImpl(const T& initial, const std::shared_ptr<AtomicValue>&, std::false_type /* isAtomicallyStorable */)
+    {
+        return detail::SubjectImpl::MakeBehaviorSubjectImpl(detail::any(initial));
+    }
+
+    static std::shared_ptr<AtomicValue> makeAtomicValue(const T& initial, std::true_type /* isAtomicallyStorable */)
+    {
+        return std::make_shared<AtomicValue>(initial);
+    }
+    static std::shared_ptr<AtomicValue> makeAtomicValue(const T&, std::false_type /* isAtomicallyStorable */)
+    {
+        return nullptr;
+    }
+
+    T getValue(std::true_type /* isAtomicallyStorable */) const
+    {
+        REAX_REALTIME_SCOPE("BehaviorSubject::getValue");
+
+        return atomicValue->load();
+    }
+    T getValue(std::false_type /* isAtomicallyStorable */) const
+    {
+        return Subject<T>::impl.getValue().template get<T>();
+    }
+
     JUCE_LEAK_DETECTOR(BehaviorSubject)
 };
 
@@ -62,10 +107,52 @@ public:
     : Subject<T>(detail::SubjectImpl::MakePublishSubjectImpl())
     {}
 
+    /// Returns true if the subject has at least one subscriber. Use this to skip preparing values that nobody would receive. May be called from any thread, but the result may be outdated immediately.
+    bool hasSubscribers() const
+    {
+        return Subject<T>::impl.hasObservers();
+    }
+
 private:
     JUCE_LEAK_DETECTOR(PublishSubject)
 };
 
+/**
+ A PublishSubject for many subscribers, or for subscribers that change while values are emitted from other threads.
+ 
+ The subscribers are stored in an immutable list, which is replaced on each subscribe and unsubscribe (copy-on-write). So onNext only loads the current list, and iterates over it without holding a lock. Loading and replacing the list use `std::atomic_load` and `std::atomic_store` on a `std::shared_ptr`, which most standard libraries implement with a short internal lock. That lock is only held while the pointer is copied, so subscribing or unsubscribing never waits for an onNext call to finish, and vice versa. But onNext isn't lock-free, so don't call it on a realtime thread. Subscribing and unsubscribing are more expensive than with PublishSubject, because they copy the list.
+ 
+ A subscriber that is unsubscribed while onNext is running on another thread may still receive the value that is currently emitted.
+ 
+ ​ **Like with the other Subjects, calls to onNext must not overlap.** If several threads push values, you must synchronize them yourself.
+ 
+ For an introduction to Subjects, please refer to http://reactivex.io/documentation/subject.html.
+ */
+template<typename T>
+class ConcurrentPublishSubject : public Subject<T>
+{
+public:
+    /// Creates a new instance.
+    ConcurrentPublishSubject()
+    : Subject<T>(detail::SubjectImpl::MakeConcurrentPublishSubjectImpl())
+    {}
+
+private:
+    JUCE_LEAK_DETECTOR(ConcurrentPublishSubject)
+};
+
+/**
+ Determines how a ReplaySubject stores the values that it replays.
+ 
+ Growing: The buffer grows as values are emitted, up to the buffer size. New subscribers receive the values one by one.
+ 
+ Preallocated: The buffer is a contiguous ring of exactly `bufferSize` values, which is allocated when the ReplaySubject is created. Storing a value never allocates (unless copying T allocates). A new subscriber receives the values from one snapshot of the ring, synchronously when subscribing. Use this for a "last N values" history with a known, reasonable buffer size.
+ */
+enum class ReplayBufferMode {
+    Growing,
+    Preallocated
+};
+
 /**
  A Subject that, on every new subscription, notifies the Observer with all of the values that were emitted since the ReplaySubject was created. It then continues to emit any values that are passed to onNext.
  
@@ -84,6 +171,23 @@ public:
     : Subject<T>(detail::SubjectImpl::MakeReplaySubjectImpl(bufferSize))
     {}
 
+    /**
+     Creates a new instance with a given ReplayBufferMode.
+     
+     ​ **With ReplayBufferMode::Preallocated, asserts that `bufferSize` is neither zero nor unlimited.**
+     */
+    ReplaySubject(size_t bufferSize, ReplayBufferMode mode)
+    : Subject<T>(mode == ReplayBufferMode::Preallocated ? detail::SubjectImpl::MakePreallocatedReplaySubjectImpl(checkedPreallocatedSize(bufferSize)) : detail::SubjectImpl::MakeReplaySubjectImpl(bufferSize))
+    {}
+
 private:
+    static size_t checkedPreallocatedSize(size_t bufferSize)
+    {
+        // A preallocated buffer needs a finite, non-zero size!
+        jassert(bufferSize > 0 && bufferSize < std::numeric_limits<size_t>::max());
+
+        return bufferSize;
+    }
+
     JUCE_LEAK_DETECTOR(ReplaySubject)
 };
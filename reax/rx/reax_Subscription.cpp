@@ -1,10 +1,60 @@
-Subscription::Subscription(detail::any&& wrapped)
-: wrapped(std::move(wrapped))
+namespace {
+rxcpp::subscription& getRxSubscription(void* storage)
+{
+    return *static_cast<rxcpp::subscription*>(storage);
+}
+
+const rxcpp::subscription& getRxSubscription(const void* storage)
+{
+    return *static_cast<const rxcpp::subscription*>(storage);
+}
+}
+
+Subscription::Subscription()
+: isPlaceholder(true)
 {}
 
+Subscription::Subscription(const Subscription& other)
+: isPlaceholder(other.isPlaceholder)
+{
+    if (!isPlaceholder)
+        new (&storage) rxcpp::subscription(getRxSubscription(&other.storage));
+}
+
+Subscription& Subscription::operator=(const Subscription& other)
+{
+    if (!isPlaceholder && !other.isPlaceholder)
+        getRxSubscription(&storage) = getRxSubscription(&other.storage);
+    else if (!isPlaceholder) {
+        getRxSubscription(&storage).~subscription();
+        isPlaceholder = true;
+    }
+    else if (!other.isPlaceholder) {
+        new (&storage) rxcpp::subscription(getRxSubscription(&other.storage));
+        isPlaceholder = false;
+    }
+
+    return *this;
+}
+
+Subscription::~Subscription()
+{
+    if (!isPlaceholder)
+        getRxSubscription(&storage).~subscription();
+}
+
+Subscription Subscription::placeholder()
+{
+    return Subscription();
+}
+
 void Subscription::unsubscribe() const
 {
-    wrapped.get<rxcpp::subscription>().unsubscribe();
+    // A placeholder can't be unsubscribed!
+    jassert(!isPlaceholder);
+
+    if (!isPlaceholder)
+        getRxSubscription(&storage).unsubscribe();
 }
 
 void Subscription::disposedBy(DisposeBag& disposeBag)
@@ -9,16 +9,21 @@ class DisposeBag;
 /**
     Manages the lifetime of a subscription to an Observable.
  
+    The underlying subscription is stored inline, so creating, copying and storing a Subscription (e.g. in a DisposeBag) doesn't allocate.
+ 
     @see Observable::subscribe
  */
 class Subscription
 {
 public:
     /// Copy constructor.
-    Subscription(const Subscription&) = default;
+    Subscription(const Subscription& other);
     
     /// Copy assignment.
-    Subscription& operator=(const Subscription&) = default;
+    Subscription& operator=(const Subscription& other);
+
+    /// Destructor. Doesn't unsubscribe.
+    ~Subscription();
     
     /// Unsubscribes from the Observable.
     void unsubscribe() const;
@@ -36,9 +41,25 @@ private:
     friend struct detail::ObservableImpl;
     friend class DisposeBag;
     
-    detail::any wrapped;
+    // Large enough for an rxcpp::subscription, which holds a single shared_ptr
+    typedef std::aligned_storage<4 * sizeof(void*), alignof(std::max_align_t)>::type Storage;
+
+    Storage storage;
+    bool isPlaceholder;
+
+    // Only used by ObservableImpl, with an rxcpp::subscription
+    template<typename RxSubscription>
+    explicit Subscription(const RxSubscription& subscription)
+    : isPlaceholder(false)
+    {
+        static_assert(sizeof(RxSubscription) <= sizeof(Storage) && alignof(RxSubscription) <= alignof(Storage), "The subscription doesn't fit into the inline storage!");
+        new (&storage) RxSubscription(subscription);
+    }
+
+    Subscription();
 
-    explicit Subscription(detail::any&& wrapped);
+    // Used by DisposeBag for unused slots. Must not be unsubscribed.
+    static Subscription placeholder();
 
     JUCE_LEAK_DETECTOR(Subscription)
 };
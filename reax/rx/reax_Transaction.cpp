@@ -0,0 +1,88 @@
+namespace detail {
+TransactionState& TransactionState::getCurrent()
+{
+    thread_local TransactionState state;
+    return state;
+}
+
+bool TransactionState::defer(const std::shared_ptr<const void>& subject, const any& value, const Emit& emit)
+{
+    if (depth == 0)
+        return false;
+
+    const auto it = indices.find(subject.get());
+    if (it != indices.end())
+        deferred[it->second].value = value;
+    else {
+        indices.emplace(subject.get(), deferred.size());
+        deferred.push_back(Deferred{ subject, value, emit });
+    }
+
+    return true;
+}
+
+void TransactionState::flush(const void* subject)
+{
+    const auto it = indices.find(subject);
+    if (it == indices.end())
+        return;
+
+    // Keep the slot, so the other indices stay valid. It's skipped when the transaction ends.
+    auto& item = deferred[it->second];
+    const auto subjectToFlush = std::move(item.subject);
+    const auto value = item.value;
+    const auto emit = item.emit;
+    indices.erase(it);
+
+    emit(value);
+}
+
+void TransactionState::begin()
+{
+    ++depth;
+}
+
+void TransactionState::end()
+{
+    // Transaction destroyed more often than it has been created!
+    jassert(depth > 0);
+
+    if (--depth > 0)
+        return;
+
+    // Take the changes first: Subscribers may change subjects again, and those changes emit right away
+    std::vector<Deferred> changes;
+    changes.swap(deferred);
+    indices.clear();
+
+    // One wave for all changes, so glitch-free operators that depend on several of the subjects settle once
+    PropagationWave wave;
+
+    for (auto& change : changes) {
+        if (change.subject)
+            change.emit(change.value);
+    }
+
+    wave.settle();
+}
+
+bool TransactionState::isActive() const
+{
+    return (depth > 0);
+}
+}
+
+Transaction::Transaction()
+{
+    detail::TransactionState::getCurrent().begin();
+}
+
+Transaction::~Transaction()
+{
+    detail::TransactionState::getCurrent().end();
+}
+
+bool Transaction::isActive()
+{
+    return detail::TransactionState::getCurrent().isActive();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ Batches the changes of BehaviorSubjects, so that derived Observables recompute once per changed subject instead of once per change.
+
+ While a Transaction exists, BehaviorSubjects (including the subjects of Reactive<juce::Value> and AudioProcessorValueTreeStateExtension::parameterValue) don't emit the values that are passed to onNext. Each subject only remembers its latest value. When the outermost Transaction is destroyed, each changed subject emits once, with its final value, in the order in which the subjects were first changed:
+
+     {
+         Transaction transaction;
+
+         for (auto& parameter : preset)
+             valueTreeState.rx.parameterValue(parameter.id).onNext(parameter.value);
+     } // Every changed parameter emits once here, so a combineLatest of them recomputes once per changed parameter instead of once per onNext call
+
+ All changes are emitted in one propagation. So to recompute a combination only once per Transaction, combine the subjects with Propagation::GlitchFree:
+
+     first.combineLatest(Propagation::GlitchFree, [](int a, int b) { return a + b; }, second); // Emits once per Transaction
+
+ Transactions can be nested. Only the onNext calls on the thread that created the Transaction are deferred, so use it on the message thread. Until the Transaction ends, BehaviorSubject::getValue returns the previously emitted value. Other Subjects (which emit events instead of state) are not affected. If a changed subject is terminated (with onError or onCompleted) within the Transaction, it emits its latest value first.
+ */
+class Transaction
+{
+public:
+    /// Begins a transaction on the calling thread.
+    Transaction();
+
+    /// Ends the transaction. If it's the outermost one on this thread, all changed subjects emit their final values.
+    ~Transaction();
+
+    /// Returns true if a Transaction exists on the calling thread.
+    static bool isActive();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Transaction)
+    JUCE_PREVENT_HEAP_ALLOCATION
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+/// \cond internal
+namespace detail {
+// The first stage of every TypedPipeline: Passes the source value through unchanged.
+template<typename T>
+struct IdentityStage
+{
+    template<typename Sink>
+    void operator()(const T& value, const Sink& sink)
+    {
+        sink(value);
+    }
+};
+
+template<typename Previous, typename Function>
+struct MapStage
+{
+    Previous previous;
+    Function function;
+
+    template<typename Sink>
+    struct Next
+    {
+        Function& function;
+        const Sink& sink;
+
+        template<typename V>
+        void operator()(const V& value) const
+        {
+            sink(function(value));
+        }
+    };
+
+    template<typename In, typename Sink>
+    void operator()(const In& value, const Sink& sink)
+    {
+        previous(value, Next<Sink>{ function, sink });
+    }
+};
+
+template<typename Previous, typename Predicate>
+struct FilterStage
+{
+    Previous previous;
+    Predicate predicate;
+
+    template<typename Sink>
+    struct Next
+    {
+        Predicate& predicate;
+        const Sink& sink;
+
+        template<typename V>
+        void operator()(const V& value) const
+        {
+            if (predicate(value))
+                sink(value);
+        }
+    };
+
+    template<typename In, typename Sink>
+    void operator()(const In& value, const Sink& sink)
+    {
+        previous(value, Next<Sink>{ predicate, sink });
+    }
+};
+
+template<typename Previous, typename Function, typename Accumulator>
+struct ScanStage
+{
+    Previous previous;
+    Function function;
+    Accumulator accumulator;
+
+    template<typename Sink>
+    struct Next
+    {
+        Function& function;
+        Accumulator& accumulator;
+        const Sink& sink;
+
+        template<typename V>
+        void operator()(const V& value) const
+        {
+            accumulator = function(accumulator, value);
+            sink(accumulator);
+        }
+    };
+
+    template<typename In, typename Sink>
+    void operator()(const In& value, const Sink& sink)
+    {
+        previous(value, Next<Sink>{ function, accumulator, sink });
+    }
+};
+}
+/// \endcond
+
+/**
+ A chain of `map`, `filter` and `scan` operators that works on typed values, without boxing every intermediate value.
+
+ The operators of an Observable type-erase each value they emit. For short lambdas that run very often (e.g. when mapping the value of a Slider to a meter position), boxing and unboxing the intermediate values is more expensive than the lambdas themselves. A TypedPipeline fuses all its stages into a single operator: The source value is unboxed once, passed through all stages as a plain `T`, and only the final result is boxed again.
+
+ You get a TypedPipeline by calling Observable::typed(). Convert it back to an Observable (implicitly, or by calling TypedPipeline::asObservable) when you need any other operator, a Scheduler or a Subject:
+
+     Observable<float> position = slider.rx.value.typed()
+         .filter([](double d) { return d >= 0; })
+         .map([](double d) { return std::sqrt(d); })
+         .map([](double d) { return static_cast<float>(d); });
+
+ Stages that keep state (like `scan`) are copied for each Subscription, just like their Observable counterparts.
+
+ @see Observable::typed
+ */
+template<typename Source, typename T, typename Stage>
+class TypedPipeline
+{
+    template<typename Function, typename... Args>
+    using CallResult = typename std::decay<typename std::result_of<Function(Args...)>::type>::type;
+
+public:
+    /// The type of values emitted by this TypedPipeline.
+    typedef T ValueType;
+
+    /// Creates a TypedPipeline which applies `stage` to all values emitted by `source`. Use Observable::typed() instead.
+    TypedPipeline(const Observable<Source>& source, const Stage& stage)
+    : source(source),
+      stage(stage)
+    {}
+
+    /**
+     For each value, calls the function with that value and emits the result.
+
+     @see Observable::map
+     */
+    template<typename Function>
+    TypedPipeline<Source, CallResult<Function, T>, detail::MapStage<Stage, typename std::decay<Function>::type>> map(Function&& function) const
+    {
+        typedef detail::MapStage<Stage, typename std::decay<Function>::type> Next;
+        return TypedPipeline<Source, CallResult<Function, T>, Next>(source, Next{ stage, std::forward<Function>(function) });
+    }
+
+    /**
+     Emits only those values that pass the predicate.
+
+     @see Observable::filter
+     */
+    template<typename Predicate>
+    TypedPipeline<Source, T, detail::FilterStage<Stage, typename std::decay<Predicate>::type>> filter(Predicate&& predicate) const
+    {
+        typedef detail::FilterStage<Stage, typename std::decay<Predicate>::type> Next;
+        return TypedPipeline<Source, T, Next>(source, Next{ stage, std::forward<Predicate>(predicate) });
+    }
+
+    /**
+     Calls `f` with the accumulator (initially `startValue`) and the current value, emits the result and remembers it as the new accumulator.
+
+     @see Observable::scan
+     */
+    template<typename Function>
+    TypedPipeline<Source, T, detail::ScanStage<Stage, typename std::decay<Function>::type, T>> scan(const T& startValue, Function&& f) const
+    {
+        typedef detail::ScanStage<Stage, typename std::decay<Function>::type, T> Next;
+        return TypedPipeline<Source, T, Next>(source, Next{ stage, std::forward<Function>(f), startValue });
+    }
+
+    /**
+     Returns an Observable that runs all stages of this TypedPipeline in a single operator.
+     */
+    Observable<T> asObservable() const
+    {
+        Stage stage(this->stage);
+
+        return source.impl.transform([stage](detail::any& value) mutable {
+            bool emitted = false;
+            // The sink only replaces value after the whole chain has computed the result from it
+            stage(value.get<Source>(), [&](const T& result) {
+                value = Observable<T>::toAny(result);
+                emitted = true;
+            });
+            return emitted;
+        });
+    }
+
+    /// Converts this TypedPipeline to an Observable. @see TypedPipeline::asObservable
+    operator Observable<T>() const
+    {
+        return asObservable();
+    }
+
+    /**
+     Subscribes to the TypedPipeline. The values are passed to `onNext` without being boxed at all.
+
+     @see Observable::subscribe
+     */
+    Subscription subscribe(const std::function<void(const T&)>& onNext,
+                           const std::function<void(std::exception_ptr)>& onError = detail::ObservableImpl::TerminateOnError,
+                           const std::function<void()>& onCompleted = detail::ObservableImpl::EmptyOnCompleted) const
+    {
+        // Each subscription needs its own copy of the stages, so their state isn't shared
+        auto stage = std::make_shared<Stage>(this->stage);
+
+        return source.impl.subscribe([stage, onNext](const detail::any& value) {
+            (*stage)(value.get<Source>(), onNext);
+        },
+                                     onError,
+                                     onCompleted);
+    }
+
+private:
+    const Observable<Source> source;
+    const Stage stage;
+
+    JUCE_LEAK_DETECTOR(TypedPipeline)
+};
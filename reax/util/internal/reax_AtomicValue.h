@@ -0,0 +1,97 @@
+#pragma once
+
+namespace detail {
+/// Whether AtomicValue<T> can be used for T.
+template<typename T>
+using IsAtomicallyStorable = std::integral_constant<bool, std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value>;
+
+/**
+ Holds a trivially copyable value, which may be read from any thread (including realtime threads) while another thread writes it. Never allocates and never locks.
+
+ Arithmetic types, enums and pointers are stored in a std::atomic<T>, so load() is wait-free. Other types (e.g. structs of several floats) are stored in a sequence lock: load() retries if a store() happens at the same time. Writers must not overlap.
+ */
+template<typename T, typename Enable = void>
+class AtomicValue
+{
+    static_assert(IsAtomicallyStorable<T>::value, "AtomicValue needs a trivially copyable type.");
+
+public:
+    explicit AtomicValue(const T& initial)
+    {
+        store(initial);
+    }
+
+    T load() const
+    {
+        std::array<juce::uint64, NumWords> buffer;
+
+        for (;;) {
+            const juce::uint32 before = sequence.load(std::memory_order_acquire);
+
+            // A store() is in progress
+            if (before & 1)
+                continue;
+
+            for (size_t i = 0; i < NumWords; ++i)
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        T value;
+        std::memcpy(&value, buffer.data(), sizeof(T));
+        return value;
+    }
+
+    void store(const T& value)
+    {
+        std::array<juce::uint64, NumWords> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+
+        const juce::uint32 before = sequence.load(std::memory_order_relaxed);
+        sequence.store(before + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < NumWords; ++i)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+
+        sequence.store(before + 2, std::memory_order_release);
+    }
+
+private:
+    static const size_t NumWords = (sizeof(T) + sizeof(juce::uint64) - 1) / sizeof(juce::uint64);
+
+    std::atomic<juce::uint32> sequence{ 0 };
+    std::array<std::atomic<juce::uint64>, NumWords> words;
+
+    JUCE_DECLARE_NON_COPYABLE(AtomicValue)
+};
+
+/// \cond internal
+template<typename T>
+class AtomicValue<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>::type>
+{
+public:
+    explicit AtomicValue(const T& initial)
+    : value(initial)
+    {}
+
+    T load() const
+    {
+        return value.load();
+    }
+
+    void store(const T& newValue)
+    {
+        value.store(newValue);
+    }
+
+private:
+    std::atomic<T> value;
+
+    JUCE_DECLARE_NON_COPYABLE(AtomicValue)
+};
+/// \endcond
+}
@@ -0,0 +1,54 @@
+namespace detail {
+FrameTicker& FrameTicker::getInstance()
+{
+    static FrameTicker ticker;
+    return ticker;
+}
+
+FrameTicker::FrameTicker() {}
+
+void FrameTicker::requestFrame(Client& client)
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    requests.addIfNotAlreadyThere(&client);
+
+    if (!isTimerRunning())
+        startTimerHz(frameRate);
+}
+
+void FrameTicker::cancelFrame(Client& client)
+{
+    requests.removeAllInstancesOf(&client);
+    dueClients.removeAllInstancesOf(&client);
+}
+
+void FrameTicker::setFrameRate(int framesPerSecond)
+{
+    // The frame rate must be > 0!
+    jassert(framesPerSecond > 0);
+
+    frameRate = jmax(1, framesPerSecond);
+
+    if (isTimerRunning())
+        startTimerHz(frameRate);
+}
+
+int FrameTicker::getFrameRate() const
+{
+    return frameRate;
+}
+
+void FrameTicker::timerCallback()
+{
+    // Clients may request the next frame from their callback, so take the current requests first
+    dueClients.swapWith(requests);
+
+    while (!dueClients.isEmpty())
+        dueClients.removeAndReturn(0)->frameDidTick();
+
+    if (requests.isEmpty())
+        stopTimer();
+}
+}
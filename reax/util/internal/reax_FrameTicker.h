@@ -0,0 +1,50 @@
+#pragma once
+
+namespace detail {
+/**
+ Calls its clients on the JUCE message thread once per display frame, but only while at least one client has requested a frame. If nobody needs a frame, there's no timer running and the message thread isn't woken up.
+
+ JUCE doesn't expose the display's vertical blank, so the frames are driven by a single shared Timer at the display refresh rate (60 Hz, unless changed with setFrameRate). Because all clients share that timer, their work is batched into the same message thread callback.
+
+ Must only be used from the message thread.
+ */
+class FrameTicker : private juce::Timer
+{
+public:
+    /// Gets notified when a requested frame is due.
+    class Client
+    {
+    public:
+        virtual ~Client() {}
+
+        /// Called on the next frame after requestFrame. Call requestFrame again from here if you need another frame.
+        virtual void frameDidTick() = 0;
+    };
+
+    /// Returns the shared instance. May be called on any thread, but all other member functions must be called on the message thread.
+    static FrameTicker& getInstance();
+
+    /// Makes the FrameTicker call `client.frameDidTick()` once, on the next frame. Requesting a frame more than once before it's due has no effect.
+    void requestFrame(Client& client);
+
+    /// Cancels a frame that has been requested by `client`. Must be called before a client with a pending request is destroyed.
+    void cancelFrame(Client& client);
+
+    /// Changes the number of frames per second.
+    void setFrameRate(int framesPerSecond);
+
+    /// Returns the number of frames per second.
+    int getFrameRate() const;
+
+private:
+    FrameTicker();
+
+    juce::Array<Client*> requests;
+    juce::Array<Client*> dueClients;
+    int frameRate = 60;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameTicker)
+};
+}
@@ -0,0 +1,207 @@
+namespace detail {
+namespace {
+    // A bounded multi-producer multi-consumer queue of free blocks (Dmitry Vyukov's algorithm). The cells are allocated upfront, so pushing and popping are lock-free and never allocate. Each cell has a sequence number, which prevents the ABA problem of a lock-free stack.
+    class FreeList
+    {
+    public:
+        // The capacity must be a power of two
+        explicit FreeList(size_t capacity)
+        : cells(new Cell[capacity]),
+          mask(capacity - 1)
+        {
+            jassert(isPowerOfTwo(capacity));
+
+            for (size_t i = 0; i < capacity; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Returns false if the list is full
+        bool tryPush(void* block) noexcept
+        {
+            size_t position = pushPosition.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells[position & mask];
+                const auto difference = static_cast<std::intptr_t>(cell.sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position);
+
+                if (difference == 0) {
+                    if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.block = block;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                    return false;
+                else
+                    position = pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Returns false if the list is empty
+        bool tryPop(void*& block) noexcept
+        {
+            size_t position = popPosition.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells[position & mask];
+                const auto difference = static_cast<std::intptr_t>(cell.sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position + 1);
+
+                if (difference == 0) {
+                    if (popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        block = cell.block;
+                        cell.sequence.store(position + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                    return false;
+                else
+                    position = popPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            void* block = nullptr;
+        };
+
+        static const size_t CacheLineSize = 64;
+
+        const std::unique_ptr<Cell[]> cells;
+        const size_t mask;
+
+        // Padded to separate cache lines, so pushing and popping threads don't invalidate each other's cache lines
+        char padding0[CacheLineSize];
+        std::atomic<size_t> pushPosition{ 0 };
+        char padding1[CacheLineSize - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> popPosition{ 0 };
+        char padding2[CacheLineSize - sizeof(std::atomic<size_t>)];
+    };
+}
+
+std::atomic<size_t> BlockPool::numLargeBytesInUse{ 0 };
+
+struct BlockPool::SizeClass
+{
+    SizeClass()
+    : freeBlocks(MaxFreeBlocks)
+    {}
+
+    size_t blockSize = 0;
+    FreeList freeBlocks;
+    std::atomic<size_t> numFreeBlocks{ 0 };
+    std::atomic<size_t> numBlocksInUse{ 0 };
+    std::atomic<uint64> numHeapAllocations{ 0 };
+};
+
+BlockPool::SizeClass* BlockPool::getSizeClass(size_t numBytes)
+{
+    // Never destroyed, because blocks may still be deallocated during static destruction
+    static SizeClass* const sizeClasses = []() {
+        auto classes = new SizeClass[NumSizeClasses];
+        for (size_t i = 0; i < NumSizeClasses; ++i)
+            classes[i].blockSize = (MinBlockSize << i);
+
+        return classes;
+    }();
+
+    if (numBytes > MaxBlockSize)
+        return nullptr;
+
+    size_t index = 0;
+    while ((MinBlockSize << index) < numBytes)
+        ++index;
+
+    return &sizeClasses[index];
+}
+
+void* BlockPool::allocate(size_t numBytes)
+{
+    SizeClass* const sizeClass = getSizeClass(numBytes);
+    if (sizeClass == nullptr) {
+        numLargeBytesInUse.fetch_add(numBytes, std::memory_order_relaxed);
+        return ::operator new(numBytes);
+    }
+
+    sizeClass->numBlocksInUse.fetch_add(1, std::memory_order_relaxed);
+
+    void* block = nullptr;
+    if (sizeClass->freeBlocks.tryPop(block)) {
+        sizeClass->numFreeBlocks.fetch_sub(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    sizeClass->numHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(sizeClass->blockSize);
+}
+
+void BlockPool::deallocate(void* block, size_t numBytes) noexcept
+{
+    SizeClass* const sizeClass = getSizeClass(numBytes);
+    if (sizeClass == nullptr) {
+        numLargeBytesInUse.fetch_sub(numBytes, std::memory_order_relaxed);
+        ::operator delete(block);
+        return;
+    }
+
+    sizeClass->numBlocksInUse.fetch_sub(1, std::memory_order_relaxed);
+
+    // Keep the block for later. The global allocator only gets it back if the size class caches MaxFreeBlocks free blocks already.
+    // Counted before pushing, so a concurrent allocate can't make the count negative
+    sizeClass->numFreeBlocks.fetch_add(1, std::memory_order_relaxed);
+    if (sizeClass->freeBlocks.tryPush(block))
+        return;
+
+    sizeClass->numFreeBlocks.fetch_sub(1, std::memory_order_relaxed);
+    ::operator delete(block);
+}
+
+void BlockPool::reserve(size_t numBytes, size_t numBlocks)
+{
+    SizeClass* const sizeClass = getSizeClass(numBytes);
+
+    // Blocks larger than MaxBlockSize aren't pooled!
+    jassert(sizeClass != nullptr);
+
+    if (sizeClass == nullptr)
+        return;
+
+    const size_t targetSize = jmin(numBlocks, MaxFreeBlocks);
+    while (sizeClass->numFreeBlocks.load() < targetSize) {
+        void* const block = ::operator new(sizeClass->blockSize);
+        sizeClass->numHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        sizeClass->numFreeBlocks.fetch_add(1, std::memory_order_relaxed);
+
+        // Another thread has filled the free list in the meantime
+        if (!sizeClass->freeBlocks.tryPush(block)) {
+            sizeClass->numFreeBlocks.fetch_sub(1, std::memory_order_relaxed);
+            ::operator delete(block);
+            break;
+        }
+    }
+}
+
+std::vector<BlockPool::Usage> BlockPool::getUsage()
+{
+    std::vector<Usage> usage;
+    for (size_t blockSize = MinBlockSize; blockSize <= MaxBlockSize; blockSize *= 2) {
+        const SizeClass* const sizeClass = getSizeClass(blockSize);
+        usage.push_back({ blockSize,
+                          sizeClass->numBlocksInUse.load(),
+                          sizeClass->numFreeBlocks.load(),
+                          sizeClass->numHeapAllocations.load() });
+    }
+
+    return usage;
+}
+
+size_t BlockPool::getNumBytesInUse()
+{
+    size_t numBytes = numLargeBytesInUse.load();
+    for (auto& usage : getUsage())
+        numBytes += usage.blockSize * usage.numBlocksInUse;
+
+    return numBytes;
+}
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+namespace detail {
+/**
+ Size-classed pools of memory blocks, with lock-free free lists. Used for the objects of `any`, so that emitting large values reuses memory instead of going through the global allocator every time.
+
+ Blocks are sized in powers of two from MinBlockSize to MaxBlockSize. Larger requests go to the global allocator directly. Each size class caches up to MaxFreeBlocks unused blocks, in a free list that is allocated upfront, so returning a block to the pool never allocates. Only if a size class caches MaxFreeBlocks blocks already, a returned block is freed by the global allocator.
+
+ Blocks are aligned like the global `operator new`, i.e. for `std::max_align_t`. Over-aligned types can't be pooled.
+
+ @see MemoryPool
+ */
+class BlockPool
+{
+public:
+    static const size_t MinBlockSize = 64;
+    static const size_t MaxBlockSize = 4096;
+    static const size_t NumSizeClasses = 7;
+    static const size_t MaxFreeBlocks = 4096;
+
+    /// The usage of one size class.
+    struct Usage
+    {
+        size_t blockSize;
+        size_t numBlocksInUse;
+        size_t numFreeBlocks;
+        juce::uint64 numHeapAllocations;
+    };
+
+    /// Returns a block of at least numBytes bytes, from the pool if possible.
+    static void* allocate(size_t numBytes);
+
+    /// Returns a block that has been allocated with the same numBytes to the pool.
+    static void deallocate(void* block, size_t numBytes) noexcept;
+
+    /// Makes sure that the size class for numBytes has at least numBlocks free blocks.
+    static void reserve(size_t numBytes, size_t numBlocks);
+
+    /// Returns the usage of all size classes.
+    static std::vector<Usage> getUsage();
+
+    /// Returns the number of bytes in blocks that are currently in use, including blocks that are too large to be pooled.
+    static size_t getNumBytesInUse();
+
+private:
+    struct SizeClass;
+
+    static SizeClass* getSizeClass(size_t numBytes);
+
+    // The bytes of blocks larger than MaxBlockSize, which are allocated directly
+    static std::atomic<size_t> numLargeBytesInUse;
+};
+
+/// An allocator for `std::allocate_shared`, which takes its memory from the BlockPool.
+template<typename T>
+struct PoolAllocator
+{
+    typedef T value_type;
+
+    PoolAllocator() noexcept {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept
+    {}
+
+    template<typename U>
+    struct rebind
+    {
+        typedef PoolAllocator<U> other;
+    };
+
+    T* allocate(size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "The BlockPool can't allocate over-aligned types!");
+
+        return static_cast<T*>(BlockPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t n) noexcept
+    {
+        BlockPool::deallocate(block, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+
+/// An allocator that records the size of its allocation. Used to find out which block size `std::allocate_shared` needs for a type.
+template<typename T>
+struct SizeRecordingAllocator
+{
+    typedef T value_type;
+
+    explicit SizeRecordingAllocator(size_t& size) noexcept
+    : size(&size)
+    {}
+
+    template<typename U>
+    SizeRecordingAllocator(const SizeRecordingAllocator<U>& other) noexcept
+    : size(other.size)
+    {}
+
+    template<typename U>
+    struct rebind
+    {
+        typedef SizeRecordingAllocator<U> other;
+    };
+
+    T* allocate(size_t n)
+    {
+        *size = n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t) noexcept
+    {
+        ::operator delete(block);
+    }
+
+    template<typename U>
+    bool operator==(const SizeRecordingAllocator<U>& other) const noexcept
+    {
+        return (size == other.size);
+    }
+
+    template<typename U>
+    bool operator!=(const SizeRecordingAllocator<U>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    size_t* size;
+};
+}
@@ -0,0 +1,156 @@
+// Replaces the global operator new and operator delete, to detect allocations inside RealtimeChecks::Scope. @see RealtimeChecks
+#if REAX_ENABLE_REALTIME_CHECKS && REAX_REALTIME_CHECKS_REPLACE_OPERATOR_NEW
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t size)
+{
+    reax::RealtimeChecks::allocationDidHappen();
+
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    reax::RealtimeChecks::allocationDidHappen();
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& nothrow) noexcept
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* memory) noexcept
+{
+    if (memory != nullptr)
+        reax::RealtimeChecks::allocationDidHappen();
+
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    operator delete(memory);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+#endif
+
+// The overloads for over-aligned types (C++17)
+#if defined(__cpp_aligned_new)
+namespace {
+void* allocateAlignedForRealtimeChecks(std::size_t size, std::align_val_t alignment) noexcept
+{
+    reax::RealtimeChecks::allocationDidHappen();
+
+    const auto numBytes = (size == 0 ? 1 : size);
+#if JUCE_WINDOWS
+    return _aligned_malloc(numBytes, static_cast<std::size_t>(alignment));
+#else
+    // posix_memalign needs at least the alignment of a pointer
+    void* memory = nullptr;
+    if (posix_memalign(&memory, std::max(static_cast<std::size_t>(alignment), sizeof(void*)), numBytes) != 0)
+        return nullptr;
+
+    return memory;
+#endif
+}
+
+void freeAlignedForRealtimeChecks(void* memory) noexcept
+{
+    if (memory != nullptr)
+        reax::RealtimeChecks::allocationDidHappen();
+
+#if JUCE_WINDOWS
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* memory = allocateAlignedForRealtimeChecks(size, alignment))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAlignedForRealtimeChecks(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAlignedForRealtimeChecks(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedForRealtimeChecks(memory);
+}
+#endif
+
+#endif
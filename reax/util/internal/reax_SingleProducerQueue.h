@@ -0,0 +1,198 @@
+#pragma once
+
+namespace detail {
+/**
+ A wait-free, bounded queue for exactly one producer thread and one consumer thread.
+
+ All slots are preallocated when the queue is created (as copies of an initial value), so pushing and popping never allocate and just assign to or from a slot. The queue holds exactly `capacity` values. Internally, the number of slots is rounded up to a power of two greater than `capacity`, so the index computations are cheap and the producer can overwrite the oldest value without waiting for the consumer.
+
+ The atomic indices are padded to separate cache lines, so the producer and consumer don't invalidate each other's cache lines.
+ */
+template<typename T>
+class SingleProducerQueue
+{
+public:
+    SingleProducerQueue(size_t capacity, const T& initialValue)
+    : capacity(capacity),
+      mask(nextPowerOfTwo(capacity + 1) - 1),
+      slots(mask + 1, initialValue)
+    {
+        // The capacity must be > 0.
+        jassert(capacity > 0);
+    }
+
+    /// Returns the number of values that the queue can hold.
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+
+    /// Returns the number of values in the queue. May be called from any thread, but the result may be outdated immediately.
+    size_t getNumValues() const
+    {
+        const size_t h = head.load();
+        return juce::jmin(tail.load() - h, capacity);
+    }
+
+    /**
+     Adds a value, if the queue isn't full. Returns false if the value has been discarded.
+
+     Must only be called from the producer thread.
+     */
+    template<typename U>
+    bool tryPush(U&& value)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t - head.load() >= capacity)
+            return false;
+
+        // A drop may have moved the head past the slot that the consumer is still reading
+        if (reading.load() == (t & mask) + 1)
+            return false;
+
+        slots[t & mask] = std::forward<U>(value);
+        tail.store(t + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     Adds a value. If the queue is full, the oldest value is discarded to make room for it. Constant time, no retry loop.
+
+     In the rare case that the consumer is still reading the slot that is needed for the value, the new value is discarded instead and it returns false. If the consumer starts reading while the oldest value is dropped, both values may be discarded.
+
+     If `droppedOldest` isn't null, it's set to whether the oldest value has been discarded. Must only be called from the producer thread.
+     */
+    template<typename U>
+    bool pushOverwritingOldest(U&& value, bool* droppedOldest = nullptr)
+    {
+        if (droppedOldest)
+            *droppedOldest = false;
+
+        const size_t t = tail.load(std::memory_order_relaxed);
+
+        // Don't overwrite the slot the consumer is reading from. Check this first, so usually nothing is dropped if the new value is discarded.
+        if (reading.load() == (t & mask) + 1)
+            return false;
+
+        // If the queue is full, drop the oldest value. If the CAS fails, the consumer has just taken a value, so there's room anyway.
+        size_t h = head.load();
+        if (t - h >= capacity && head.compare_exchange_strong(h, h + 1) && droppedOldest)
+            *droppedOldest = true;
+
+        // Check again after moving the head: The consumer announces its slot before it checks the head, so either it sees the new head and retries, or this sees its slot.
+        if (reading.load() == (t & mask) + 1)
+            return false;
+
+        slots[t & mask] = std::forward<U>(value);
+        tail.store(t + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     Takes the oldest value from the queue and assigns it to `value`. Returns false (and leaves `value` untouched) if the queue is empty.
+
+     Uses move-assignment if `value` supports it. Must only be called from the consumer thread.
+     */
+    template<typename U>
+    bool tryPop(U& value)
+    {
+        return popWith([&value](T&& popped) {
+            value = std::move(popped);
+        });
+    }
+
+    /**
+     Discards all values except the newest one, and assigns the newest one to `value`. The discarded values aren't touched at all. Returns false (and leaves `value` untouched) if the queue is empty.
+
+     Must only be called from the consumer thread.
+     */
+    template<typename U>
+    bool tryPopLatest(U& value)
+    {
+        // Move the head to the newest value. If the CAS fails, the producer has dropped the oldest value, so try again.
+        size_t h = head.load();
+        for (;;) {
+            const size_t t = tail.load(std::memory_order_acquire);
+            if (t - h <= 1 || head.compare_exchange_weak(h, t - 1))
+                break;
+        }
+
+        return tryPop(value);
+    }
+
+    /**
+     Takes up to `maxValues` values from the queue and passes each one (as an rvalue) to `consume`, oldest first. Returns the number of values taken.
+
+     Must only be called from the consumer thread.
+     */
+    template<typename Consume>
+    size_t popBulk(size_t maxValues, Consume&& consume)
+    {
+        size_t numValues = 0;
+        while (numValues < maxValues && popWith(consume))
+            numValues++;
+
+        return numValues;
+    }
+
+private:
+    static const size_t CacheLineSize = 64;
+
+    const size_t capacity;
+    const size_t mask;
+    std::vector<T> slots;
+
+    char padding0[CacheLineSize];
+    // The index of the next value to pop. Written by the consumer, and by the producer when dropping the oldest value.
+    std::atomic<size_t> head{ 0 };
+    char padding1[CacheLineSize - sizeof(std::atomic<size_t>)];
+    // The index of the next value to push. Only written by the producer.
+    std::atomic<size_t> tail{ 0 };
+    char padding2[CacheLineSize - sizeof(std::atomic<size_t>)];
+    // The slot the consumer is currently reading from (plus one), or 0 if it's not reading.
+    std::atomic<size_t> reading{ 0 };
+    char padding3[CacheLineSize - sizeof(std::atomic<size_t>)];
+
+    template<typename Consume>
+    bool popWith(Consume&& consume)
+    {
+        size_t h = head.load();
+
+        for (;;) {
+            if (h == tail.load(std::memory_order_acquire))
+                return false;
+
+            // Announce which slot is read, then check that the producer hasn't dropped it in the meantime
+            reading.store((h & mask) + 1);
+            const size_t currentHead = head.load();
+
+            if (currentHead == h)
+                break;
+
+            h = currentHead;
+        }
+
+        consume(std::move(slots[h & mask]));
+
+        // If this fails, the producer has dropped the value while it was read. Then head is past it already.
+        head.compare_exchange_strong(h, h + 1);
+        reading.store(0);
+
+        return true;
+    }
+
+    static size_t nextPowerOfTwo(size_t n)
+    {
+        size_t powerOfTwo = 1;
+        while (powerOfTwo < n)
+            powerOfTwo <<= 1;
+
+        return powerOfTwo;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SingleProducerQueue)
+};
+}
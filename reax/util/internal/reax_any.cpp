@@ -24,6 +24,42 @@ any::any(double value)
   doubleValue(value)
 {}
 
+any::any(any&& other) noexcept
+{
+    constructValueFrom(std::move(other));
+}
+
+any::any(const any& other)
+{
+    constructValueFrom(other);
+}
+
+any& any::operator=(const any& other)
+{
+    if (this != &other) {
+        // Copy first, so this instance is unchanged if copying the inline object throws
+        any copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+any& any::operator=(any&& other) noexcept
+{
+    if (this != &other) {
+        destroyInlineObject();
+        constructValueFrom(std::move(other));
+    }
+
+    return *this;
+}
+
+any::~any()
+{
+    destroyInlineObject();
+}
+
 bool any::equals(const any& other) const
 {
     if (isArithmetic() != other.isArithmetic())
@@ -45,13 +81,80 @@ bool any::equals(const any& other) const
         case Type::RawPointer:
             return (other.type == Type::RawPointer && rawPointerValue == other.rawPointerValue);
         case Type::Object:
-            return objectValue->equals(*other.objectValue);
+            return (other.type == Type::Object && objectValue->equals(*other.objectValue));
+        case Type::InlineObject:
+            return (other.type == Type::InlineObject && inlineOps == other.inlineOps && inlineOps->equals(&inlineStorage, &other.inlineStorage));
     }
 }
 
 bool any::isArithmetic() const
 {
-    return (type != Type::Enum && type != Type::RawPointer && type != Type::Object);
+    return (type != Type::Enum && type != Type::RawPointer && type != Type::Object && type != Type::InlineObject);
+}
+
+void any::constructValueFrom(const any& other)
+{
+    type = other.type;
+    inlineOps = other.inlineOps;
+    objectValue = other.objectValue;
+
+    switch (type) {
+        case Type::Int:
+            intValue = other.intValue;
+            break;
+        case Type::Int64:
+            int64Value = other.int64Value;
+            break;
+        case Type::Bool:
+            boolValue = other.boolValue;
+            break;
+        case Type::Float:
+            floatValue = other.floatValue;
+            break;
+        case Type::Double:
+            doubleValue = other.doubleValue;
+            break;
+        case Type::RawPointer:
+            rawPointerValue = other.rawPointerValue;
+            break;
+        case Type::Enum:
+            enumValue = other.enumValue;
+            break;
+        case Type::Object:
+            break;
+        case Type::InlineObject:
+            inlineOps->copy(&other.inlineStorage, &inlineStorage);
+            break;
+    }
+}
+
+void any::constructValueFrom(any&& other) noexcept
+{
+    if (other.type == Type::InlineObject) {
+        type = Type::InlineObject;
+        inlineOps = other.inlineOps;
+        objectValue.reset();
+        inlineOps->move(&other.inlineStorage, &inlineStorage);
+    }
+    else if (other.type == Type::Object) {
+        type = Type::Object;
+        inlineOps = nullptr;
+        objectValue = std::move(other.objectValue);
+    }
+    else {
+        // Scalars can't throw when copied
+        constructValueFrom(static_cast<const any&>(other));
+    }
+}
+
+void any::destroyInlineObject() noexcept
+{
+    if (type == Type::InlineObject) {
+        inlineOps->destroy(&inlineStorage);
+        type = Type::Int;
+        intValue = 0;
+        inlineOps = nullptr;
+    }
 }
 
 std::string any::getTypeName() const
@@ -72,11 +175,14 @@ std::string any::getTypeName() const
         case Type::Enum:
             return "enum";
         case Type::Object:
-            return objectValue->typeInfo.name();
+            return objectValue->getTypeName();
+        case Type::InlineObject:
+            return inlineOps->getTypeName();
     }
 }
 
-any::Object::Object(const std::type_info& typeInfo)
-: typeInfo(typeInfo)
+any::Object::Object(const void* typeId, std::string (*getTypeName)())
+: typeId(typeId),
+  getTypeName(getTypeName)
 {}
 }
@@ -1,19 +1,79 @@
 #pragma once
 
+// Detects whether RTTI is enabled. Without RTTI, any uses its own type tags, and type names aren't available in error messages.
+#if defined(__GXX_RTTI) || defined(_CPPRTTI)
+#define REAX_HAS_RTTI 1
+#else
+#define REAX_HAS_RTTI 0
+#endif
+
 namespace detail {
+///@cond INTERNAL
+// Class types whose copy constructor doesn't copy the wrapped data (i.e. just copies bytes or bumps a reference count). Only these are stored inline by any, because inline values are copied whenever the any is copied.
+template<typename T>
+struct IsCheaplyCopyable : std::is_trivially_copyable<T>
+{
+};
+template<>
+struct IsCheaplyCopyable<juce::String> : std::true_type
+{
+};
+template<>
+struct IsCheaplyCopyable<juce::Identifier> : std::true_type
+{
+};
+template<>
+struct IsCheaplyCopyable<juce::Colour> : std::true_type
+{
+};
+template<>
+struct IsCheaplyCopyable<juce::var> : std::true_type
+{
+};
+///@endcond
+
 /**
- A dynamic wrapper that can hold a value of any copy-constructible type.
+ A dynamic wrapper that can hold a value of any copy- or move-constructible type. Move-only types (like `std::unique_ptr`) are never stored inline, and can be moved out once with `any::take()`.
  
  The type of the held value is erased. So to extract the held value (using `any::get()`), you have to provide the exact type of the held value. No base-class, of it, but the exact type it was constructed from. If in doubt, use `static_cast` before passing the value to the `any` constructor, to ensure that it's stored as a certain type.
  
  Two `any` instances are equality-comparable. If an instance `a` is compared to an instance `b` as in `a == b`, and both hold a scalar value (e.g. int, float, bool), the scalar values are converted and compared. So `var(1.f) == var(1)`. If both hold an object, it casts `b` to the type of `a`. If that succeeds, it compares them using `a`'s `operator==`. If `a` is not equality-comparable, it checks if the addresses of the wrapped values in `a` and `b` are equal. This may be false if both `a` and `b` were contructed from the same value, because the value may have been copied when constructing. Otherwise, `a` and `b` are considered to be non-equal.
+
+ Small, equality-comparable class types that are cheap to copy (up to `InlineStorageSize` bytes, nothrow-move-constructible, and either trivially copyable like `juce::Rectangle<int>`, or one of `juce::String`, `juce::Identifier`, `juce::Colour` and `juce::var`) are stored inline, without a heap allocation. They are copied when the `any` is copied. All other class types (including containers like `std::vector` or `juce::Array`, which would be deep-copied) are allocated once (from the BlockPool) and shared between copies.
  
  This class is used to create a dynamic layer between the type-safe `reax::Observable` and the type-safe `rxcpp::observable`.
 */
 ///@cond INTERNAL
 class any
 {
+    // Identifies a type without RTTI. The id is mutable, so the linker can't merge the instances for different types.
+    template<typename T>
+    struct TypeTag
+    {
+        static char id;
+    };
+
+    // Checks if T has operator==
+    template<typename T>
+    using HasEqualityOperator = typename std::enable_if<true, decltype(std::declval<T&>() == std::declval<T&>(), (void)0)>::type;
+
+    // Storage for class types that are stored inline
+    typedef typename std::aligned_storage<4 * sizeof(juce::int64), alignof(juce::int64)>::type InlineStorage;
+
+    // Checks whether a T is stored inline: It must fit into InlineStorage, must be cheap to copy, must be moved without exceptions, and have operator==. Values that are compared by address must be shared between copies, so they are not stored inline.
+    template<typename T, typename Enable = void>
+    struct IsInlineStorable : std::false_type
+    {
+    };
+    template<typename T>
+    struct IsInlineStorable<T, HasEqualityOperator<T>> : std::integral_constant<bool, (sizeof(T) <= sizeof(InlineStorage) && alignof(T) <= alignof(InlineStorage) && IsCheaplyCopyable<T>::value && std::is_nothrow_move_constructible<T>::value)>
+    {
+    };
+
 public:
+    /// The maximum size of class types that are stored inline, without a heap allocation.
+    static const size_t InlineStorageSize = sizeof(InlineStorage);
+
     ///@{
     /**
      Creates an instance from an arithmetic value.
@@ -59,19 +119,36 @@ public:
      If you use this constructor, make sure that the value you're passing in actually has the type that you try to `get<T>()` later on. One way to ensure this is to use `any(static_cast<T>(myT))`.
      */
     template<typename T>
-    explicit any(T&& value, typename std::enable_if<is_class<T>::value && !is_any<T>::value>::type* = 0)
+    explicit any(T&& value, typename std::enable_if<is_class<T>::value && !is_any<T>::value && !IsInlineStorable<typename std::decay<T>::type>::value>::type* = 0)
     : type(Type::Object),
-      objectValue(std::make_shared<EquatableTypedObject<typename std::decay<T>::type>>(std::forward<T>(value)))
-    {}
+      objectValue(std::allocate_shared<EquatableTypedObject<typename std::decay<T>::type>>(PoolAllocator<EquatableTypedObject<typename std::decay<T>::type>>(), std::forward<T>(value)))
+    {
+        // Objects are allocated from the BlockPool, whose blocks are only aligned for std::max_align_t
+        static_assert(alignof(typename std::decay<T>::type) <= alignof(std::max_align_t), "Over-aligned types can't be wrapped!");
+    }
+
+    /// \overload
+    template<typename T>
+    explicit any(T&& value, typename std::enable_if<is_class<T>::value && !is_any<T>::value && IsInlineStorable<typename std::decay<T>::type>::value>::type* = 0)
+    : type(Type::InlineObject),
+      inlineOps(&InlineObject<typename std::decay<T>::type>::ops)
+    {
+        new (&inlineStorage) typename std::decay<T>::type(std::forward<T>(value));
+    }
 
-    /// Default move constructor
-    any(any&&) = default;
+    /// Move constructor
+    any(any&& other) noexcept;
 
-    /// Default copy constructor. If the wrapped value is scalar, it is copied. Otherwise, it is shared by reference.
-    any(const any&) = default;
+    /// Copy constructor. If the wrapped value is scalar or stored inline, it is copied. Otherwise, it is shared by reference.
+    any(const any& other);
 
-    /// Default copy assignment operator. If the wrapped value is scalar, it is copied. Otherwise, it is shared by reference.
-    any& operator=(const any&) = default;
+    /// Copy assignment operator. If the wrapped value is scalar or stored inline, it is copied. Otherwise, it is shared by reference.
+    any& operator=(const any& other);
+
+    /// Move assignment operator
+    any& operator=(any&& other) noexcept;
+
+    ~any();
 
     ///@{
     /**
@@ -124,12 +201,52 @@ public:
     }
 
     template<typename T>
-    const T& get(typename std::enable_if<is_class<T>::value>::type* = 0) const
+    const T& get(typename std::enable_if<is_class<T>::value && !IsInlineStorable<T>::value>::type* = 0) const
+    {
+        if (!is<T>())
+            throw typeMismatchError<T>();
+
+        const auto object = getObjectPointer<T>();
+        if (object->taken.load(std::memory_order_relaxed))
+            throw takenError();
+
+        return object->t;
+    }
+
+    template<typename T>
+    const T& get(typename std::enable_if<is_class<T>::value && IsInlineStorable<T>::value>::type* = 0) const
     {
         if (!is<T>())
             throw typeMismatchError<T>();
 
-        return getObjectPointer<T>()->t;
+        return *reinterpret_cast<const T*>(&inlineStorage);
+    }
+    ///@}
+
+    ///@{
+    /**
+     Moves the held value out of the any, and returns it. Throws an exception if the held value is not a T.
+
+     Objects are shared between copies of an any, so an object can only be taken once: Afterwards, `get()` and `take()` throw for all copies. Scalars and inline objects are copied.
+     */
+    template<typename T>
+    T take(typename std::enable_if<is_class<T>::value && !IsInlineStorable<T>::value>::type* = 0) const
+    {
+        if (!is<T>())
+            throw typeMismatchError<T>();
+
+        // The object is shared, not owned by this instance, so it can be modified even though this instance is const
+        auto object = const_cast<TypedObject<T>*>(getObjectPointer<T>());
+        if (object->taken.exchange(true))
+            throw takenError();
+
+        return std::move(object->t);
+    }
+
+    template<typename T>
+    T take(typename std::enable_if<!is_class<T>::value || IsInlineStorable<T>::value>::type* = 0) const
+    {
+        return get<T>();
     }
     ///@}
 
@@ -155,11 +272,39 @@ public:
     }
 
     template<typename T>
-    bool is(typename std::enable_if<is_class<T>::value>::type* = 0) const
+    bool is(typename std::enable_if<is_class<T>::value && !IsInlineStorable<T>::value>::type* = 0) const
     {
         return (getObjectPointer<T>() != nullptr);
     }
 
+    template<typename T>
+    bool is(typename std::enable_if<is_class<T>::value && IsInlineStorable<T>::value>::type* = 0) const
+    {
+        return (type == Type::InlineObject && inlineOps == &InlineObject<T>::ops);
+    }
+
+    ///@{
+    /**
+     Returns the number of bytes that are allocated from the BlockPool when an instance is created from a T. Returns 0 if a T is stored inline.
+
+     Creates a copy of `prototype` to find out the size.
+     */
+    template<typename T>
+    static size_t getAllocationSize(const T& prototype, typename std::enable_if<is_class<T>::value && !IsInlineStorable<T>::value>::type* = 0)
+    {
+        size_t size = 0;
+        std::allocate_shared<EquatableTypedObject<T>>(SizeRecordingAllocator<EquatableTypedObject<T>>(size), prototype);
+
+        return size;
+    }
+
+    template<typename T>
+    static size_t getAllocationSize(const T&, typename std::enable_if<!is_class<T>::value || IsInlineStorable<T>::value>::type* = 0)
+    {
+        return 0;
+    }
+    ///@}
+
     /**
      Compares the held value to that of another instance.
      
@@ -173,30 +318,31 @@ private:
     // Type-erased wrapper
     struct Object
     {
-        Object(const std::type_info& typeInfo);
+        Object(const void* typeId, std::string (*getTypeName)());
         virtual ~Object() {}
         virtual bool equals(const Object& other) const = 0;
 
-        const std::type_info& typeInfo;
+        // The address of TypeTag<T>::id for the stored T
+        const void* const typeId;
+        std::string (*const getTypeName)();
+
+        // Whether the value has been moved out using take()
+        std::atomic<bool> taken{ false };
     };
 
-    // Object subclass that is also a T. It inherits from T to make this work: any(Derived()).get<Base>();
+    // Object subclass that holds a T.
     template<typename T>
     struct TypedObject : Object
     {
         template<typename U>
         TypedObject(U&& value)
-        : Object(typeid(U)),
+        : Object(&TypeTag<T>::id, &any::getTypeNameOf<T>),
           t(std::forward<U>(value))
         {}
 
         T t;
     };
 
-    // Checks if T has operator==
-    template<typename T>
-    using HasEqualityOperator = typename std::enable_if<true, decltype(std::declval<T&>() == std::declval<T&>(), (void)0)>::type;
-
     // Implements the equals() function using pointer comparison
     template<typename T, typename Enable = void>
     struct EquatableTypedObject : TypedObject<T>
@@ -205,8 +351,8 @@ private:
 
         bool equals(const Object& other) const override
         {
-            // Compare by address. dynamic_cast<void*> downcasts to the most derived class, so if this and other are the same instance, the expression is true.
-            return (dynamic_cast<const void*>(this) == dynamic_cast<const void*>(&other));
+            // Compare by address
+            return (static_cast<const Object*>(this) == &other);
         }
     };
 
@@ -219,8 +365,8 @@ private:
         bool equals(const Object& other) const override
         {
             // If other contains a T, compare them:
-            if (auto ptr = dynamic_cast<const EquatableTypedObject<T>*>(&other))
-                return (TypedObject<T>::t == ptr->t);
+            if (other.typeId == this->typeId)
+                return (TypedObject<T>::t == static_cast<const EquatableTypedObject<T>&>(other).t);
 
             // other does not contain a T, so the objects can't be equal
             else
@@ -228,6 +374,46 @@ private:
         }
     };
 
+    // Type-erased operations for a class type that is stored inline
+    struct InlineOps
+    {
+        void (*copy)(const void* source, void* destination);
+        void (*move)(void* source, void* destination);
+        void (*destroy)(void* object);
+        bool (*equals)(const void* lhs, const void* rhs);
+        std::string (*getTypeName)();
+
+        // Makes each table unique, even if the linker merges identical functions
+        const void* typeId;
+    };
+
+    template<typename T>
+    struct InlineObject
+    {
+        static void copy(const void* source, void* destination)
+        {
+            new (destination) T(*static_cast<const T*>(source));
+        }
+
+        static void move(void* source, void* destination)
+        {
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        }
+
+        static void destroy(void* object)
+        {
+            static_cast<T*>(object)->~T();
+        }
+
+        static bool equals(const void* lhs, const void* rhs)
+        {
+            return (*static_cast<const T*>(lhs) == *static_cast<const T*>(rhs));
+        }
+
+        // The address of ops identifies the stored type
+        static const InlineOps ops;
+    };
+
     // The type of the held value. Needed to use the correct member of the union.
     enum class Type {
         Int,
@@ -237,7 +423,8 @@ private:
         Double,
         RawPointer,
         Enum,
-        Object
+        Object,
+        InlineObject
     };
 
     Type type;
@@ -252,32 +439,75 @@ private:
         double doubleValue;
         void* rawPointerValue;
         juce::int64 enumValue;
+        InlineStorage inlineStorage;
     };
 
-    // The held value, if it's non-scalar.
+    // The operations for the value in inlineStorage, if the held value is stored inline.
+    const InlineOps* inlineOps = nullptr;
+
+    // The held value, if it's non-scalar and not stored inline.
     std::shared_ptr<Object> objectValue;
 
     template<typename T>
     std::runtime_error typeMismatchError() const
     {
-        static const std::string RequestedType = typeid(T).name();
+        static const std::string RequestedType = getTypeNameOf<T>();
         return std::runtime_error("Error getting type from any. Requested: " + RequestedType + ". Actual: " + getTypeName() + ".");
     }
 
+    std::runtime_error takenError() const
+    {
+        return std::runtime_error("Error getting value from any: The value of type " + getTypeName() + " has already been moved out with take().");
+    }
+
     template<typename T>
     const TypedObject<T>* getObjectPointer() const
     {
-        return std::dynamic_pointer_cast<const TypedObject<T>>(objectValue).get();
+        // Stored types are matched exactly, so comparing the type tag is enough
+        if (type == Type::Object && objectValue && objectValue->typeId == &TypeTag<T>::id)
+            return static_cast<const TypedObject<T>*>(objectValue.get());
+        else
+            return nullptr;
+    }
+
+    template<typename T>
+    static std::string getTypeNameOf()
+    {
+#if REAX_HAS_RTTI
+        return typeid(T).name();
+#else
+        return "<unknown type, compiled without RTTI>";
+#endif
     }
 
     bool isArithmetic() const;
 
+    // Copies or moves the held value of other. This instance must not hold an inline object.
+    void constructValueFrom(const any& other);
+    void constructValueFrom(any&& other) noexcept;
+
+    // Destroys the held value, if it's stored inline
+    void destroyInlineObject() noexcept;
+
     std::string getTypeName() const;
 
     JUCE_LEAK_DETECTOR(any)
 };
 ///@endcond
 
+template<typename T>
+const any::InlineOps any::InlineObject<T>::ops = {
+    &any::InlineObject<T>::copy,
+    &any::InlineObject<T>::move,
+    &any::InlineObject<T>::destroy,
+    &any::InlineObject<T>::equals,
+    &any::getTypeNameOf<T>,
+    &any::TypeTag<T>::id
+};
+
+template<typename T>
+char any::TypeTag<T>::id = 0;
+
 inline bool operator==(const any& lhs, const any& rhs)
 {
     return lhs.equals(rhs);
@@ -0,0 +1,155 @@
+namespace detail {
+AudioBlockPool::AudioBlockPool(int numSlots, int maxChannels, int maxSamples)
+: numSlots(numSlots),
+  slots(new AudioBlockSlot[static_cast<size_t>(numSlots)])
+{
+    for (int i = 0; i < numSlots; ++i)
+        slots[static_cast<size_t>(i)].buffer.setSize(maxChannels, maxSamples);
+}
+}
+
+AudioBlock::AudioBlock(const std::shared_ptr<detail::AudioBlockSlot>& slot)
+: slot(slot)
+{
+    if (slot)
+        slot->numHandles.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioBlock::AudioBlock(const AudioBlock& other)
+: AudioBlock(other.slot)
+{}
+
+AudioBlock::AudioBlock(AudioBlock&& other) noexcept
+: slot(std::move(other.slot))
+{}
+
+AudioBlock& AudioBlock::operator=(const AudioBlock& other)
+{
+    if (slot != other.slot) {
+        release();
+
+        if (other.slot) {
+            other.slot->numHandles.fetch_add(1, std::memory_order_relaxed);
+            slot = other.slot;
+        }
+    }
+
+    return *this;
+}
+
+AudioBlock& AudioBlock::operator=(AudioBlock&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        slot = std::move(other.slot);
+    }
+
+    return *this;
+}
+
+AudioBlock::~AudioBlock()
+{
+    release();
+}
+
+bool AudioBlock::isValid() const
+{
+    return (slot != nullptr);
+}
+
+const AudioBuffer<float>& AudioBlock::getBuffer() const
+{
+    // This handle is empty!
+    jassert(slot);
+
+    return slot->buffer;
+}
+
+void AudioBlock::release()
+{
+    if (!slot)
+        return;
+
+    // Finish reading the buffer before the realtime thread can reuse the slot
+    slot->numHandles.fetch_sub(1, std::memory_order_acq_rel);
+    slot.reset();
+}
+
+bool AudioBlock::operator==(const AudioBlock& other) const
+{
+    return (slot == other.slot);
+}
+
+AudioBlockSource::AudioBlockSource(int numSlots, int maxChannels, int maxSamples)
+: Observable<AudioBlock>(detail::AudioBlockSourceBase::subject),
+  maxChannels(maxChannels),
+  maxSamples(maxSamples),
+  pool(std::make_shared<detail::AudioBlockPool>(jmax(numSlots, 1), jmax(maxChannels, 1), jmax(maxSamples, 1))),
+  queue(static_cast<size_t>(jmax(numSlots, 1)), AudioBlock())
+{
+    // The number of slots and their size must be > 0.
+    jassert(numSlots > 0 && maxChannels > 0 && maxSamples > 0);
+}
+
+AudioBlockSource::~AudioBlockSource()
+{
+    cancelPendingUpdate();
+}
+
+bool AudioBlockSource::write(const AudioBuffer<float>& source)
+{
+    return write(source.getNumChannels(), source.getNumSamples(), [&source](AudioBuffer<float>& buffer) {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            buffer.copyFrom(channel, 0, source, channel, 0, buffer.getNumSamples());
+    });
+}
+
+int AudioBlockSource::getNumFreeSlots() const
+{
+    int numFreeSlots = 0;
+    for (int i = 0; i < pool->numSlots; ++i) {
+        if (pool->slots[static_cast<size_t>(i)].numHandles.load(std::memory_order_relaxed) == 0)
+            numFreeSlots++;
+    }
+
+    return numFreeSlots;
+}
+
+std::shared_ptr<detail::AudioBlockSlot> AudioBlockSource::acquireSlot()
+{
+    // Only this thread creates handles for free slots, so a slot can't be taken by someone else after the check
+    for (int i = 0; i < pool->numSlots; ++i) {
+        const int index = (nextSlot + i) % pool->numSlots;
+        auto& slot = pool->slots[static_cast<size_t>(index)];
+
+        if (slot.numHandles.load(std::memory_order_acquire) == 0) {
+            nextSlot = (index + 1) % pool->numSlots;
+
+            // Shares the pool's reference count, so this doesn't allocate
+            return std::shared_ptr<detail::AudioBlockSlot>(pool, &slot);
+        }
+    }
+
+    return nullptr;
+}
+
+bool AudioBlockSource::publish(AudioBlock&& block)
+{
+    // There are never more blocks in flight than slots, so the queue can't be full
+    if (!queue.tryPush(std::move(block)))
+        return false;
+
+    triggerAsyncUpdate();
+    return true;
+}
+
+void AudioBlockSource::handleAsyncUpdate()
+{
+    AudioBlock block;
+    while (queue.tryPop(block)) {
+        detail::AudioBlockSourceBase::subject.onNext(block);
+
+        // Don't keep the slot until the next block is popped
+        block.release();
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+namespace detail {
+// One preallocated buffer of an AudioBlockSource, and the number of AudioBlock handles that refer to it. A slot with 0 handles is free.
+struct AudioBlockSlot
+{
+    juce::AudioBuffer<float> buffer;
+    std::atomic<int> numHandles{ 0 };
+};
+
+// The slots of an AudioBlockSource. Shared with the handles, so they stay valid if the source is destroyed first.
+struct AudioBlockPool
+{
+    AudioBlockPool(int numSlots, int maxChannels, int maxSamples);
+
+    const int numSlots;
+    const std::unique_ptr<AudioBlockSlot[]> slots;
+};
+}
+
+/**
+ A handle to a filled slot of an AudioBlockSource. Handles can be copied (without allocating), and the slot is returned to the pool when the last handle to it is destroyed or released.
+
+ The buffer must not be modified, and must only be read after the handle has been emitted.
+ */
+class AudioBlock
+{
+public:
+    /// Creates an empty handle, which doesn't refer to a slot.
+    AudioBlock() = default;
+
+    AudioBlock(const AudioBlock& other);
+    AudioBlock(AudioBlock&& other) noexcept;
+    AudioBlock& operator=(const AudioBlock& other);
+    AudioBlock& operator=(AudioBlock&& other) noexcept;
+    ~AudioBlock();
+
+    /// Returns true iff this handle refers to a slot.
+    bool isValid() const;
+
+    /// Returns the filled buffer. Its size is the size that has been passed to AudioBlockSource::write. Must not be called on an empty handle.
+    const juce::AudioBuffer<float>& getBuffer() const;
+
+    /// Releases the slot, so it can be reused before this handle is destroyed. Afterwards, the handle is empty.
+    void release();
+
+    /// Two handles are equal if they refer to the same slot, or are both empty.
+    bool operator==(const AudioBlock& other) const;
+
+private:
+    friend class AudioBlockSource;
+
+    std::shared_ptr<detail::AudioBlockSlot> slot;
+
+    explicit AudioBlock(const std::shared_ptr<detail::AudioBlockSlot>& slot);
+};
+
+namespace detail {
+class AudioBlockSourceBase
+{
+protected:
+    PublishSubject<AudioBlock> subject;
+};
+}
+
+/**
+ An Observable that passes audio blocks from the audio thread to the JUCE message thread, without copying them there and without allocating on the audio thread.
+
+ All `numSlots` buffers are allocated when the source is created, with `maxChannels` channels and `maxSamples` samples each. The audio thread fills a free slot in place, and the source emits an AudioBlock handle to it on the message thread. The slot is reused after all handles to it have been destroyed. If all slots are in use (because the message thread lags behind, or subscribers keep the handles), new blocks are dropped.
+
+ Example:
+
+     // In the AudioProcessor:
+     AudioBlockSource& scopeBlocks = rx.audioBlocks(8, 2, 4096);
+
+     void processBlock(AudioBuffer<float>& buffer, MidiBuffer&) override
+     {
+         scopeBlocks.write(buffer);
+     }
+
+     // In the editor:
+     processor.scopeBlocks.subscribe([this](const AudioBlock& block) {
+         scope.addBlock(block.getBuffer());
+     });
+
+ Subscribe on the message thread. @see AudioProcessorExtension::audioBlocks
+ */
+class AudioBlockSource : private detail::AudioBlockSourceBase, private juce::AsyncUpdater, public Observable<AudioBlock>
+{
+public:
+    /// Creates a new instance, and allocates all slots. `numSlots`, `maxChannels` and `maxSamples` must be > 0.
+    AudioBlockSource(int numSlots, int maxChannels, int maxSamples);
+
+    ~AudioBlockSource();
+
+    /**
+     Takes a free slot, sets its size to `numChannels` and `numSamples` (without reallocating), and calls `fill` with a reference to its `juce::AudioBuffer<float>`. Afterwards, the block is emitted on the message thread. The buffer isn't cleared, so `fill` must overwrite all of it.
+
+     The size must not exceed the `maxChannels` and `maxSamples` that have been passed to the constructor. Returns false (without calling `fill`) if no slot is free.
+
+     Must only be called from one (realtime) thread at a time.
+     */
+    template<typename Function>
+    bool write(int numChannels, int numSamples, Function&& fill)
+    {
+        REAX_REALTIME_SCOPE("AudioBlockSource::write");
+
+        // The block doesn't fit into the preallocated slots!
+        jassert(numChannels <= maxChannels && numSamples <= maxSamples);
+
+        AudioBlock block(acquireSlot());
+        if (!block.isValid())
+            return false;
+
+        auto& buffer = block.slot->buffer;
+        buffer.setSize(juce::jmin(numChannels, maxChannels), juce::jmin(numSamples, maxSamples), false, false, true);
+        fill(buffer);
+
+        return publish(std::move(block));
+    }
+
+    /// Copies `source` into a free slot, and emits it on the message thread. Returns false if no slot is free. @see write(int, int, Function&&)
+    bool write(const juce::AudioBuffer<float>& source);
+
+    /// Returns the number of slots that are neither filled nor referenced by a handle. May be called from any thread, but the result may be outdated immediately.
+    int getNumFreeSlots() const;
+
+private:
+    const int maxChannels;
+    const int maxSamples;
+    const std::shared_ptr<detail::AudioBlockPool> pool;
+    detail::SingleProducerQueue<AudioBlock> queue;
+
+    // The slot to check first in acquireSlot. Only used by the realtime thread.
+    int nextSlot = 0;
+
+    std::shared_ptr<detail::AudioBlockSlot> acquireSlot();
+    bool publish(AudioBlock&& block);
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioBlockSource)
+};
+
+namespace detail {
+/// An AudioBlock can be passed to SignalReductions.
+template<>
+struct SignalTraits<AudioBlock>
+{
+    static const bool IsSignal = true;
+    static int getNumChannels(const AudioBlock& signal) { return signal.getBuffer().getNumChannels(); }
+    static int getNumSamples(const AudioBlock& signal) { return signal.getBuffer().getNumSamples(); }
+    static const float* getChannel(const AudioBlock& signal, int channel) { return signal.getBuffer().getReadPointer(channel); }
+};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ Determines what should be done if a queue is full. This happens when values are added too often in a row, without the receiving thread taking values from the queue in between. It's used by LockFreeSource, LockFreeTarget and Observable::observeOn.
+ 
+ Allocate: Allocate dynamic memory to make room for more values. With a LockFreeSource, you will most likely call onNext() on the realtime thread, so only use this if you cannot drop any values, and make sure to pick a sufficiently large queueCapacity.
+ 
+ DropNewest: Never allocate memory. If the queue is full, the new value is discarded.
+ 
+ DropOldest: Never allocate memory. If the queue is full, the oldest value is removed to make room for a new value. If you only ever need the latest state, you can use this policy with a capacity of 1.
+ */
+enum class CongestionPolicy {
+    Allocate,
+    DropNewest,
+    DropOldest
+};
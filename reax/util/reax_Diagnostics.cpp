@@ -0,0 +1,124 @@
+#if REAX_ENABLE_DIAGNOSTICS
+
+namespace {
+    struct DiagnosticsRegistry
+    {
+        CriticalSection lock;
+        Array<Diagnostics::QueueProbe*> queueProbes;
+        std::atomic<int64> numLiveSubjects{ 0 };
+        std::atomic<int64> numLiveSubscriptions{ 0 };
+
+        static DiagnosticsRegistry& getInstance()
+        {
+            static DiagnosticsRegistry registry;
+            return registry;
+        }
+
+        // Destroyed during static destruction, after everything that has been created after the first subject or subscription
+        ~DiagnosticsRegistry()
+        {
+            checkForLeaks();
+        }
+
+        bool checkForLeaks() const
+        {
+            const int64 subjects = numLiveSubjects.load();
+            const int64 subscriptions = numLiveSubscriptions.load();
+
+            if (subjects == 0 && subscriptions == 0)
+                return true;
+
+            DBG("*** ReaX: " << subjects << " subjects and " << subscriptions << " subscriptions are still alive. Make sure they are disposed when they aren't needed anymore.");
+            ignoreUnused(subjects, subscriptions);
+            return false;
+        }
+    };
+}
+
+#pragma mark - QueueProbe
+
+Diagnostics::QueueProbe::QueueProbe(const String& name, const std::function<size_t()>& getNumValues)
+: name(name),
+  getNumValues(getNumValues)
+{
+    auto& registry = DiagnosticsRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+    registry.queueProbes.add(this);
+}
+
+Diagnostics::QueueProbe::~QueueProbe()
+{
+    auto& registry = DiagnosticsRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+    registry.queueProbes.removeFirstMatchingValue(this);
+}
+
+void Diagnostics::QueueProbe::setName(const String& newName)
+{
+    const ScopedLock lock(DiagnosticsRegistry::getInstance().lock);
+    name = newName;
+}
+
+String Diagnostics::QueueProbe::getName() const
+{
+    const ScopedLock lock(DiagnosticsRegistry::getInstance().lock);
+    return name;
+}
+
+
+#pragma mark - Diagnostics
+
+Diagnostics::Snapshot Diagnostics::getSnapshot()
+{
+    auto& registry = DiagnosticsRegistry::getInstance();
+
+    Snapshot snapshot{ registry.numLiveSubjects.load(), registry.numLiveSubscriptions.load(), MemoryPool::getNumBytesInUse(), {} };
+
+    const ScopedLock lock(registry.lock);
+    for (auto probe : registry.queueProbes)
+        snapshot.queues.add({ probe->name, probe->getNumValues() });
+
+    return snapshot;
+}
+
+String Diagnostics::describe()
+{
+    const auto snapshot = getSnapshot();
+
+    String description;
+    description << "ReaX: " << snapshot.numLiveSubjects << " subjects, "
+                << snapshot.numLiveSubscriptions << " subscriptions, "
+                << File::descriptionOfSizeInBytes(static_cast<int64>(snapshot.numPayloadBytes)) << " in emitted values";
+
+    for (auto& queue : snapshot.queues)
+        description << newLine << "  " << queue.name << ": " << static_cast<int64>(queue.numValues) << " queued values";
+
+    return description;
+}
+
+bool Diagnostics::checkForLeaks()
+{
+    return DiagnosticsRegistry::getInstance().checkForLeaks();
+}
+
+std::shared_ptr<void> Diagnostics::trackSubject()
+{
+    auto& registry = DiagnosticsRegistry::getInstance();
+    registry.numLiveSubjects.fetch_add(1, std::memory_order_relaxed);
+
+    return std::shared_ptr<void>(nullptr, [&registry](void*) {
+        registry.numLiveSubjects.fetch_sub(1, std::memory_order_relaxed);
+    });
+}
+
+void Diagnostics::subscriptionAdded()
+{
+    DiagnosticsRegistry::getInstance().numLiveSubscriptions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Diagnostics::subscriptionRemoved()
+{
+    DiagnosticsRegistry::getInstance().numLiveSubscriptions.fetch_sub(1, std::memory_order_relaxed);
+}
+
+#endif
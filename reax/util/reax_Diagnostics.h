@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef REAX_ENABLE_DIAGNOSTICS
+#define REAX_ENABLE_DIAGNOSTICS 0
+#endif
+
+#if REAX_ENABLE_DIAGNOSTICS
+
+/**
+ Reports how many resources ReaX holds at runtime, to catch subscriptions (or values) that pile up during long sessions. Only available if REAX_ENABLE_DIAGNOSTICS is set to 1.
+
+ It counts:
+
+ - **Live subjects:** Subjects that haven't been destroyed yet (copies of a subject count once).
+ - **Live subscriptions:** Subscriptions that haven't been unsubscribed, disposed or completed yet.
+ - **Payload bytes:** The memory held by emitted values that aren't stored inline. @see MemoryPool::getNumBytesInUse
+ - **Queues:** The number of values in each LockFreeSource and LockFreeTarget. Use QueueProbe::setName to identify them.
+
+ Take a snapshot before and after an action that should leave nothing behind (e.g. opening and closing an editor), and compare them:
+
+     const auto before = Diagnostics::getSnapshot();
+     openAndCloseEditor();
+     jassert(Diagnostics::getSnapshot().numLiveSubscriptions == before.numLiveSubscriptions);
+
+ The subscriptions of a single `Reactive<Component>` can be checked with ComponentExtension::getNumSubscriptions, and those of a DisposeBag with DisposeBag::size.
+
+ When the program exits, it logs a warning (using DBG) if subjects or subscriptions are still alive.
+ */
+class Diagnostics
+{
+public:
+    /// Reports the number of values in a queue, e.g. of a LockFreeSource.
+    class QueueProbe
+    {
+    public:
+        /// Creates a new QueueProbe and registers it, so it's included in getSnapshot(). `getNumValues` must be callable from any thread. Must not be called from the audio thread.
+        QueueProbe(const juce::String& name, const std::function<size_t()>& getNumValues);
+
+        ~QueueProbe();
+
+        /// Changes the name that is shown in getSnapshot() and describe(). Must not be called from the audio thread.
+        void setName(const juce::String& name);
+
+        /// Returns the name.
+        juce::String getName() const;
+
+    private:
+        friend class Diagnostics;
+
+        juce::String name;
+        const std::function<size_t()> getNumValues;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(QueueProbe)
+    };
+
+    /// The fill level of one queue at some point in time.
+    struct QueueSnapshot
+    {
+        juce::String name;
+        size_t numValues;
+    };
+
+    /// The counters at some point in time.
+    struct Snapshot
+    {
+        juce::int64 numLiveSubjects;
+        juce::int64 numLiveSubscriptions;
+        size_t numPayloadBytes;
+        juce::Array<QueueSnapshot> queues;
+    };
+
+    /// Returns the current counters. May be called from any thread (except the audio thread).
+    static Snapshot getSnapshot();
+
+    /// Returns the current counters as human-readable text, e.g. to log them periodically.
+    static juce::String describe();
+
+    /// Returns true if no subjects and subscriptions are alive. Otherwise, logs a warning (using DBG) and returns false. Call this after shutting down everything that uses ReaX.
+    static bool checkForLeaks();
+
+    /// \cond internal
+    // Counts a subject until the returned token (and all copies of it) are destroyed
+    static std::shared_ptr<void> trackSubject();
+    static void subscriptionAdded();
+    static void subscriptionRemoved();
+    /// \endcond
+};
+
+#endif
@@ -0,0 +1,262 @@
+#if REAX_ENABLE_INSTRUMENTATION
+
+namespace {
+    struct ProbeRegistry
+    {
+        CriticalSection lock;
+        Array<Instrumentation::Probe*> probes;
+        int nextId = 1;
+
+        static ProbeRegistry& getInstance()
+        {
+            static ProbeRegistry registry;
+            return registry;
+        }
+
+        int add(Instrumentation::Probe* probe)
+        {
+            const ScopedLock scopedLock(lock);
+            probes.add(probe);
+            return nextId++;
+        }
+    };
+
+    // A preallocated ring buffer of trace events. It has static storage, so recording never allocates.
+    struct TraceBuffer
+    {
+        struct Event
+        {
+            std::atomic<const char*> name;
+            std::atomic<int64> ticks;
+            std::atomic<pointer_sized_int> threadId;
+            std::atomic<int> probeId;
+            std::atomic<char> phase;
+        };
+
+        static const size_t Capacity = 1 << 16;
+
+        std::array<Event, Capacity> events;
+        std::atomic<size_t> numEvents{ 0 };
+
+        void add(const char* name, Instrumentation::Phase phase, int probeId)
+        {
+            const size_t index = numEvents.fetch_add(1);
+            Event& event = events[index & (Capacity - 1)];
+
+            // Clear the name first, so a concurrent export skips the event while it's written
+            event.name.store(nullptr);
+            event.ticks.store(Time::getHighResolutionTicks(), std::memory_order_relaxed);
+            event.threadId.store(reinterpret_cast<pointer_sized_int>(Thread::getCurrentThreadId()), std::memory_order_relaxed);
+            event.probeId.store(probeId, std::memory_order_relaxed);
+            event.phase.store(static_cast<char>(phase), std::memory_order_relaxed);
+            event.name.store(name, std::memory_order_release);
+        }
+    };
+
+    TraceBuffer traceBuffer;
+
+    double ticksToMilliseconds(int64 ticks)
+    {
+        return Time::highResolutionTicksToSeconds(ticks) * 1000.;
+    }
+}
+
+#pragma mark - Probe
+
+Instrumentation::Probe::Probe(const String& name)
+: id(ProbeRegistry::getInstance().add(this)),
+  name(name)
+{
+    reset();
+}
+
+Instrumentation::Probe::~Probe()
+{
+    auto& registry = ProbeRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+    registry.probes.removeFirstMatchingValue(this);
+}
+
+void Instrumentation::Probe::setName(const String& newName)
+{
+    const ScopedLock lock(ProbeRegistry::getInstance().lock);
+    name = newName;
+}
+
+String Instrumentation::Probe::getName() const
+{
+    const ScopedLock lock(ProbeRegistry::getInstance().lock);
+    return name;
+}
+
+int Instrumentation::Probe::getId() const
+{
+    return id;
+}
+
+void Instrumentation::Probe::valueAdded()
+{
+    int64 expected = 0;
+    oldestPendingTicks.compare_exchange_strong(expected, Time::getHighResolutionTicks());
+}
+
+void Instrumentation::Probe::valueDropped()
+{
+    numDrops.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Instrumentation::Probe::valuesEmitted(size_t numValues)
+{
+    if (numValues == 0)
+        return;
+
+    numEmissions.fetch_add(numValues, std::memory_order_relaxed);
+
+    // The number of values taken in one go is the maximum number of values that have been in the queue
+    size_t highWaterMark = queueHighWaterMark.load(std::memory_order_relaxed);
+    while (numValues > highWaterMark && !queueHighWaterMark.compare_exchange_weak(highWaterMark, numValues)) {}
+
+    const int64 addedTicks = oldestPendingTicks.exchange(0);
+    if (addedTicks == 0)
+        return;
+
+    const double microseconds = ticksToMilliseconds(Time::getHighResolutionTicks() - addedTicks) * 1000.;
+    int bucket = 0;
+    while (bucket < NumLatencyBuckets - 1 && (static_cast<int64>(1) << bucket) < microseconds)
+        ++bucket;
+
+    latencyBuckets[static_cast<size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+}
+
+double Instrumentation::Probe::getLatencyPercentile(double percentile) const
+{
+    uint64 total = 0;
+    for (auto& bucket : latencyBuckets)
+        total += bucket.load(std::memory_order_relaxed);
+
+    if (total == 0)
+        return 0.;
+
+    const double threshold = total * percentile / 100.;
+    uint64 count = 0;
+    for (int i = 0; i < NumLatencyBuckets; ++i) {
+        count += latencyBuckets[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        if (count >= threshold)
+            return (static_cast<int64>(1) << i) / 1000.;
+    }
+
+    return (static_cast<int64>(1) << (NumLatencyBuckets - 1)) / 1000.;
+}
+
+void Instrumentation::Probe::reset()
+{
+    numEmissions.store(0);
+    numDrops.store(0);
+    queueHighWaterMark.store(0);
+    oldestPendingTicks.store(0);
+
+    for (auto& bucket : latencyBuckets)
+        bucket.store(0);
+}
+
+
+#pragma mark - Instrumentation
+
+Array<Instrumentation::Snapshot> Instrumentation::getSnapshots()
+{
+    auto& registry = ProbeRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+
+    Array<Snapshot> snapshots;
+    for (auto probe : registry.probes) {
+        snapshots.add({ probe->name,
+                        probe->numEmissions.load(),
+                        probe->numDrops.load(),
+                        probe->queueHighWaterMark.load(),
+                        probe->getLatencyPercentile(50.),
+                        probe->getLatencyPercentile(90.),
+                        probe->getLatencyPercentile(99.) });
+    }
+
+    return snapshots;
+}
+
+void Instrumentation::reset()
+{
+    auto& registry = ProbeRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+
+    for (auto probe : registry.probes)
+        probe->reset();
+
+    for (auto& event : traceBuffer.events)
+        event.name.store(nullptr);
+
+    traceBuffer.numEvents.store(0);
+}
+
+void Instrumentation::traceEvent(const char* name, Phase phase, int probeId)
+{
+    traceBuffer.add(name, phase, probeId);
+}
+
+String Instrumentation::exportChromeTrace()
+{
+    auto& registry = ProbeRegistry::getInstance();
+    const ScopedLock lock(registry.lock);
+
+    std::map<int, String> probeNames;
+    for (auto probe : registry.probes)
+        probeNames[probe->id] = probe->name;
+
+    const size_t numEvents = traceBuffer.numEvents.load();
+    const size_t first = (numEvents > TraceBuffer::Capacity ? numEvents - TraceBuffer::Capacity : 0);
+
+    MemoryOutputStream stream;
+    stream << "{\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    for (size_t i = first; i < numEvents; ++i) {
+        const auto& event = traceBuffer.events[i & (TraceBuffer::Capacity - 1)];
+        const char* const name = event.name.load(std::memory_order_acquire);
+
+        // Skip events that are currently being written
+        if (name == nullptr)
+            continue;
+
+        if (!isFirstEvent)
+            stream << ",";
+
+        isFirstEvent = false;
+
+        const double microseconds = ticksToMilliseconds(event.ticks.load(std::memory_order_relaxed)) * 1000.;
+        stream << "{\"name\":" << JSON::toString(String(name))
+               << ",\"ph\":\"" << String::charToString(event.phase.load(std::memory_order_relaxed)) << "\""
+               << ",\"ts\":" << String(microseconds, 3)
+               << ",\"pid\":1"
+               << ",\"tid\":" << String(static_cast<int64>(event.threadId.load(std::memory_order_relaxed)));
+
+        if (event.phase.load(std::memory_order_relaxed) == static_cast<char>(Phase::Instant))
+            stream << ",\"s\":\"t\"";
+
+        const auto probeName = probeNames.find(event.probeId.load(std::memory_order_relaxed));
+        if (probeName != probeNames.end())
+            stream << ",\"args\":{\"pipeline\":" << JSON::toString(probeName->second) << "}";
+
+        stream << "}";
+    }
+
+    stream << "]}";
+
+    return stream.toString();
+}
+
+Result Instrumentation::exportChromeTrace(const File& file)
+{
+    if (!file.replaceWithText(exportChromeTrace()))
+        return Result::fail("Couldn't write the trace to " + file.getFullPathName());
+
+    return Result::ok();
+}
+
+#endif
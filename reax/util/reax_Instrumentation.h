@@ -0,0 +1,139 @@
+#pragma once
+
+#ifndef REAX_ENABLE_INSTRUMENTATION
+#define REAX_ENABLE_INSTRUMENTATION 0
+#endif
+
+#if REAX_ENABLE_INSTRUMENTATION
+
+/**
+ Records where time is spent in ReaX pipelines. Only available if REAX_ENABLE_INSTRUMENTATION is set to 1. Otherwise, all instrumentation is compiled out.
+
+ There are two kinds of data:
+
+ - **Counters:** Each LockFreeSource has a Probe, which counts emissions, values dropped because of the CongestionPolicy, the queue high-water mark, and the latency from onNext (on the audio thread) to the emission (on the message thread). Use getSnapshots() to read them.
+ - **Trace events:** LockFreeSource::onNext, the emission on the message thread, each observeOn hop and each subscriber's onNext are timestamped into a preallocated ring buffer. Use exportChromeTrace() to write them in the Chrome trace event format, which can be opened in chrome://tracing or Perfetto.
+
+ Recording never allocates and never blocks, so it's safe on the audio thread. If the ring buffer is full, the oldest events are overwritten.
+ */
+class Instrumentation
+{
+public:
+    /// The counters of one pipeline, e.g. one LockFreeSource.
+    class Probe
+    {
+    public:
+        /// Creates a new Probe and registers it, so it's included in getSnapshots(). Must not be called from the audio thread.
+        explicit Probe(const juce::String& name);
+
+        ~Probe();
+
+        /// Changes the name that is shown in getSnapshots() and in the trace. Must not be called from the audio thread.
+        void setName(const juce::String& name);
+
+        /// Returns the name.
+        juce::String getName() const;
+
+        /// Returns the ID that is used to identify this Probe in trace events.
+        int getId() const;
+
+        /// \cond internal
+        void valueAdded();
+        void valueDropped();
+        void valuesEmitted(size_t numValues);
+        /// \endcond
+
+    private:
+        friend class Instrumentation;
+
+        // Latencies are counted in buckets of powers of two microseconds
+        static const int NumLatencyBuckets = 32;
+
+        const int id;
+        juce::String name;
+        std::atomic<juce::uint64> numEmissions{ 0 };
+        std::atomic<juce::uint64> numDrops{ 0 };
+        std::atomic<size_t> queueHighWaterMark{ 0 };
+        // The time at which the oldest value that hasn't been emitted yet has been added, or 0
+        std::atomic<juce::int64> oldestPendingTicks{ 0 };
+        std::array<std::atomic<juce::uint64>, NumLatencyBuckets> latencyBuckets;
+
+        double getLatencyPercentile(double percentile) const;
+        void reset();
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Probe)
+    };
+
+    /// The counters of a Probe at some point in time.
+    struct Snapshot
+    {
+        juce::String name;
+        juce::uint64 numEmissions;
+        juce::uint64 numDrops;
+        size_t queueHighWaterMark;
+
+        ///@{
+        /// The latency from adding a value on the audio thread to emitting it on the message thread, in milliseconds. These are upper bounds: The latencies are measured per batch, and counted in buckets of powers of two.
+        double latency50thPercentile;
+        double latency90thPercentile;
+        double latency99thPercentile;
+        ///@}
+    };
+
+    /// Returns the current counters of all registered Probes.
+    static juce::Array<Snapshot> getSnapshots();
+
+    /// Resets the counters of all Probes and clears the recorded trace events.
+    static void reset();
+
+    /// The kind of a trace event, as in the Chrome trace event format.
+    enum class Phase : char {
+        Begin = 'B',
+        End = 'E',
+        Instant = 'i'
+    };
+
+    /// Records a trace event for the current thread. `name` must be a string literal (or otherwise outlive the Instrumentation). `probeId` identifies the pipeline, or is 0.
+    static void traceEvent(const char* name, Phase phase, int probeId = 0);
+
+    /// Returns all recorded trace events in the Chrome trace event (JSON) format.
+    static juce::String exportChromeTrace();
+
+    /// \overload
+    static juce::Result exportChromeTrace(const juce::File& file);
+
+    /// Records a Begin event when it's created, and an End event when it's destroyed.
+    class ScopedTrace
+    {
+    public:
+        ScopedTrace(const char* name, int probeId = 0)
+        : name(name),
+          probeId(probeId)
+        {
+            traceEvent(name, Phase::Begin, probeId);
+        }
+
+        ~ScopedTrace()
+        {
+            traceEvent(name, Phase::End, probeId);
+        }
+
+    private:
+        const char* const name;
+        const int probeId;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTrace)
+    };
+};
+
+/// \cond internal
+#define REAX_TRACE_EVENT(name, probeId) ::reax::Instrumentation::traceEvent(name, ::reax::Instrumentation::Phase::Instant, probeId)
+#define REAX_TRACE_SCOPE(name, probeId) const ::reax::Instrumentation::ScopedTrace JUCE_JOIN_MACRO(reaxScopedTrace, __LINE__)(name, probeId)
+/// \endcond
+
+#else
+
+#define REAX_TRACE_EVENT(name, probeId)
+#define REAX_TRACE_SCOPE(name, probeId)
+
+#endif
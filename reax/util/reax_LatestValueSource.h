@@ -0,0 +1,125 @@
+#pragma once
+
+namespace detail {
+template<typename T>
+class LatestValueSourceBase
+{
+protected:
+    PublishSubject<std::reference_wrapper<const T>> subject;
+};
+}
+
+/**
+ An Observable that receives snapshots from a realtime thread (like the audio thread), and emits only the latest snapshot on the JUCE message thread.
+
+ Use this instead of a LockFreeSource (with CongestionPolicy::DropOldest and a capacity of 1), if the values are large and you only need the latest one, e.g. for spectrum analyzers. It's implemented as a triple buffer:
+
+ - The realtime thread writes into a back buffer in place, and publishes it with a single atomic exchange. It never allocates, never blocks, and never copies a whole buffer (except if you use onNext).
+ - The message thread polls for a new snapshot once per display frame (see detail::FrameTicker), and emits it **by const reference**, without copying it. So the realtime thread doesn't post any messages.
+
+ The emitted reference is **only valid during the `onNext` call.** Copy the value if you need it later.
+
+ Must be created and destroyed on the message thread.
+
+ Example:
+
+     LatestValueSource<std::array<float, 4096>> spectrum;
+
+     // Audio thread:
+     spectrum.write([&](std::array<float, 4096>& bins) {
+         computeSpectrum(bins.data());
+     });
+
+     // Message thread:
+     spectrum.subscribe([](const std::array<float, 4096>& bins) {
+         // Draw the spectrum...
+     });
+ */
+template<typename T>
+class LatestValueSource : private detail::LatestValueSourceBase<T>, private detail::FrameTicker::Client, public Observable<std::reference_wrapper<const T>>
+{
+public:
+    /// Creates a new instance. All three buffers are initialized with `initialValue`.
+    explicit LatestValueSource(const T& initialValue = T())
+    : Observable<std::reference_wrapper<const T>>(detail::LatestValueSourceBase<T>::subject),
+      buffers{ { initialValue, initialValue, initialValue } }
+    {
+        detail::FrameTicker::getInstance().requestFrame(*this);
+    }
+
+    ~LatestValueSource()
+    {
+        detail::FrameTicker::getInstance().cancelFrame(*this);
+    }
+
+    /**
+     Calls `function` with a reference to the back buffer, and publishes it afterwards. The function must overwrite the whole value: The back buffer contains an older snapshot, not the most recent one.
+
+     Must only be called from one (realtime) thread at a time.
+     */
+    template<typename Function>
+    void write(Function&& function)
+    {
+        REAX_REALTIME_SCOPE("LatestValueSource::write");
+
+        function(buffers[back]);
+        publish();
+    }
+
+    ///@{
+    /**
+     Copies (or moves) `value` into the back buffer and publishes it.
+
+     Must only be called from one (realtime) thread at a time.
+     */
+    void onNext(const T& value)
+    {
+        REAX_REALTIME_SCOPE("LatestValueSource::onNext");
+
+        buffers[back] = value;
+        publish();
+    }
+
+    void onNext(T&& value)
+    {
+        REAX_REALTIME_SCOPE("LatestValueSource::onNext");
+
+        buffers[back] = std::move(value);
+        publish();
+    }
+    ///@}
+
+private:
+    // If set in state, the middle buffer holds a snapshot that hasn't been emitted yet
+    static const int DirtyBit = 4;
+    static const int IndexMask = 3;
+
+    std::array<T, 3> buffers;
+
+    // Only used by the realtime thread
+    int back = 0;
+    // The middle buffer, which is passed between the threads, and the DirtyBit
+    std::atomic<int> state{ 1 };
+    // Only used by the message thread
+    int front = 2;
+
+    // Swaps the back buffer with the middle buffer, and marks it as dirty. The message thread picks it up on the next frame.
+    void publish()
+    {
+        back = (state.exchange(back | DirtyBit, std::memory_order_acq_rel) & IndexMask);
+    }
+
+    void frameDidTick() override
+    {
+        detail::FrameTicker::getInstance().requestFrame(*this);
+
+        // Swaps the front buffer with the middle buffer, if the middle buffer has a new snapshot
+        if ((state.load(std::memory_order_relaxed) & DirtyBit) == 0)
+            return;
+
+        front = (state.exchange(front, std::memory_order_acq_rel) & IndexMask);
+        detail::LatestValueSourceBase<T>::subject.onNext(std::cref(buffers[front]));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatestValueSource)
+};
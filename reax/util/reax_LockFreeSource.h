@@ -1,27 +1,32 @@
 #pragma once
 
 namespace detail {
+// Returns a default name for the probes of a queue, like "LockFreeSource 3", so several queues can be told apart in snapshots and traces
+inline juce::String makeProbeName(const char* type)
+{
+    static std::atomic<int> numProbeNames{ 0 };
+    return juce::String(type) + " " + juce::String(++numProbeNames);
+}
+
 template<typename T>
 class LockFreeSourceBase
 {
 protected:
     PublishSubject<T> subject;
+    PublishSubject<Span<T>> batchSubject;
 };
 }
 
 /**
- Determines what should be done if the queue is full. This happens when onNext() is called too often in a row, without the message thread taking values from the queue in between.
- 
- Allocate: Allocate dynamic memory to make room for more values. You will most likely call onNext() on the realtime thread, so only use this if you cannot drop any values, and make sure to pick a sufficiently large queueCapacity.
- 
- DropNewest: Never allocate memory. If the queue is full, onNext() does nothing, and the new value is discarded.
- 
- DropOldest: Never allocate memory. If the queue is full, the oldest value is removed to make room for a new value. If you only ever need the latest state, you can use this policy with a queueCapacity of 1.
+ Determines from which threads LockFreeSource::onNext may be called.
+
+ MultiProducer: onNext may be called from several threads at the same time. The queue capacity may get rounded up.
+
+ SingleProducer: onNext is only ever called from one thread at a time (typically the audio thread). Uses a preallocated, wait-free ring buffer which holds exactly `queueCapacity` values. CongestionPolicy::DropOldest overwrites the oldest value in constant time. This mode never allocates, so CongestionPolicy::Allocate behaves like CongestionPolicy::DropNewest.
  */
-enum class CongestionPolicy {
-    Allocate,
-    DropNewest,
-    DropOldest
+enum class ProducerMode {
+    MultiProducer,
+    SingleProducer
 };
 
 /**
@@ -32,7 +37,7 @@ enum class CongestionPolicy {
  Call asObservable() to get the Observable, subscribe to it, etc. Then call LockFreeSource::onNext on the realtime thread to emit values.
  */
 template<typename T>
-class LockFreeSource : private detail::LockFreeSourceBase<T>, private juce::AsyncUpdater, public Observable<T>
+class LockFreeSource : private detail::LockFreeSourceBase<T>, private juce::AsyncUpdater, private detail::LockFreeSourceHubClient, public Observable<T>
 {
 public:
     /**
@@ -41,12 +46,55 @@ public:
      The queueCapacity must be > 0. If you have to use CongestionPolicy::Allocate, use a large capacity, to make dynamic allocation on the audio thread as unlikely as possible. **The given `queueCapacity` may get rounded up to a different value.**
      */
     explicit LockFreeSource(size_t queueCapacity, const T& dummy = T())
+    : LockFreeSource(queueCapacity, ProducerMode::MultiProducer, dummy)
+    {}
+
+    /**
+     Creates a new instance with the given ProducerMode.
+
+     The queueCapacity must be > 0. In ProducerMode::SingleProducer, the queue holds exactly `queueCapacity` values, and all memory is allocated here.
+     */
+    LockFreeSource(size_t queueCapacity, ProducerMode producerMode, const T& dummy = T())
     : Observable<T>(detail::LockFreeSourceBase<T>::subject),
-      queue(queueCapacity),
+      queue(producerMode == ProducerMode::MultiProducer ? queueCapacity : 0),
+      singleProducerQueue(producerMode == ProducerMode::SingleProducer ? new detail::SingleProducerQueue<T>(queueCapacity, dummy) : nullptr),
       dummy(dummy)
     {
         // The queue capacity must be > 0.
         jassert(queueCapacity > 0);
+
+        batch.insertMultiple(0, dummy, static_cast<int>(juce::jmax<size_t>(queueCapacity, 1)));
+    }
+
+    /**
+     Creates a new instance that is drained by `hub`, instead of posting its own messages to the message thread. @see LockFreeSourceHub
+
+     The hub must outlive this source. Must be called on the message thread.
+     */
+    LockFreeSource(LockFreeSourceHub& hub, size_t queueCapacity, ProducerMode producerMode = ProducerMode::MultiProducer, const T& dummy = T())
+    : LockFreeSource(queueCapacity, producerMode, dummy)
+    {
+        hubIndex = hub.add(*this);
+        if (hubIndex >= 0)
+            sourceHub = &hub;
+    }
+
+    ~LockFreeSource()
+    {
+        if (sourceHub)
+            sourceHub->remove(hubIndex);
+    }
+
+    /**
+     Returns an Observable which emits all values that have been taken from the queue in one go, as a single Span.
+
+     This is useful if onNext is called very often (e.g. once per sample), and the values are processed in one pass (e.g. to compute a peak value or draw a waveform). Subscribers are notified once per batch of values, instead of once per value. If only the batches are observed (and not the LockFreeSource itself), the values aren't emitted one by one at all.
+
+     The values are not copied: **The Span is only valid during the `onNext` call.** Its memory is reused for the next batch.
+     */
+    Observable<Span<T>> asBatchObservable() const
+    {
+        return detail::LockFreeSourceBase<T>::batchSubject;
     }
 
     ///@{
@@ -54,69 +102,188 @@ public:
      Adds a value that will be emitted from the Observable.
      
      The congestionPolicy determines what to do if the queue is full. @see CongestionPolicy
+
+     Returns false if the new value has been discarded, because the queue was full.
      */
-    void onNext(const T& value, CongestionPolicy congestionPolicy)
+    bool onNext(const T& value, CongestionPolicy congestionPolicy)
     {
-        _onNext(value, congestionPolicy);
+        return _onNext(value, congestionPolicy);
     }
 
-    void onNext(T&& value, CongestionPolicy congestionPolicy)
+    bool onNext(T&& value, CongestionPolicy congestionPolicy)
     {
-        _onNext(std::move(value), congestionPolicy);
+        return _onNext(std::move(value), congestionPolicy);
     }
     ///@}
 
+    /// Returns the number of values that are waiting to be emitted. May be called from any thread, but the result may be outdated immediately.
+    size_t getNumQueuedValues() const
+    {
+        return (singleProducerQueue ? singleProducerQueue->getNumValues() : queue.size_approx());
+    }
+
+#if REAX_ENABLE_DIAGNOSTICS
+    /// Returns the QueueProbe that reports the number of queued values to Diagnostics. Only available if REAX_ENABLE_DIAGNOSTICS is enabled.
+    Diagnostics::QueueProbe& getQueueProbe()
+    {
+        return queueProbe;
+    }
+#endif
+
+#if REAX_ENABLE_INSTRUMENTATION
+    /// Returns the Probe that counts the emissions, drops and latencies of this LockFreeSource. Use Probe::setName to identify it in Instrumentation::getSnapshots and in the trace. Only available if REAX_ENABLE_INSTRUMENTATION is enabled.
+    Instrumentation::Probe& getProbe()
+    {
+        return probe;
+    }
+#endif
+
 private:
     moodycamel::ConcurrentQueue<T> queue;
+    const std::unique_ptr<detail::SingleProducerQueue<T>> singleProducerQueue;
     T dummy;
 
+    // Reused memory for the values that are taken from the queue in handleAsyncUpdate
+    juce::Array<T> batch;
+
+    // The hub that drains this source, if it has been registered with one
+    LockFreeSourceHub* sourceHub = nullptr;
+    int hubIndex = -1;
+
+#if REAX_ENABLE_INSTRUMENTATION || REAX_ENABLE_DIAGNOSTICS
+    // Shared by both probes, so they can be matched
+    const juce::String probeName = detail::makeProbeName("LockFreeSource");
+#endif
+
+#if REAX_ENABLE_INSTRUMENTATION
+    Instrumentation::Probe probe{ probeName };
+#endif
+
+#if REAX_ENABLE_DIAGNOSTICS
+    Diagnostics::QueueProbe queueProbe{ probeName, [this]() { return getNumQueuedValues(); } };
+#endif
+
     template<typename U>
-    void _onNext(U&& value, CongestionPolicy congestionPolicy)
+    bool _onNext(U&& value, CongestionPolicy congestionPolicy)
     {
+        REAX_REALTIME_SCOPE("LockFreeSource::onNext");
+        REAX_TRACE_EVENT("LockFreeSource::onNext", probe.getId());
+
         bool needsUpdate = false;
-        
-        switch (congestionPolicy) {
-            // If allocation is allowed, just enqueue the value, allowing the queue to allocate memory if needed.
-            case CongestionPolicy::Allocate:
-                queue.enqueue(std::forward<U>(value));
-                needsUpdate = true;
-                break;
-
-            // If the newest value(s) may be dropped, just try to enqueue (without allocating), and do nothing if it fails.
-            case CongestionPolicy::DropNewest:
-                needsUpdate = queue.try_enqueue(std::forward<U>(value));
-                break;
-
-            // If the oldest value may be dropped, try to enqueue (without allocating), and remove the oldest value if needed.
-            case CongestionPolicy::DropOldest: {
-                // Try to enqueue the value. If it succeeds, there's no need to copy the dummy.
-                // Cannot use std::forward here: Value must not be moved because try_enqueue may be called again (multiple times) below.
-                if (queue.try_enqueue(value)) {
+
+        // The single producer queue never allocates, so Allocate is handled like DropNewest
+        if (singleProducerQueue) {
+            if (congestionPolicy == CongestionPolicy::DropOldest) {
+                bool droppedOldest = false;
+                needsUpdate = singleProducerQueue->pushOverwritingOldest(std::forward<U>(value), &droppedOldest);
+#if REAX_ENABLE_INSTRUMENTATION
+                if (droppedOldest)
+                    probe.valueDropped();
+#endif
+                juce::ignoreUnused(droppedOldest);
+            }
+            else
+                needsUpdate = singleProducerQueue->tryPush(std::forward<U>(value));
+        }
+        else {
+            switch (congestionPolicy) {
+                // If allocation is allowed, just enqueue the value, allowing the queue to allocate memory if needed.
+                case CongestionPolicy::Allocate:
+                    queue.enqueue(std::forward<U>(value));
                     needsUpdate = true;
                     break;
-                }
+
+                // If the newest value(s) may be dropped, just try to enqueue (without allocating), and do nothing if it fails.
+                case CongestionPolicy::DropNewest:
+                    needsUpdate = queue.try_enqueue(std::forward<U>(value));
+                    break;
+
+                // If the oldest value may be dropped, try to enqueue (without allocating), and remove the oldest value if needed.
+                case CongestionPolicy::DropOldest: {
+                    // Try to enqueue the value. If it succeeds, there's no need to copy the dummy.
+                    // Cannot use std::forward here: Value must not be moved because try_enqueue may be called again (multiple times) below.
+                    if (queue.try_enqueue(value)) {
+                        needsUpdate = true;
+                        break;
+                    }
                 
-                // Queue is full. Drop values from the front until there's space again:
-                T unused(dummy);
-                while (!queue.try_enqueue(value))
-                    queue.try_dequeue(unused);
+                    // Queue is full. Drop values from the front until there's space again:
+                    T unused(dummy);
+                    while (!queue.try_enqueue(value)) {
+                        queue.try_dequeue(unused);
+#if REAX_ENABLE_INSTRUMENTATION
+                        probe.valueDropped();
+#endif
+                    }
                 
-                needsUpdate = true;
-                break;
+                    needsUpdate = true;
+                    break;
+                }
             }
         }
 
-        // Trigger an update on the message thread, if needed
+#if REAX_ENABLE_INSTRUMENTATION
         if (needsUpdate)
-            triggerAsyncUpdate();
+            probe.valueAdded();
+        else
+            probe.valueDropped();
+#endif
+
+        // Trigger an update on the message thread, if needed
+        if (needsUpdate) {
+            if (sourceHub)
+                sourceHub->markDirty(hubIndex);
+            else
+                triggerAsyncUpdate();
+        }
+
+        return needsUpdate;
     }
 
     void handleAsyncUpdate() override
     {
-        // Emits all values from the queue
-        T value(dummy);
-        while (queue.try_dequeue(value))
-            detail::LockFreeSourceBase<T>::subject.onNext(value);
+        REAX_TRACE_SCOPE("LockFreeSource::emit", probe.getId());
+
+        // Take all values from the queue. The batch only grows if the queue held more values than ever before.
+        size_t numValues = dequeueBulk(0);
+        while (numValues == static_cast<size_t>(batch.size())) {
+            batch.insertMultiple(-1, dummy, batch.size());
+            numValues += dequeueBulk(numValues);
+        }
+
+#if REAX_ENABLE_INSTRUMENTATION
+        probe.valuesEmitted(numValues);
+#endif
+
+        // Emit the values one by one (unless only the batches are observed), and as a batch
+        if (detail::LockFreeSourceBase<T>::subject.hasSubscribers()) {
+            for (size_t i = 0; i < numValues; ++i)
+                detail::LockFreeSourceBase<T>::subject.onNext(batch.getReference(static_cast<int>(i)));
+        }
+
+        if (numValues > 0)
+            detail::LockFreeSourceBase<T>::batchSubject.onNext(Span<T>(batch.begin(), numValues));
+    }
+
+    void drain() override
+    {
+        handleAsyncUpdate();
+    }
+
+    // Moves values from the queue into the batch, starting at the given index, until the queue or the batch is exhausted. Returns the number of values.
+    size_t dequeueBulk(size_t startIndex)
+    {
+        T* const first = batch.begin() + startIndex;
+        const size_t maxValues = static_cast<size_t>(batch.size()) - startIndex;
+
+        if (singleProducerQueue) {
+            T* next = first;
+            return singleProducerQueue->popBulk(maxValues, [&next](T&& value) {
+                *next++ = std::move(value);
+            });
+        }
+        else
+            return queue.try_dequeue_bulk(first, maxValues);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LockFreeSource)
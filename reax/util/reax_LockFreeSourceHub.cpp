@@ -0,0 +1,66 @@
+LockFreeSourceHub::LockFreeSourceHub(int maxNumSources)
+: clients(static_cast<size_t>(jmax(maxNumSources, 1)), nullptr),
+  dirtyBits((clients.size() + BitsPerWord - 1) / BitsPerWord)
+{
+    // The hub must have room for at least one source!
+    jassert(maxNumSources > 0);
+
+    // Hand out the lowest indices first
+    for (int index = static_cast<int>(clients.size()); index-- > 0;)
+        freeIndices.push_back(index);
+}
+
+LockFreeSourceHub::~LockFreeSourceHub()
+{
+    // There are still LockFreeSources registered with this hub. It must outlive them!
+    jassert(getNumSources() == 0);
+
+    cancelPendingUpdate();
+}
+
+int LockFreeSourceHub::getNumSources() const
+{
+    return static_cast<int>(clients.size() - freeIndices.size());
+}
+
+int LockFreeSourceHub::add(detail::LockFreeSourceHubClient& client)
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    // The hub is full. The source will post its own messages.
+    if (freeIndices.empty())
+        return -1;
+
+    const int index = freeIndices.back();
+    freeIndices.pop_back();
+    clients[static_cast<size_t>(index)] = &client;
+
+    return index;
+}
+
+void LockFreeSourceHub::remove(int index)
+{
+    // Not called from the JUCE message thread!
+    jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+    // A dirty bit that's still set for this index only causes an empty drain of the next source that gets it
+    clients[static_cast<size_t>(index)] = nullptr;
+    freeIndices.push_back(index);
+}
+
+void LockFreeSourceHub::handleAsyncUpdate()
+{
+    for (size_t word = 0; word < dirtyBits.size(); ++word) {
+        uint32 bits = dirtyBits[word].exchange(0, std::memory_order_acquire);
+
+        for (size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+            if ((bits & 1) == 0)
+                continue;
+
+            // Draining may destroy sources (e.g. if a subscriber closes a view), so each client is looked up just before it's drained
+            if (auto client = clients[word * BitsPerWord + bit])
+                client->drain();
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+namespace detail {
+// A source that a LockFreeSourceHub drains
+class LockFreeSourceHubClient
+{
+public:
+    virtual ~LockFreeSourceHubClient() {}
+
+    // Emits all queued values. Called on the message thread.
+    virtual void drain() = 0;
+};
+}
+
+/**
+ Drains many LockFreeSources in a single pass on the message thread.
+
+ Each LockFreeSource is a `juce::AsyncUpdater` of its own, so with hundreds of sources (e.g. per-voice or per-band meters), each audio block can post hundreds of messages to the message queue. Sources that are registered with a hub don't post messages: The audio thread just sets a bit in a preallocated, lock-free bitmap, and the hub posts a single message, which drains all sources that have received values since. So the message-queue traffic doesn't grow with the number of sources.
+
+     LockFreeSourceHub hub(512);
+     LockFreeSource<float> levels(hub, 16, ProducerMode::SingleProducer);
+
+ The hub can hold up to `maxNumSources` sources at a time. If it is full, new sources fall back to posting their own messages. Use a `juce::SharedResourcePointer<LockFreeSourceHub>` to share one hub between several plugin instances in the same process.
+
+ Sources must be created and destroyed on the message thread, and the hub must outlive them.
+ */
+class LockFreeSourceHub : private juce::AsyncUpdater
+{
+public:
+    /// The number of sources that a hub holds if it's created by a `juce::SharedResourcePointer`.
+    static const int DefaultMaxNumSources = 1024;
+
+    /// Creates a new instance, and allocates room for `maxNumSources` sources. `maxNumSources` must be > 0.
+    explicit LockFreeSourceHub(int maxNumSources = DefaultMaxNumSources);
+
+    ~LockFreeSourceHub();
+
+    /// Returns the number of registered sources. Must be called on the message thread.
+    int getNumSources() const;
+
+    /// \cond internal
+    // Registers a source, and returns its index, or -1 if the hub is full. Must be called on the message thread.
+    int add(detail::LockFreeSourceHubClient& client);
+
+    // Unregisters the source with the given index. Must be called on the message thread.
+    void remove(int index);
+
+    // Marks the source with the given index as dirty, so it's drained on the message thread. May be called from any thread, including the audio thread.
+    void markDirty(int index)
+    {
+        const auto i = static_cast<size_t>(index);
+        dirtyBits[i / BitsPerWord].fetch_or(juce::uint32(1) << (i % BitsPerWord), std::memory_order_release);
+
+        // Posts at most one message until it's delivered
+        triggerAsyncUpdate();
+    }
+    /// \endcond
+
+private:
+    static const size_t BitsPerWord = 32;
+
+    // Only used on the message thread. nullptr for free slots.
+    std::vector<detail::LockFreeSourceHubClient*> clients;
+    std::vector<std::atomic<juce::uint32>> dirtyBits;
+    std::vector<int> freeIndices;
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LockFreeSourceHub)
+};
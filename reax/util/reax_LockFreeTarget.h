@@ -13,7 +13,37 @@ protected:
             .disposedBy(disposeBag);
     }
 
+    LockFreeTargetBase(size_t capacity, CongestionPolicy congestionPolicy, const T& dummy)
+    : queue(congestionPolicy == CongestionPolicy::Allocate ? capacity : 0),
+      boundedQueue(congestionPolicy != CongestionPolicy::Allocate ? new SingleProducerQueue<T>(capacity, dummy) : nullptr)
+    {
+        // The capacity must be > 0.
+        jassert(capacity > 0);
+
+        subject.subscribe([this, congestionPolicy](const T& newValue) {
+                   if (!boundedQueue) {
+                       queue.enqueue(newValue);
+                       return;
+                   }
+
+                   // The bounded queue has a single producer, but values may be retrieved on several threads. The lock is only taken by producers, so the consumer never waits for it.
+                   REAX_LOCK_WILL_BE_ACQUIRED();
+                   const juce::ScopedLock lock(producerLock);
+                   if (congestionPolicy == CongestionPolicy::DropOldest)
+                       boundedQueue->pushOverwritingOldest(newValue);
+                   else
+                       boundedQueue->tryPush(newValue);
+               })
+            .disposedBy(disposeBag);
+    }
+
     moodycamel::ConcurrentQueue<T> queue;
+    // Speeds up tryDequeueBulk and tryDequeueLatest. Must only be used by one thread at a time.
+    moodycamel::ConsumerToken consumerToken{ queue };
+    // Only used for CongestionPolicy::DropNewest and CongestionPolicy::DropOldest
+    const std::unique_ptr<SingleProducerQueue<T>> boundedQueue;
+    // Serializes the threads that push into the boundedQueue
+    juce::CriticalSection producerLock;
     PublishSubject<T> subject;
     DisposeBag disposeBag;
 };
@@ -23,15 +53,30 @@ protected:
  An `Observer` that puts all retrieved values in a lock-free queue. The queue can be accessed from another thread without locking.
  
  Useful to transfer data from a non-realtime thread to a realtime thread.
+
+ By default, the queue is unbounded and may allocate when values are retrieved. If the realtime thread stops dequeueing for a while, use the constructor with a capacity and a CongestionPolicy: Then all memory is preallocated, and the queue never holds more than `capacity` values, so the time needed to empty it is bounded, too.
  */
 template<typename T>
 class LockFreeTarget : private detail::LockFreeTargetBase<T>, public Observer<T>
 {
 public:
+    /// Creates an instance with an unbounded queue.
     LockFreeTarget()
     : Observer<T>(detail::LockFreeTargetBase<T>::subject)
     {}
 
+    /**
+     Creates an instance with a queue that holds at most `capacity` values. The capacity must be > 0.
+
+     The congestionPolicy determines what to do if a value is retrieved while the queue is full. With CongestionPolicy::DropNewest and CongestionPolicy::DropOldest, all memory is allocated here (as copies of `dummy`), and retrieving values never allocates. In this case, only one thread at a time may dequeue values. Values may still be retrieved on several threads: They're serialized by a lock, which is only taken when retrieving values, so don't retrieve values on the realtime thread. CongestionPolicy::Allocate uses an unbounded queue, which initially has room for `capacity` values.
+
+     @see CongestionPolicy
+     */
+    LockFreeTarget(size_t capacity, CongestionPolicy congestionPolicy, const T& dummy = T())
+    : detail::LockFreeTargetBase<T>(capacity, congestionPolicy, dummy),
+      Observer<T>(detail::LockFreeTargetBase<T>::subject)
+    {}
+
     /**
      Dequeues the next value from the queue (if it's non-empty) and assigns it to `value`.
      
@@ -39,11 +84,16 @@ public:
      
      Does not lock. Uses move-assignment if `value` supports it, copy-assignment otherwise. Does not allocate dynamic memory, unless `value` does during assigment.
      
-     May be called from any thread, including the thread on which the `Observer` retrieves values.
+     May be called from any thread, including the thread on which the `Observer` retrieves values. For a bounded queue, only one thread at a time may dequeue.
      */
     template<typename U>
     bool tryDequeue(U& value)
     {
+        REAX_REALTIME_SCOPE("LockFreeTarget::tryDequeue");
+
+        if (detail::LockFreeTargetBase<T>::boundedQueue)
+            return detail::LockFreeTargetBase<T>::boundedQueue->tryPop(value);
+
         return detail::LockFreeTargetBase<T>::queue.try_dequeue(value);
     }
 
@@ -54,11 +104,16 @@ public:
      
      Does not lock. Uses move-assignment if `value` supports it, copy-assignment otherwise. Does not allocate dynamic memory, unless `value` does during assigment.
      
-     May be called from any thread, including the thread on which the `Observer` retrieves values.
+     May be called from any thread, including the thread on which the `Observer` retrieves values. For a bounded queue, only one thread at a time may dequeue. Because the queue never holds more than `capacity` values, the time this takes is bounded.
      */
     template<typename U>
     bool tryDequeueAll(U& value)
     {
+        REAX_REALTIME_SCOPE("LockFreeTarget::tryDequeueAll");
+
+        if (detail::LockFreeTargetBase<T>::boundedQueue)
+            return detail::LockFreeTargetBase<T>::boundedQueue->tryPopLatest(value);
+
         bool hadValues = false;
         while (tryDequeue(value))
             hadValues = true;
@@ -66,6 +121,114 @@ public:
         return hadValues;
     }
 
+    /**
+     Dequeues up to `maxValues` values in one go, and move-assigns them to `destination`, `destination + 1`, etc. Returns the number of dequeued values.
+
+     This is faster than calling tryDequeue repeatedly. Use it if you consume the values in blocks, e.g. once per `processBlock`.
+
+     Does not lock, and does not allocate dynamic memory unless T does during assignment. **Must only be called from one thread at a time** (usually the realtime thread), together with tryDequeueLatest.
+     */
+    size_t tryDequeueBulk(T* destination, size_t maxValues)
+    {
+        REAX_REALTIME_SCOPE("LockFreeTarget::tryDequeueBulk");
+
+        auto& base = static_cast<detail::LockFreeTargetBase<T>&>(*this);
+
+        if (base.boundedQueue) {
+            return base.boundedQueue->popBulk(maxValues, [&destination](T&& value) {
+                *destination++ = std::move(value);
+            });
+        }
+
+        return base.queue.try_dequeue_bulk(base.consumerToken, destination, maxValues);
+    }
+
+    /**
+     Dequeues all values from the queue (if it's non-empty) and assigns the newest value to `value`. Returns `true` iff the queue was non-empty.
+
+     Like tryDequeueAll, but faster: The older values are skipped without being assigned to `value`. For a bounded queue (@see LockFreeTarget(size_t, CongestionPolicy, const T&)), they aren't touched at all. For an unbounded queue, they are dequeued in bulk and destroyed.
+
+     Does not lock. **Must only be called from one thread at a time** (usually the realtime thread), and not while another thread calls tryDequeue, tryDequeueAll or tryDequeueBulk.
+     */
+    template<typename U>
+    bool tryDequeueLatest(U& value)
+    {
+        REAX_REALTIME_SCOPE("LockFreeTarget::tryDequeueLatest");
+
+        auto& base = static_cast<detail::LockFreeTargetBase<T>&>(*this);
+
+        if (base.boundedQueue)
+            return base.boundedQueue->tryPopLatest(value);
+
+        // Skip the older values. The count may miss values that are being enqueued right now: Those are dequeued below, and are newer anyway.
+        const size_t numValues = base.queue.size_approx();
+        if (numValues > 1)
+            base.queue.try_dequeue_bulk(base.consumerToken, DiscardingIterator(), numValues - 1);
+
+        bool hadValues = false;
+        while (base.queue.try_dequeue_bulk(base.consumerToken, LatestValueIterator<U>(value), BulkSize) > 0)
+            hadValues = true;
+
+        return hadValues;
+    }
+
+    /// Returns the number of values in the queue. May be called from any thread, but the result may be outdated immediately.
+    size_t getNumQueuedValues() const
+    {
+        auto& base = static_cast<const detail::LockFreeTargetBase<T>&>(*this);
+        return (base.boundedQueue ? base.boundedQueue->getNumValues() : base.queue.size_approx());
+    }
+
+#if REAX_ENABLE_DIAGNOSTICS
+    /// Returns the QueueProbe that reports the number of queued values to Diagnostics. Only available if REAX_ENABLE_DIAGNOSTICS is enabled.
+    Diagnostics::QueueProbe& getQueueProbe()
+    {
+        return queueProbe;
+    }
+#endif
+
 private:
+    static const size_t BulkSize = 32;
+
+#if REAX_ENABLE_DIAGNOSTICS
+    Diagnostics::QueueProbe queueProbe{ detail::makeProbeName("LockFreeTarget"), [this]() { return getNumQueuedValues(); } };
+#endif
+
+    // An output iterator that assigns every value to the same target, so only the newest value remains
+    template<typename U>
+    struct LatestValueIterator
+    {
+        explicit LatestValueIterator(U& target)
+        : target(&target)
+        {}
+
+        LatestValueIterator& operator*() { return *this; }
+        LatestValueIterator& operator++() { return *this; }
+        LatestValueIterator operator++(int) { return *this; }
+
+        template<typename V>
+        LatestValueIterator& operator=(V&& value)
+        {
+            *target = std::forward<V>(value);
+            return *this;
+        }
+
+        U* target;
+    };
+
+    // An output iterator that ignores all values. The queue destroys them after assigning.
+    struct DiscardingIterator
+    {
+        DiscardingIterator& operator*() { return *this; }
+        DiscardingIterator& operator++() { return *this; }
+        DiscardingIterator operator++(int) { return *this; }
+
+        template<typename V>
+        DiscardingIterator& operator=(V&&)
+        {
+            return *this;
+        }
+    };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LockFreeTarget)
 };
@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ The memory pool for values that are emitted through Observables.
+
+ Values that aren't stored inline (e.g. `juce::Array`s, `std::vector`s, `juce::AudioBuffer`s or structs larger than 32 bytes) need a heap allocation whenever they are emitted. Small, cheaply copyable values like numbers, `juce::String`s, `juce::Identifier`s, `juce::var`s or `juce::Rectangle<int>`s are stored inline and don't use the pool. ReaX takes that memory from size-classed pools with lock-free free lists, so long-running streams (like waveform chunks or MIDI lists) reuse memory instead of fragmenting the heap.
+
+ Call reserve at startup to pre-warm the pool for the value types you emit, and getUsage to check how the pool is used.
+ */
+class MemoryPool
+{
+public:
+    /// The usage of the blocks of one size.
+    typedef detail::BlockPool::Usage Usage;
+
+    /**
+     Makes sure that the pool has at least `numValues` unused blocks for values like `prototype`, so emitting them doesn't allocate until the blocks are used up.
+
+     The prototype is copied once, to determine the block size. If `T` is small enough to be stored inline, or too large to be pooled, it does nothing.
+     */
+    template<typename T>
+    static void reserve(const T& prototype, size_t numValues)
+    {
+        const size_t numBytes = detail::any::getAllocationSize(prototype);
+
+        // Values that are stored inline don't need the pool
+        if (numBytes > 0 && numBytes <= detail::BlockPool::MaxBlockSize)
+            detail::BlockPool::reserve(numBytes, numValues);
+    }
+
+    /// Returns the usage of each block size.
+    static std::vector<Usage> getUsage()
+    {
+        return detail::BlockPool::getUsage();
+    }
+
+    /// Returns the number of bytes that are currently held by emitted values (and copies of them). If this keeps growing, values are kept alive somewhere, e.g. in a ReplaySubject or in an unbounded queue.
+    static size_t getNumBytesInUse()
+    {
+        return detail::BlockPool::getNumBytesInUse();
+    }
+};
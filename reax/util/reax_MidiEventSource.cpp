@@ -0,0 +1,121 @@
+namespace {
+    // Each event in the ring is preceded by its sample time, its size and whether it has been truncated
+    const size_t MidiEventHeaderSize = sizeof(int64) + sizeof(int32) + 1;
+}
+
+MidiEventSource::MidiEventSource(size_t capacityInBytes, int maxEventSize, OversizedEventPolicy oversizedEventPolicy)
+: Observable<Span<MidiEventView>>(detail::MidiEventSourceBase::subject),
+  ring(capacityInBytes),
+  maxEventSize(maxEventSize),
+  oversizedEventPolicy(oversizedEventPolicy),
+  scratch(capacityInBytes)
+{
+    // The maxEventSize must be > 0, and at least one event of that size must fit into the ring!
+    jassert(maxEventSize > 0 && MidiEventHeaderSize + static_cast<size_t>(maxEventSize) <= capacityInBytes);
+
+    events.reserve(capacityInBytes / (MidiEventHeaderSize + 1));
+}
+
+MidiEventSource::~MidiEventSource()
+{
+    cancelPendingUpdate();
+}
+
+bool MidiEventSource::write(const MidiBuffer& buffer, int64 blockStartSample)
+{
+    REAX_REALTIME_SCOPE("MidiEventSource::write");
+
+    bool allWritten = true;
+
+    MidiBuffer::Iterator iterator(buffer);
+    const uint8* data;
+    int numBytes;
+    int samplePosition;
+    while (iterator.getNextEvent(data, numBytes, samplePosition))
+        allWritten = write(data, numBytes, blockStartSample + samplePosition) && allWritten;
+
+    return allWritten;
+}
+
+bool MidiEventSource::write(const uint8* data, int numBytes, int64 sampleTime)
+{
+    REAX_REALTIME_SCOPE("MidiEventSource::write");
+
+    const bool isTruncated = (numBytes > maxEventSize);
+    if (isTruncated && oversizedEventPolicy == OversizedEventPolicy::Drop) {
+        ++numDroppedEvents;
+        return false;
+    }
+
+    const int32 numBytesToWrite = jmin(numBytes, maxEventSize);
+    const size_t recordSize = MidiEventHeaderSize + static_cast<size_t>(numBytesToWrite);
+
+    const size_t t = tail.load(std::memory_order_relaxed);
+    if (ring.size() - (t - head.load(std::memory_order_acquire)) < recordSize) {
+        ++numDroppedEvents;
+        return false;
+    }
+
+    const uint8 truncatedFlag = (isTruncated ? 1 : 0);
+    writeBytes(t, &sampleTime, sizeof(sampleTime));
+    writeBytes(t + sizeof(sampleTime), &numBytesToWrite, sizeof(numBytesToWrite));
+    writeBytes(t + sizeof(sampleTime) + sizeof(numBytesToWrite), &truncatedFlag, 1);
+    writeBytes(t + MidiEventHeaderSize, data, static_cast<size_t>(numBytesToWrite));
+
+    tail.store(t + recordSize, std::memory_order_release);
+    triggerAsyncUpdate();
+
+    return true;
+}
+
+int MidiEventSource::getNumDroppedEvents() const
+{
+    return numDroppedEvents.load();
+}
+
+void MidiEventSource::writeBytes(size_t position, const void* source, size_t numBytes)
+{
+    // Split the copy where the ring wraps around
+    const size_t start = position % ring.size();
+    const size_t numBytesUntilEnd = jmin(numBytes, ring.size() - start);
+
+    std::memcpy(ring.data() + start, source, numBytesUntilEnd);
+    std::memcpy(ring.data(), static_cast<const uint8*>(source) + numBytesUntilEnd, numBytes - numBytesUntilEnd);
+}
+
+void MidiEventSource::readBytes(size_t position, void* destination, size_t numBytes) const
+{
+    const size_t start = position % ring.size();
+    const size_t numBytesUntilEnd = jmin(numBytes, ring.size() - start);
+
+    std::memcpy(destination, ring.data() + start, numBytesUntilEnd);
+    std::memcpy(static_cast<uint8*>(destination) + numBytesUntilEnd, ring.data(), numBytes - numBytesUntilEnd);
+}
+
+void MidiEventSource::handleAsyncUpdate()
+{
+    // Take all events from the ring in one go, so the producer can reuse the space while they are emitted
+    const size_t h = head.load(std::memory_order_relaxed);
+    const size_t numBytes = tail.load(std::memory_order_acquire) - h;
+    if (numBytes == 0)
+        return;
+
+    readBytes(h, scratch.data(), numBytes);
+    head.store(h + numBytes, std::memory_order_release);
+
+    events.clear();
+    for (size_t position = 0; position < numBytes;) {
+        MidiEventView event;
+        int32 eventSize;
+        std::memcpy(&event.sampleTime, scratch.data() + position, sizeof(event.sampleTime));
+        std::memcpy(&eventSize, scratch.data() + position + sizeof(event.sampleTime), sizeof(eventSize));
+        event.isTruncated = (scratch[position + sizeof(event.sampleTime) + sizeof(eventSize)] != 0);
+        event.numBytes = static_cast<int>(eventSize);
+        event.data = scratch.data() + position + MidiEventHeaderSize;
+
+        events.push_back(event);
+        position += MidiEventHeaderSize + static_cast<size_t>(eventSize);
+    }
+
+    detail::MidiEventSourceBase::subject.onNext(Span<MidiEventView>(events.data(), events.size()));
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ A MIDI event that has been passed through a MidiEventSource. It refers to raw MIDI bytes that are owned by the MidiEventSource, so it's **only valid during the `onNext` call.** Use toMidiMessage() to keep the event.
+ */
+struct MidiEventView
+{
+    /// The raw MIDI bytes.
+    const juce::uint8* data;
+
+    /// The number of bytes. If isTruncated is true, this is less than the size of the original event.
+    int numBytes;
+
+    /// The time of the event, in samples. This is the sample position within the MidiBuffer plus the `blockStartSample` that has been passed to MidiEventSource::write.
+    juce::int64 sampleTime;
+
+    /// True if the event has been truncated, because it was larger than the source's `maxEventSize`. @see OversizedEventPolicy
+    bool isTruncated;
+
+    /// Copies the event into a juce::MidiMessage, with the sampleTime as timestamp. Allocates for large (SysEx) events.
+    juce::MidiMessage toMidiMessage() const
+    {
+        return juce::MidiMessage(data, numBytes, static_cast<double>(sampleTime));
+    }
+
+    bool operator==(const MidiEventView& other) const
+    {
+        return (numBytes == other.numBytes && sampleTime == other.sampleTime && isTruncated == other.isTruncated && std::equal(data, data + numBytes, other.data));
+    }
+};
+
+/**
+ Determines what MidiEventSource does with events that are larger than its `maxEventSize` (usually SysEx messages).
+
+ Drop: The event is dropped.
+
+ Truncate: The first `maxEventSize` bytes are passed, and MidiEventView::isTruncated is set.
+ */
+enum class OversizedEventPolicy {
+    Drop,
+    Truncate
+};
+
+namespace detail {
+class MidiEventSourceBase
+{
+protected:
+    PublishSubject<Span<MidiEventView>> subject;
+};
+}
+
+/**
+ An Observable that passes MIDI events from the audio thread to the JUCE message thread, e.g. for a keyboard display or a MIDI monitor.
+
+ The audio thread copies the raw bytes of each event (with its sample time) into a preallocated byte ring. It never allocates, and never locks, even for SysEx messages. On the message thread, all events that have arrived since the last emission are emitted as a single Span of MidiEventViews:
+
+     // Audio thread:
+     void processBlock(AudioBuffer<float>& buffer, MidiBuffer& midi) override
+     {
+         midiEvents.write(midi, samplePosition);
+         samplePosition += buffer.getNumSamples();
+     }
+
+     // Message thread:
+     midiEvents.subscribe([this](const Span<MidiEventView>& events) {
+         for (auto& event : events)
+             keyboardState.processNextMidiEvent(event.toMidiMessage());
+     });
+
+ The Span and the bytes of the events are **only valid during the `onNext` call.** @see Span
+
+ If the ring is full (because the message thread lags behind), new events are dropped.
+ */
+class MidiEventSource : private detail::MidiEventSourceBase, private juce::AsyncUpdater, public Observable<Span<MidiEventView>>
+{
+public:
+    /**
+     Creates a new instance, and allocates a ring of `capacityInBytes` bytes.
+
+     Each event takes its size plus a small header in the ring. Events that are larger than `maxEventSize` bytes are handled according to `oversizedEventPolicy`. `maxEventSize` must be > 0, and small enough that some events fit into the ring.
+     */
+    MidiEventSource(size_t capacityInBytes, int maxEventSize = 256, OversizedEventPolicy oversizedEventPolicy = OversizedEventPolicy::Drop);
+
+    ~MidiEventSource();
+
+    /**
+     Copies all events from `buffer` into the ring, and emits them on the message thread. The sample time of each event is `blockStartSample` plus its sample position in the buffer.
+
+     Returns false if one or more events have been dropped. Must only be called from one (realtime) thread at a time.
+     */
+    bool write(const juce::MidiBuffer& buffer, juce::int64 blockStartSample = 0);
+
+    /// Copies a single event into the ring, and emits it on the message thread. Returns false if it has been dropped. Must only be called from one (realtime) thread at a time.
+    bool write(const juce::uint8* data, int numBytes, juce::int64 sampleTime);
+
+    /// Returns the number of events that have been dropped so far, because the ring was full or because they were too large.
+    int getNumDroppedEvents() const;
+
+private:
+    std::vector<juce::uint8> ring;
+    const int maxEventSize;
+    const OversizedEventPolicy oversizedEventPolicy;
+
+    // Monotonic byte positions. The producer writes tail, the consumer writes head.
+    std::atomic<size_t> head{ 0 };
+    std::atomic<size_t> tail{ 0 };
+    std::atomic<int> numDroppedEvents{ 0 };
+
+    // Only used by the message thread: The bytes taken from the ring in one go, and the views into them
+    std::vector<juce::uint8> scratch;
+    std::vector<MidiEventView> events;
+
+    void writeBytes(size_t position, const void* source, size_t numBytes);
+    void readBytes(size_t position, void* destination, size_t numBytes) const;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiEventSource)
+};
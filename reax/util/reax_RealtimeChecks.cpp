@@ -0,0 +1,76 @@
+#if REAX_ENABLE_REALTIME_CHECKS
+
+namespace {
+    // The name of the innermost active Scope on this thread, or nullptr
+    thread_local const char* currentScope = nullptr;
+
+    std::atomic<int> numViolations{ 0 };
+
+    RealtimeChecks::ViolationHandler& getViolationHandler()
+    {
+        static RealtimeChecks::ViolationHandler handler;
+        return handler;
+    }
+}
+
+RealtimeChecks::Scope::Scope(const char* name)
+: previousName(currentScope)
+{
+    currentScope = name;
+}
+
+RealtimeChecks::Scope::~Scope()
+{
+    currentScope = previousName;
+}
+
+void RealtimeChecks::setViolationHandler(const ViolationHandler& handler)
+{
+    getViolationHandler() = handler;
+}
+
+int RealtimeChecks::getNumViolations()
+{
+    return numViolations.load();
+}
+
+bool RealtimeChecks::isInScope()
+{
+    return currentScope != nullptr;
+}
+
+void RealtimeChecks::allocationDidHappen()
+{
+    if (currentScope != nullptr)
+        violation("Memory has been allocated or freed");
+}
+
+void RealtimeChecks::lockWillBeAcquired()
+{
+    if (currentScope != nullptr)
+        violation("A lock has been acquired");
+}
+
+void RealtimeChecks::violation(const char* what)
+{
+    ++numViolations;
+
+    // Leave the scope while handling the violation, so the handler may allocate without reporting another violation
+    const char* const scope = currentScope;
+    currentScope = nullptr;
+
+    const String description = String(what) + " in " + scope + ".";
+
+    if (auto& handler = getViolationHandler())
+        handler(description);
+    else {
+        Logger::writeToLog("ReaX realtime violation: " + description);
+
+        // Not realtime-safe! See the Logger output for details.
+        jassertfalse;
+    }
+
+    currentScope = scope;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef REAX_ENABLE_REALTIME_CHECKS
+#define REAX_ENABLE_REALTIME_CHECKS 0
+#endif
+
+#ifndef REAX_REALTIME_CHECKS_REPLACE_OPERATOR_NEW
+#define REAX_REALTIME_CHECKS_REPLACE_OPERATOR_NEW 1
+#endif
+
+#if REAX_ENABLE_REALTIME_CHECKS
+
+/**
+ Detects dynamic memory allocation and locking inside ReaX's realtime entry points. Only available if REAX_ENABLE_REALTIME_CHECKS is set to 1. Otherwise, all checks are compiled out.
+
+ The entry points that are meant to be called on the audio thread (LockFreeSource::onNext, LockFreeTarget::tryDequeue etc., LatestValueSource::write, LatestValueSource::onNext, AudioBlockSource::write, MidiEventSource::write and BehaviorSubject::getValue for trivially copyable types) create a Scope. If memory is allocated or freed while a Scope is active on the current thread, it's reported as a violation. This also covers copying a `T` that allocates, and CongestionPolicy::Allocate if the queue has to grow.
+
+ To detect allocations, ReaX replaces the global `operator new` and `operator delete`. If your project already replaces them, set REAX_REALTIME_CHECKS_REPLACE_OPERATOR_NEW to 0 and call RealtimeChecks::allocationDidHappen() from your own implementation.
+
+ ReaX reports its own locks (e.g. of a bounded LockFreeTarget, observeOn and the schedulers) if they're acquired inside a Scope. Other locks can't be detected in general. Call RealtimeChecks::lockWillBeAcquired() from your own locking code (or from a hook, e.g. on `pthread_mutex_lock`), if you want to detect those too.
+
+ By default, a violation triggers an assertion (in debug builds) and is written to the Logger. Use setViolationHandler to change that, e.g. to fail a CI job.
+ */
+class RealtimeChecks
+{
+public:
+    /// Marks the current thread as being inside a realtime entry point, for the lifetime of the Scope. Scopes may be nested.
+    class Scope
+    {
+    public:
+        /// `name` must be a string literal (or otherwise outlive the Scope). It is included in the violation description.
+        explicit Scope(const char* name);
+        ~Scope();
+
+    private:
+        const char* const previousName;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    /// A function that's called for each violation. It's called outside of the Scope, so it may allocate.
+    typedef std::function<void(const juce::String& description)> ViolationHandler;
+
+    /// Changes what happens on a violation. Pass nullptr to restore the default handler. Must not be called while a Scope is active on any thread.
+    static void setViolationHandler(const ViolationHandler& handler);
+
+    /// Returns the number of violations so far.
+    static int getNumViolations();
+
+    /// Returns true iff a Scope is active on the current thread.
+    static bool isInScope();
+
+    /// Reports a violation if a Scope is active on the current thread. Called by the replaced `operator new` and `operator delete`.
+    static void allocationDidHappen();
+
+    /// Reports a violation if a Scope is active on the current thread. Call this from your own locking code.
+    static void lockWillBeAcquired();
+
+private:
+    static void violation(const char* what);
+};
+
+/// \cond internal
+#define REAX_REALTIME_SCOPE(__name) const ::reax::RealtimeChecks::Scope JUCE_JOIN_MACRO(reaxRealtimeScope, __LINE__)(__name)
+#define REAX_LOCK_WILL_BE_ACQUIRED() ::reax::RealtimeChecks::lockWillBeAcquired()
+/// \endcond
+
+#else
+
+#define REAX_REALTIME_SCOPE(__name)
+#define REAX_LOCK_WILL_BE_ACQUIRED()
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ An immutable, reference-counted value. Copying a Shared<T> only copies a pointer, so large values (like a `juce::AudioBuffer<float>` or a `std::vector<float>`) can be emitted to several subscribers, through operators and across `observeOn` hops, without deep copies.
+
+ The value is read-only. A Shared<T> is small and cheap to copy, so it's stored inline in an Observable, and emitting one doesn't allocate either (except for creating the value once).
+
+ Two instances are equal if they refer to the same value. So `distinctUntilChanged` only skips a Shared<T> if it's the same instance, without comparing the values.
+
+ Example:
+
+     PublishSubject<Shared<AudioBuffer<float>>> waveform;
+
+     // Creating the value allocates once. Afterwards, it's never copied.
+     waveform.onNext(Shared<AudioBuffer<float>>(std::move(buffer)));
+
+     waveform.observeOn(Scheduler::backgroundThread()).subscribe([](const Shared<AudioBuffer<float>>& buffer) {
+         analyze(buffer->getReadPointer(0), buffer->getNumSamples());
+     });
+ */
+template<typename T>
+class Shared
+{
+public:
+    /// Creates an instance with a default-constructed value.
+    Shared()
+    : value(std::make_shared<const T>())
+    {}
+
+    ///@{
+    /// Creates an instance by copying or moving `value`.
+    explicit Shared(const T& value)
+    : value(std::make_shared<const T>(value))
+    {}
+
+    explicit Shared(T&& value)
+    : value(std::make_shared<const T>(std::move(value)))
+    {}
+    ///@}
+
+    /// Creates an instance that takes ownership of an existing value.
+    explicit Shared(std::unique_ptr<T> value)
+    : value(std::move(value))
+    {
+        // The value must not be null!
+        jassert(this->value != nullptr);
+    }
+
+    /// Creates the value in place, from the given constructor arguments.
+    template<typename... Args>
+    static Shared make(Args&&... args)
+    {
+        return Shared(std::make_shared<const T>(std::forward<Args>(args)...));
+    }
+
+    ///@{
+    /// Returns the value.
+    const T& get() const
+    {
+        return *value;
+    }
+
+    const T& operator*() const
+    {
+        return *value;
+    }
+
+    const T* operator->() const
+    {
+        return value.get();
+    }
+    ///@}
+
+    /// Returns the number of Shared<T> instances that refer to the value.
+    long getReferenceCount() const
+    {
+        return value.use_count();
+    }
+
+    ///@{
+    /// Returns true iff both instances refer to the same value.
+    bool operator==(const Shared& other) const
+    {
+        return (value == other.value);
+    }
+
+    bool operator!=(const Shared& other) const
+    {
+        return !(*this == other);
+    }
+    ///@}
+
+private:
+    std::shared_ptr<const T> value;
+
+    explicit Shared(std::shared_ptr<const T>&& value)
+    : value(std::move(value))
+    {}
+};
+
+namespace detail {
+///@cond INTERNAL
+// Copying a Shared<T> only bumps a reference count, so any stores it inline
+template<typename T>
+struct IsCheaplyCopyable<Shared<T>> : std::true_type
+{
+};
+///@endcond
+}
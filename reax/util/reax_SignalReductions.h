@@ -0,0 +1,221 @@
+#pragma once
+
+namespace detail {
+/**
+ Describes how the reductions in SignalReductions read a block of float samples. Specialized for juce::Array<float>, std::vector<float>, juce::AudioBuffer<float>, Span<float> and AudioBlock.
+
+ A specialization has `IsSignal = true`, getNumChannels, getNumSamples and getChannel (which returns a pointer to the samples of one channel).
+ */
+template<typename T>
+struct SignalTraits
+{
+    static const bool IsSignal = false;
+};
+
+template<>
+struct SignalTraits<juce::Array<float>>
+{
+    static const bool IsSignal = true;
+    static int getNumChannels(const juce::Array<float>&) { return 1; }
+    static int getNumSamples(const juce::Array<float>& signal) { return signal.size(); }
+    static const float* getChannel(const juce::Array<float>& signal, int) { return signal.begin(); }
+};
+
+template<>
+struct SignalTraits<std::vector<float>>
+{
+    static const bool IsSignal = true;
+    static int getNumChannels(const std::vector<float>&) { return 1; }
+    static int getNumSamples(const std::vector<float>& signal) { return static_cast<int>(signal.size()); }
+    static const float* getChannel(const std::vector<float>& signal, int) { return signal.data(); }
+};
+
+template<>
+struct SignalTraits<juce::AudioBuffer<float>>
+{
+    static const bool IsSignal = true;
+    static int getNumChannels(const juce::AudioBuffer<float>& signal) { return signal.getNumChannels(); }
+    static int getNumSamples(const juce::AudioBuffer<float>& signal) { return signal.getNumSamples(); }
+    static const float* getChannel(const juce::AudioBuffer<float>& signal, int channel) { return signal.getReadPointer(channel); }
+};
+}
+
+/**
+ Reductions of blocks of float samples, for meters and waveform displays. They use juce::FloatVectorOperations (or loops that the compiler can vectorize), and never allocate (except for the overload of minMaxEnvelope that returns an Array).
+
+ Use them on the audio thread **before** passing the values to another thread, so only a few floats per block are enqueued instead of whole buffers:
+
+     // Audio thread:
+     levels.onNext(SignalReductions::peak(buffer), CongestionPolicy::DropOldest);
+
+ Or use the corresponding operators (Observable::peak, Observable::rms, Observable::minMaxEnvelope and Observable::decayingPeakHold) on an Observable of blocks.
+
+ A block of samples (a *signal*) is a juce::Array<float>, a std::vector<float>, a juce::AudioBuffer<float>, a Span<float> or an AudioBlock. For blocks with several channels, the reductions combine all channels.
+ */
+class SignalReductions
+{
+public:
+    ///@{
+    /// Returns the largest absolute sample value, or 0 if there are no samples.
+    static float peak(const float* samples, int numSamples)
+    {
+        if (numSamples <= 0)
+            return 0.f;
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+
+    template<typename Signal>
+    static float peak(const Signal& signal)
+    {
+        float result = 0.f;
+        for (int channel = 0; channel < Traits<Signal>::getNumChannels(signal); ++channel)
+            result = juce::jmax(result, peak(Traits<Signal>::getChannel(signal, channel), Traits<Signal>::getNumSamples(signal)));
+
+        return result;
+    }
+    ///@}
+
+    ///@{
+    /// Returns the root mean square of the samples, or 0 if there are no samples.
+    static float rms(const float* samples, int numSamples)
+    {
+        if (numSamples <= 0)
+            return 0.f;
+
+        return std::sqrt(sumOfSquares(samples, numSamples) / static_cast<float>(numSamples));
+    }
+
+    template<typename Signal>
+    static float rms(const Signal& signal)
+    {
+        const int numChannels = Traits<Signal>::getNumChannels(signal);
+        const int numSamples = Traits<Signal>::getNumSamples(signal);
+        if (numChannels <= 0 || numSamples <= 0)
+            return 0.f;
+
+        float sum = 0.f;
+        for (int channel = 0; channel < numChannels; ++channel)
+            sum += sumOfSquares(Traits<Signal>::getChannel(signal, channel), numSamples);
+
+        return std::sqrt(sum / static_cast<float>(numChannels * numSamples));
+    }
+    ///@}
+
+    ///@{
+    /**
+     Splits the samples into `numBins` bins of (almost) equal size, and writes the minimum and maximum of each bin into `bins`. Use this to draw a waveform overview with one bin per pixel.
+
+     If there are fewer samples than bins, neighbouring bins share a sample. If there are no samples, all bins are empty Ranges at 0.
+     */
+    static void minMaxEnvelope(const float* samples, int numSamples, juce::Range<float>* bins, int numBins)
+    {
+        for (int bin = 0; bin < numBins; ++bin)
+            bins[bin] = getBin(samples, numSamples, bin, numBins);
+    }
+
+    template<typename Signal>
+    static void minMaxEnvelope(const Signal& signal, juce::Range<float>* bins, int numBins)
+    {
+        const int numChannels = Traits<Signal>::getNumChannels(signal);
+        const int numSamples = Traits<Signal>::getNumSamples(signal);
+        minMaxEnvelope(numChannels > 0 ? Traits<Signal>::getChannel(signal, 0) : nullptr, numChannels > 0 ? numSamples : 0, bins, numBins);
+
+        // Combine the other channels bin by bin, without a temporary buffer
+        for (int channel = 1; channel < numChannels; ++channel) {
+            for (int bin = 0; bin < numBins; ++bin)
+                bins[bin] = bins[bin].getUnionWith(getBin(Traits<Signal>::getChannel(signal, channel), numSamples, bin, numBins));
+        }
+    }
+
+    /// Like minMaxEnvelope(const Signal&, juce::Range<float>*, int), but returns a new Array with `numBins` bins. This allocates, so don't use it on the audio thread.
+    template<typename Signal>
+    static juce::Array<juce::Range<float>> minMaxEnvelope(const Signal& signal, int numBins)
+    {
+        juce::Array<juce::Range<float>> bins;
+        bins.insertMultiple(0, juce::Range<float>(), juce::jmax(numBins, 0));
+        minMaxEnvelope(signal, bins.getRawDataPointer(), bins.size());
+
+        return bins;
+    }
+    ///@}
+
+private:
+    template<typename Signal>
+    using Traits = detail::SignalTraits<typename std::decay<Signal>::type>;
+
+    // Four independent sums, so the loop can be vectorized without reordering a single sum
+    static float sumOfSquares(const float* samples, int numSamples)
+    {
+        float sums[4] = { 0.f, 0.f, 0.f, 0.f };
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            sums[0] += samples[i] * samples[i];
+            sums[1] += samples[i + 1] * samples[i + 1];
+            sums[2] += samples[i + 2] * samples[i + 2];
+            sums[3] += samples[i + 3] * samples[i + 3];
+        }
+
+        for (; i < numSamples; ++i)
+            sums[0] += samples[i] * samples[i];
+
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    // Returns the minimum and maximum of the bin with the given index. Each bin has at least one sample.
+    static juce::Range<float> getBin(const float* samples, int numSamples, int bin, int numBins)
+    {
+        if (numSamples <= 0)
+            return juce::Range<float>();
+
+        const int start = juce::jmin(static_cast<int>(static_cast<juce::int64>(bin) * numSamples / numBins), numSamples - 1);
+        const int end = juce::jmax(start + 1, static_cast<int>(static_cast<juce::int64>(bin + 1) * numSamples / numBins));
+        return juce::FloatVectorOperations::findMinAndMax(samples + start, end - start);
+    }
+};
+
+/**
+ A peak meter's "hold" behaviour: The highest peak is held for `holdCount` values, and afterwards falls by `decayFactor` per value, until a higher peak arrives.
+
+ Call process once per meter update (e.g. once per audio block, or once per emitted value). It never allocates, so it can also be used on the audio thread. @see Observable::decayingPeakHold
+ */
+class DecayingPeakHold
+{
+public:
+    /// Creates a new instance. `decayFactor` must be between 0 and 1, e.g. 0.95 makes the held peak fall by about 0.45 dB per value.
+    DecayingPeakHold(unsigned int holdCount, float decayFactor)
+    : holdCount(holdCount),
+      decayFactor(decayFactor)
+    {
+        // The decay factor must be between 0 and 1!
+        jassert(decayFactor >= 0.f && decayFactor <= 1.f);
+    }
+
+    /// Feeds a new peak value, and returns the held peak.
+    float process(float peak)
+    {
+        if (peak >= heldPeak) {
+            heldPeak = peak;
+            numHeld = 0;
+        }
+        else if (numHeld < holdCount)
+            numHeld++;
+        else
+            heldPeak = juce::jmax(peak, heldPeak * decayFactor);
+
+        return heldPeak;
+    }
+
+    /// Returns the held peak, without feeding a new value.
+    float getHeldPeak() const
+    {
+        return heldPeak;
+    }
+
+private:
+    unsigned int holdCount;
+    float decayFactor;
+    float heldPeak = 0.f;
+    unsigned int numHeld = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+/**
+ A read-only view of contiguous values, which are owned by someone else.
+
+ Used for Observables that emit many values at once (e.g. LockFreeSource::asBatchObservable). To avoid copying, the memory is reused for the next emission. So a Span is **only valid during the `onNext` call**. If you need the values later, copy them, e.g. using Span::toArray().
+
+ Two Spans are equal if they contain equal values.
+ */
+template<typename T>
+class Span
+{
+public:
+    /// Creates an empty Span.
+    Span()
+    : first(nullptr),
+      numValues(0)
+    {}
+
+    /// Creates a Span that views `size` values, starting at `data`.
+    Span(const T* data, size_t size)
+    : first(data),
+      numValues(size)
+    {}
+
+    /// Returns a pointer to the first value.
+    const T* data() const { return first; }
+
+    /// Returns the number of values.
+    size_t size() const { return numValues; }
+
+    /// Returns true iff the Span doesn't contain any values.
+    bool isEmpty() const { return (numValues == 0); }
+
+    ///@{
+    /// Iterators, to use the Span in range-based for loops.
+    const T* begin() const { return first; }
+    const T* end() const { return first + numValues; }
+    ///@}
+
+    /// Returns the value at the given index. The index must be < size().
+    const T& operator[](size_t index) const
+    {
+        jassert(index < numValues);
+        return first[index];
+    }
+
+    /// Copies the values into an Array, which can be used after the Span is invalid.
+    juce::Array<T> toArray() const
+    {
+        return juce::Array<T>(first, static_cast<int>(numValues));
+    }
+
+    bool operator==(const Span& other) const
+    {
+        return (numValues == other.numValues && std::equal(begin(), end(), other.begin()));
+    }
+
+    bool operator!=(const Span& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    const T* first;
+    size_t numValues;
+};
+
+namespace detail {
+/// A Span<float> can be passed to SignalReductions.
+template<>
+struct SignalTraits<Span<float>>
+{
+    static const bool IsSignal = true;
+    static int getNumChannels(const Span<float>&) { return 1; }
+    static int getNumSamples(const Span<float>& signal) { return static_cast<int>(signal.size()); }
+    static const float* getChannel(const Span<float>& signal, int) { return signal.data(); }
+};
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+namespace detail {
+// A value, and the time at which it has been retrieved
+template<typename T>
+struct TimestampedValue
+{
+    T value;
+    juce::int64 ticks;
+};
+
+template<typename T>
+class TimestampedLockFreeTargetBase
+{
+protected:
+    explicit TimestampedLockFreeTargetBase(const T& dummy)
+    : pending{ dummy, 0 }
+    {
+        subscribe();
+    }
+
+    TimestampedLockFreeTargetBase(size_t capacity, CongestionPolicy congestionPolicy, const T& dummy)
+    : target(capacity, congestionPolicy, TimestampedValue<T>{ dummy, 0 }),
+      pending{ dummy, 0 }
+    {
+        subscribe();
+    }
+
+    LockFreeTarget<TimestampedValue<T>> target;
+    PublishSubject<T> subject;
+    DisposeBag disposeBag;
+
+    // Only used by the consumer: A value that belongs to the next block, and the estimated start time of the next block (or 0)
+    TimestampedValue<T> pending;
+    bool hasPending = false;
+    juce::int64 blockStartTicks = 0;
+
+private:
+    void subscribe()
+    {
+        subject.subscribe([this](const T& newValue) {
+                   target.onNext(TimestampedValue<T>{ newValue, juce::Time::getHighResolutionTicks() });
+               })
+            .disposedBy(disposeBag);
+    }
+};
+}
+
+/**
+ Like a LockFreeTarget, but each value is tagged with the (high-resolution) time at which it has been retrieved. The realtime thread takes the values once per audio block, together with the sample offset at which each value should take effect.
+
+ Use this for values that change the sound (like parameter changes from the GUI), so they are applied at the right sample instead of at the start of a block:
+
+     // Message thread:
+     gainSlider.rx.value.subscribe(gainTarget).disposedBy(disposeBag);
+
+     // Audio thread:
+     void processBlock(AudioBuffer<float>& buffer, MidiBuffer&) override
+     {
+         int position = 0;
+         gainTarget.dequeueBlock(buffer.getNumSamples(), getSampleRate(), [&](float gain, int sampleOffset) {
+             applyRampedGain(buffer, position, sampleOffset, gain);
+             position = sampleOffset;
+         });
+         applyRampedGain(buffer, position, buffer.getNumSamples(), currentGain);
+     }
+
+ The values are delayed by one block: Values that have been retrieved during the previous block are spread over the current block, keeping their distances in time. The block boundaries come from an estimated sample clock: Each block lasts `numSamples / sampleRate`, and the estimate follows the wall clock only slowly. So the sample offsets don't jitter much with the time at which the host calls `processBlock`. If the estimate is off by more than a block (e.g. after the audio thread has been stopped), it's reset to the wall clock, and older values get the offset 0.
+ */
+template<typename T>
+class TimestampedLockFreeTarget : private detail::TimestampedLockFreeTargetBase<T>, public Observer<T>
+{
+public:
+    /// Creates an instance with an unbounded queue. The `dummy` is copied once, to preallocate the value that's kept for the next block.
+    explicit TimestampedLockFreeTarget(const T& dummy = T())
+    : detail::TimestampedLockFreeTargetBase<T>(dummy),
+      Observer<T>(detail::TimestampedLockFreeTargetBase<T>::subject)
+    {}
+
+    /// Creates an instance with a queue that holds at most `capacity` values. The capacity must be > 0. @see LockFreeTarget(size_t, CongestionPolicy, const T&)
+    TimestampedLockFreeTarget(size_t capacity, CongestionPolicy congestionPolicy, const T& dummy = T())
+    : detail::TimestampedLockFreeTargetBase<T>(capacity, congestionPolicy, dummy),
+      Observer<T>(detail::TimestampedLockFreeTargetBase<T>::subject)
+    {}
+
+    /**
+     Dequeues the values for an audio block with `numSamples` samples, and calls `function` with each value and its sample offset (from 0 to `numSamples - 1`), in the order in which they have been retrieved. The offsets never decrease. Returns the number of values.
+
+     Call this once per audio block, at the beginning of the block. A block without samples returns 0 and keeps all values for the next block. Does not lock, and does not allocate dynamic memory unless T does during assignment. **Must only be called from one thread at a time** (usually the realtime thread).
+     */
+    template<typename Function>
+    int dequeueBlock(int numSamples, double sampleRate, Function&& function)
+    {
+        REAX_REALTIME_SCOPE("TimestampedLockFreeTarget::dequeueBlock");
+
+        if (numSamples <= 0)
+            return 0;
+
+        // The sample rate must be known!
+        jassert(sampleRate > 0);
+
+        auto& base = static_cast<detail::TimestampedLockFreeTargetBase<T>&>(*this);
+
+        // The values from the previous block are mapped onto this block. For the first block, assume that the previous one ended now.
+        const juce::int64 now = juce::Time::getHighResolutionTicks();
+        const juce::int64 blockTicks = juce::Time::secondsToHighResolutionTicks(numSamples / sampleRate);
+        juce::int64 blockStartTicks = (base.blockStartTicks != 0 ? base.blockStartTicks : now - blockTicks);
+        juce::int64 blockEndTicks = blockStartTicks + blockTicks;
+
+        // Follow the wall clock slowly, or jump to it if the estimate is off by more than a block
+        const juce::int64 error = now - blockEndTicks;
+        if (std::abs(error) > blockTicks) {
+            blockStartTicks = now - blockTicks;
+            blockEndTicks = now;
+        }
+        else
+            blockEndTicks += error / ClockSmoothing;
+
+        base.blockStartTicks = blockEndTicks;
+        const juce::int64 endTicks = juce::jmin(now, blockEndTicks);
+
+        int numValues = 0;
+        int sampleOffset = 0;
+        while (base.hasPending || base.target.tryDequeue(base.pending)) {
+            // Retrieved after this block has ended, so it belongs to the next block
+            if (base.pending.ticks >= endTicks) {
+                base.hasPending = true;
+                break;
+            }
+
+            base.hasPending = false;
+
+            const double seconds = juce::Time::highResolutionTicksToSeconds(base.pending.ticks - blockStartTicks);
+            sampleOffset = juce::jlimit(sampleOffset, juce::jmax(numSamples - 1, 0), juce::roundToInt(seconds * sampleRate));
+
+            function(static_cast<const T&>(base.pending.value), sampleOffset);
+            ++numValues;
+        }
+
+        return numValues;
+    }
+
+    /// Forgets the estimated sample clock. Call this when the audio thread (re)starts, e.g. in `prepareToPlay`, so the first block doesn't use the time of a block before the pause. Must be called on the thread that calls dequeueBlock.
+    void reset()
+    {
+        static_cast<detail::TimestampedLockFreeTargetBase<T>&>(*this).blockStartTicks = 0;
+    }
+
+private:
+    // The estimated sample clock moves by 1/ClockSmoothing of its distance to the wall clock per block
+    static const juce::int64 ClockSmoothing = 8;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimestampedLockFreeTarget)
+};